@@ -0,0 +1,370 @@
+/*
+ * cyclic.c - Static Cyclic Executive
+ *
+ * Table construction tries candidate frame sizes from largest to
+ * smallest, first with whole jobs only, then with splitting. For a
+ * given f, frames are filled in order: a job is eligible for frame k if
+ * it is released by the frame start and its deadline is not before the
+ * frame end, and eligible jobs are packed earliest-deadline first. A
+ * job left with work after its last eligible frame rejects that f.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "cyclic.h"
+#include "timeline.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+/* ── Helpers ──────────────────────────────────────────────────────── */
+
+typedef struct {
+    TaskControlBlock *task;
+    uint32_t          index;        /* Job number within the task       */
+    uint64_t          release;
+    uint64_t          deadline;
+    uint64_t          remaining;
+} CyclicJob;
+
+static uint64_t gcd_u64(uint64_t a, uint64_t b)
+{
+    while (b) {
+        uint64_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+static bool is_periodic(const Scheduler *sched, const TaskControlBlock *t)
+{
+    return t && t != sched->idle_task && t->period > 0 &&
+           t->state != TASK_TERMINATED;
+}
+
+/* Baker & Shaw frame constraints (f >= max C only without splitting) */
+static bool frame_ok(const Scheduler *sched, uint64_t f, bool split)
+{
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *t = sched->all_tasks[i];
+        if (!is_periodic(sched, t)) continue;
+        if (!split && t->wcet > f) return false;
+        if (2 * f - gcd_u64(t->period, f) > t->relative_deadline) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int collect_jobs(const Scheduler *sched, uint64_t hyperperiod,
+                        CyclicJob *jobs)
+{
+    int n = 0;
+    for (int i = 0; i < sched->task_count; i++) {
+        TaskControlBlock *t = sched->all_tasks[i];
+        if (!is_periodic(sched, t)) continue;
+        for (uint64_t r = 0; r < hyperperiod; r += t->period) {
+            if (n >= CYCLIC_MAX_JOBS) return -1;
+            jobs[n++] = (CyclicJob){ t, (uint32_t)(r / t->period), r,
+                                     r + t->relative_deadline, t->wcet };
+        }
+    }
+    return n;
+}
+
+/* Fill frames of size f; on success the slices are left in `cx` */
+static bool try_frame(CyclicExec *cx, CyclicJob *jobs, int njobs,
+                      uint64_t f, bool split)
+{
+    int frames = (int)(cx->hyperperiod / f);
+    if (frames > CYCLIC_MAX_FRAMES) return false;
+
+    for (int j = 0; j < njobs; j++) jobs[j].remaining = jobs[j].task->wcet;
+    cx->slice_count = 0;
+
+    for (int k = 0; k < frames; k++) {
+        uint64_t start = (uint64_t)k * f, end = start + f;
+        uint64_t pos   = 0;
+        cx->frame_first[k] = cx->slice_count;
+
+        while (pos < f) {
+            CyclicJob *pick = NULL;
+            for (int j = 0; j < njobs; j++) {
+                CyclicJob *jb = &jobs[j];
+                if (jb->remaining == 0 || jb->release > start ||
+                    jb->deadline < end) {
+                    continue;
+                }
+                if (!split && jb->remaining > f - pos) continue;
+                if (!pick || jb->deadline < pick->deadline ||
+                    (jb->deadline == pick->deadline &&
+                     jb->task->original_priority <
+                     pick->task->original_priority)) {
+                    pick = jb;
+                }
+            }
+            if (!pick) break;
+            if (cx->slice_count >= CYCLIC_MAX_SLICES) return false;
+
+            uint64_t len = pick->remaining < f - pos ? pick->remaining
+                                                     : f - pos;
+            cx->slice[cx->slice_count++] = (CyclicSlice){
+                pick->task, pick->index, (uint32_t)pos, (uint32_t)len };
+            pick->remaining -= len;
+            pos             += len;
+        }
+    }
+    cx->frame_first[frames] = cx->slice_count;
+
+    for (int j = 0; j < njobs; j++) {
+        if (jobs[j].remaining > 0) return false;
+    }
+    cx->frame       = f;
+    cx->frame_count = frames;
+    cx->split       = split;
+    return true;
+}
+
+/* ── Generation ───────────────────────────────────────────────────── */
+
+bool cyclic_build(Scheduler *sched)
+{
+    if (!sched) return false;
+
+    uint64_t h = scheduler_hyperperiod(sched);
+    if (h == 0) {
+        fprintf(stderr, "cyclic_build: no periodic tasks\n");
+        return false;
+    }
+
+    if (!sched->cyclic) {
+        sched->cyclic = calloc(1, sizeof(CyclicExec));
+        if (!sched->cyclic) {
+            fprintf(stderr, "cyclic_build: out of memory\n");
+            return false;
+        }
+    }
+    CyclicExec *cx = sched->cyclic;
+    cx->active      = false;
+    cx->hyperperiod = h;
+
+    CyclicJob *jobs = malloc(CYCLIC_MAX_JOBS * sizeof(CyclicJob));
+    if (!jobs) {
+        fprintf(stderr, "cyclic_build: out of memory\n");
+        return false;
+    }
+    int njobs = collect_jobs(sched, h, jobs);
+    if (njobs < 0) {
+        fprintf(stderr, "cyclic_build: more than %d jobs per hyperperiod\n",
+                CYCLIC_MAX_JOBS);
+        free(jobs);
+        return false;
+    }
+
+    bool ok = false;
+    for (int split = 0; split <= 1 && !ok; split++) {
+        for (uint64_t f = h; f >= 1 && !ok; f--) {
+            if (h % f != 0 || !frame_ok(sched, f, split)) continue;
+            ok = try_frame(cx, jobs, njobs, f, split);
+        }
+    }
+    free(jobs);
+
+    if (!ok) {
+        fprintf(stderr, "cyclic_build: no feasible table for H = %" PRIu64
+                "\n", h);
+        cx->slice_count = 0;
+        cx->frame_count = 0;
+    }
+    return ok;
+}
+
+bool cyclic_load(Scheduler *sched, uint64_t hyperperiod,
+                 const CyclicSlice *slices, int count)
+{
+    if (!sched || hyperperiod == 0 || count < 0 ||
+        count > CYCLIC_MAX_SLICES) {
+        fprintf(stderr, "cyclic_load: invalid table\n");
+        return false;
+    }
+    for (int s = 0; s < count; s++) {
+        uint64_t end = (uint64_t)slices[s].start + slices[s].length;
+        if (end > hyperperiod ||
+            (s > 0 && slices[s].start <
+                      slices[s - 1].start + slices[s - 1].length)) {
+            fprintf(stderr, "cyclic_load: slice %d overlaps or overruns\n",
+                    s);
+            return false;
+        }
+    }
+
+    if (!sched->cyclic) {
+        sched->cyclic = calloc(1, sizeof(CyclicExec));
+        if (!sched->cyclic) {
+            fprintf(stderr, "cyclic_load: out of memory\n");
+            return false;
+        }
+    }
+    CyclicExec *cx = sched->cyclic;
+    cx->active         = false;
+    cx->hyperperiod    = hyperperiod;
+    cx->frame          = hyperperiod;
+    cx->frame_count    = 1;
+    cx->split          = false;
+    cx->slice_count    = count;
+    cx->frame_first[0] = 0;
+    cx->frame_first[1] = count;
+    memcpy(cx->slice, slices, (size_t)count * sizeof(CyclicSlice));
+    return true;
+}
+
+bool cyclic_start(Scheduler *sched)
+{
+    CyclicExec *cx = sched ? sched->cyclic : NULL;
+    if (!cx || cx->frame_count == 0) {
+        fprintf(stderr, "cyclic_start: no table built\n");
+        return false;
+    }
+    cx->active    = true;
+    cx->cur_frame = 0;
+    cx->cur_slice = cx->frame_first[0];
+    cx->offset    = 0;
+
+    if (sched->timeline) {
+        char buf[ANNOTATION_MAX];
+        snprintf(buf, sizeof(buf), "CYCLIC: table dispatch, H=%" PRIu64
+                 " f=%" PRIu64, cx->hyperperiod, cx->frame);
+        timeline_record(sched->timeline, sched->system_ticks, NULL,
+                        VIS_NONE, buf);
+    }
+    return true;
+}
+
+void cyclic_disable(Scheduler *sched)
+{
+    if (!sched) return;
+    free(sched->cyclic);
+    sched->cyclic = NULL;
+}
+
+/* ── Dispatch ─────────────────────────────────────────────────────── */
+
+static TaskControlBlock *slot_task(const CyclicExec *cx)
+{
+    if (cx->cur_slice >= cx->frame_first[cx->cur_frame + 1]) return NULL;
+    const CyclicSlice *s = &cx->slice[cx->cur_slice];
+    return (cx->offset >= s->start) ? s->task : NULL;
+}
+
+void cyclic_tick(Scheduler *sched)
+{
+    CyclicExec *cx = sched ? sched->cyclic : NULL;
+    if (!cx || !cx->active) return;
+
+    /* Account the slot of the tick just executed */
+    TaskControlBlock *owner = slot_task(cx);
+    if (owner) {
+        cx->slot_ticks++;
+        if (sched->current_task != owner) cx->unused_slots++;
+    }
+
+    if (++cx->offset == cx->frame) {
+        cx->offset    = 0;
+        cx->cur_frame = (cx->cur_frame + 1) % cx->frame_count;
+        cx->cur_slice = cx->frame_first[cx->cur_frame];
+    } else if (cx->cur_slice < cx->frame_first[cx->cur_frame + 1]) {
+        const CyclicSlice *s = &cx->slice[cx->cur_slice];
+        if (cx->offset >= (uint64_t)s->start + s->length) cx->cur_slice++;
+    }
+}
+
+void cyclic_dispatch(Scheduler *sched)
+{
+    CyclicExec *cx = sched ? sched->cyclic : NULL;
+    if (!cx || !cx->active) return;
+
+    TaskControlBlock *want = slot_task(cx);
+    TaskControlBlock *next = sched->idle_task;
+    if (want && (want->state == TASK_READY || want->state == TASK_RUNNING) &&
+        want->remaining_work > 0) {
+        next = want;
+    }
+
+    TaskControlBlock *curr = sched->current_task;
+    if (next == curr && curr->state == TASK_RUNNING) return;
+    scheduler_context_switch(sched, curr, next);
+    cx->dispatches++;
+}
+
+/* ── Output ───────────────────────────────────────────────────────── */
+
+void cyclic_print_table(const Scheduler *sched, int max_frames)
+{
+    const CyclicExec *cx = sched ? sched->cyclic : NULL;
+    if (!cx || cx->frame_count == 0) return;
+
+    printf("\n  Hyperperiod %" PRIu64 ", frame %" PRIu64 ", %d frames, "
+           "%d slices%s\n", cx->hyperperiod, cx->frame, cx->frame_count,
+           cx->slice_count, cx->split ? " (jobs split across frames)" : "");
+
+    int shown = cx->frame_count < max_frames ? cx->frame_count : max_frames;
+    for (int k = 0; k < shown; k++) {
+        printf("  Frame %3d @%4" PRIu64 ":", k, (uint64_t)k * cx->frame);
+        uint64_t used = 0;
+        for (int s = cx->frame_first[k]; s < cx->frame_first[k + 1]; s++) {
+            const CyclicSlice *sl = &cx->slice[s];
+            printf(" %s#%u[%u+%u]", sl->task->name, sl->job, sl->start,
+                   sl->length);
+            used += sl->length;
+        }
+        if (used < cx->frame) {
+            printf(" idle[%" PRIu64 "]", cx->frame - used);
+        }
+        printf("\n");
+    }
+    if (shown < cx->frame_count) {
+        printf("  ... %d more frames\n", cx->frame_count - shown);
+    }
+}
+
+void cyclic_emit_c(const Scheduler *sched, FILE *out, const char *prefix)
+{
+    const CyclicExec *cx = sched ? sched->cyclic : NULL;
+    if (!cx || cx->frame_count == 0 || !out) return;
+
+    fprintf(out, "/* Cyclic-executive table: H = %" PRIu64 " ticks, "
+            "frame = %" PRIu64 " ticks, %d frames, %d slices.\n",
+            cx->hyperperiod, cx->frame, cx->frame_count, cx->slice_count);
+    fprintf(out, " * Task ids:");
+    const char *sep = " ";
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *t = sched->all_tasks[i];
+        if (!is_periodic(sched, t)) continue;
+        fprintf(out, "%s%d = %s", sep, t->id, t->name);
+        sep = ", ";
+    }
+    fprintf(out, " */\n");
+
+    fprintf(out, "static const uint32_t %s_frame_ticks = %" PRIu64 ";\n",
+            prefix, cx->frame);
+    fprintf(out, "static const uint16_t %s_frames[%d] = {", prefix,
+            cx->frame_count + 1);
+    for (int k = 0; k <= cx->frame_count; k++) {
+        fprintf(out, "%s%s%d", k ? "," : "", (k % 12) ? " " : "\n    ",
+                cx->frame_first[k]);
+    }
+    fprintf(out, "\n};\n");
+
+    fprintf(out, "static const uint16_t %s_slices[%d][3] = {  "
+            "/* task id, start, length */", prefix, cx->slice_count);
+    for (int s = 0; s < cx->slice_count; s++) {
+        const CyclicSlice *sl = &cx->slice[s];
+        fprintf(out, "%s%s{%d, %u, %u}", s ? "," : "",
+                (s % 6) ? " " : "\n    ", sl->task->id, sl->start,
+                sl->length);
+    }
+    fprintf(out, "\n};\n");
+}
@@ -0,0 +1,109 @@
+/*
+ * cyclic.h - Static Cyclic Executive
+ *
+ * Builds an offline schedule table for a core's periodic task set: the
+ * hyperperiod H is divided into minor frames of size f, and each frame
+ * holds a list of job slices. Once the table is installed the core
+ * dispatches from it with no online priority decisions; a cursor that
+ * advances by one tick per tick_handler makes dispatch O(1).
+ *
+ * The frame size follows Baker & Shaw: f divides H, f >= max C_i
+ * (dropped when jobs must be split), and 2f - gcd(T_i, f) <= D_i so
+ * every job has a whole frame between its release and deadline.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef CYCLIC_H
+#define CYCLIC_H
+
+#include "scheduler.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define CYCLIC_MAX_FRAMES   256
+#define CYCLIC_MAX_SLICES   1024
+#define CYCLIC_MAX_JOBS     1024
+
+/* One contiguous run of a job inside a frame */
+typedef struct {
+    TaskControlBlock *task;
+    uint32_t          job;          /* Job index within the hyperperiod */
+    uint32_t          start;        /* Offset from the frame start      */
+    uint32_t          length;
+} CyclicSlice;
+
+/* ── Schedule table and dispatch cursor ───────────────────────────── */
+struct CyclicExec {
+    uint64_t     hyperperiod;
+    uint64_t     frame;             /* Minor frame size f               */
+    int          frame_count;       /* H / f                            */
+    bool         split;             /* Some jobs span several frames    */
+
+    CyclicSlice  slice[CYCLIC_MAX_SLICES];
+    int          slice_count;
+    int          frame_first[CYCLIC_MAX_FRAMES + 1];   /* CSR offsets   */
+
+    /* Cursor: position of the tick about to execute */
+    bool         active;
+    int          cur_frame;
+    int          cur_slice;
+    uint64_t     offset;            /* Ticks into the current frame     */
+
+    /* Statistics */
+    uint64_t     dispatches;        /* Context switches made by table   */
+    uint64_t     slot_ticks;        /* Ticks the table assigned to work */
+    uint64_t     unused_slots;      /* Assigned task had nothing to do  */
+};
+
+/* ── Generation ───────────────────────────────────────────────────── */
+
+/**
+ * Build a table for the core's periodic tasks, released synchronously
+ * at the current tick. Splitting is only used if no frame size admits
+ * whole jobs. The table is stored but not yet dispatched from.
+ * Returns false (and prints why) if no feasible table was found.
+ */
+bool cyclic_build(Scheduler *sched);
+
+/**
+ * Install an externally synthesized table: one frame spanning the
+ * hyperperiod, with slices sorted by start and not overlapping. Gaps
+ * between slices are idle. Replaces any table already built.
+ */
+bool cyclic_load(Scheduler *sched, uint64_t hyperperiod,
+                 const CyclicSlice *slices, int count);
+
+/** Start table-driven dispatch at the current tick (table origin). */
+bool cyclic_start(Scheduler *sched);
+
+/** Discard the table and return to priority dispatch. */
+void cyclic_disable(Scheduler *sched);
+
+/* ── Dispatch ─────────────────────────────────────────────────────── */
+
+/** Advance the cursor by one tick (called by tick_handler). */
+void cyclic_tick(Scheduler *sched);
+
+/**
+ * Switch to the task the table assigns to the coming tick, or to idle
+ * if the slot is empty or its task has no pending work. Called by
+ * scheduler_schedule() instead of the priority decision.
+ */
+void cyclic_dispatch(Scheduler *sched);
+
+/* ── Output ───────────────────────────────────────────────────────── */
+
+/** Print frame size, hyperperiod and the slices of the first frames. */
+void cyclic_print_table(const Scheduler *sched, int max_frames);
+
+/**
+ * Write the table as C arrays `<prefix>_slices` and `<prefix>_frames`
+ * (CSR offsets into the slices), keyed by task id, for a target build.
+ */
+void cyclic_emit_c(const Scheduler *sched, FILE *out, const char *prefix);
+
+#endif /* CYCLIC_H */
@@ -0,0 +1,498 @@
+/*
+ * dag.c - Parallel DAG Tasks with Federated Scheduling
+ *
+ * Node releases are event driven: a node becomes ready in the tick after
+ * its last predecessor completes. Dedicated clusters run a greedy
+ * (work-conserving) list scheduler that prefers the node with the
+ * longest remaining path; shared cores run light DAGs one node at a
+ * time under preemptive EDF.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "dag.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+/* ── Graph helpers ────────────────────────────────────────────────── */
+
+static uint32_t all_nodes_mask(const DagTask *dag)
+{
+    return (dag->node_count >= 32) ? 0xFFFFFFFFu
+                                   : ((1u << dag->node_count) - 1u);
+}
+
+/* Ancestors of `node` (transitive closure over predecessor masks) */
+static uint32_t ancestors(const DagTask *dag, int node)
+{
+    uint32_t anc  = dag->preds[node];
+    uint32_t seen = 0;
+    while (anc != seen) {
+        uint32_t todo = anc & ~seen;
+        seen = anc;
+        for (int j = 0; j < dag->node_count; j++) {
+            if (todo & (1u << j)) anc |= dag->preds[j];
+        }
+    }
+    return anc;
+}
+
+/* Kahn's algorithm; returns number of nodes ordered */
+static int topo_order(const DagTask *dag, int *order)
+{
+    uint32_t placed = 0;
+    int n = 0;
+    while (n < dag->node_count) {
+        int progress = 0;
+        for (int i = 0; i < dag->node_count; i++) {
+            if (placed & (1u << i)) continue;
+            if ((dag->preds[i] & ~placed) == 0) {
+                order[n++] = i;
+                placed |= 1u << i;
+                progress = 1;
+            }
+        }
+        if (!progress) break;
+    }
+    return n;
+}
+
+static void compute_bottom_levels(DagTask *dag)
+{
+    int order[DAG_MAX_NODES];
+    int n = topo_order(dag, order);
+
+    for (int k = n - 1; k >= 0; k--) {
+        int i = order[k];
+        uint64_t best = 0;
+        for (int j = 0; j < dag->node_count; j++) {
+            if ((dag->preds[j] & (1u << i)) && dag->bottom_level[j] > best) {
+                best = dag->bottom_level[j];
+            }
+        }
+        dag->bottom_level[i] = dag->node_wcet[i] + best;
+    }
+}
+
+/* ── Creation ─────────────────────────────────────────────────────── */
+
+void dag_system_init(DagSystem *sys, int cores)
+{
+    if (!sys) return;
+    memset(sys, 0, sizeof(DagSystem));
+    if (cores < 1)             cores = 1;
+    if (cores > DAG_MAX_CORES) cores = DAG_MAX_CORES;
+    sys->cores = cores;
+    for (int c = 0; c < DAG_MAX_CORES; c++) {
+        sys->core_dag[c]  = DAG_NONE;
+        sys->core_node[c] = DAG_NONE;
+    }
+}
+
+void dag_system_destroy(DagSystem *sys)
+{
+    if (!sys) return;
+    for (int i = 0; i < sys->dag_count; i++) {
+        free(sys->dags[i]);
+        sys->dags[i] = NULL;
+    }
+    sys->dag_count = 0;
+}
+
+DagTask *dag_create(DagSystem *sys, const char *name,
+                    uint64_t period, uint64_t deadline)
+{
+    if (!sys || sys->dag_count >= DAG_MAX_TASKS || period == 0) {
+        fprintf(stderr, "dag_create: system full or bad period\n");
+        return NULL;
+    }
+    DagTask *dag = calloc(1, sizeof(DagTask));
+    if (!dag) return NULL;
+
+    snprintf(dag->name, DAG_NAME_MAX, "%s", name);
+    dag->period     = period;
+    dag->deadline   = (deadline > 0) ? deadline : period;
+    dag->first_core = DAG_NONE;
+    dag->resp_min   = UINT64_MAX;
+
+    sys->dags[sys->dag_count++] = dag;
+    sys->allocated = false;
+    return dag;
+}
+
+int dag_add_node(DagTask *dag, const char *name, uint64_t wcet)
+{
+    if (!dag || dag->node_count >= DAG_MAX_NODES || wcet == 0) {
+        return DAG_NONE;
+    }
+    int i = dag->node_count++;
+    snprintf(dag->node_name[i], DAG_NAME_MAX, "%s", name);
+    dag->node_wcet[i] = wcet;
+    dag->preds[i]     = 0;
+    compute_bottom_levels(dag);
+    return i;
+}
+
+bool dag_add_edge(DagTask *dag, int from, int to)
+{
+    if (!dag || from < 0 || to < 0 ||
+        from >= dag->node_count || to >= dag->node_count) {
+        return false;
+    }
+    /* A cycle would form if `to` already precedes `from` */
+    if (from == to || (ancestors(dag, from) & (1u << to))) {
+        fprintf(stderr, "dag_add_edge: %s -> %s would create a cycle in %s\n",
+                dag->node_name[from], dag->node_name[to], dag->name);
+        return false;
+    }
+    dag->preds[to] |= 1u << from;
+    compute_bottom_levels(dag);
+    return true;
+}
+
+uint64_t dag_work(const DagTask *dag)
+{
+    uint64_t w = 0;
+    for (int i = 0; dag && i < dag->node_count; i++) w += dag->node_wcet[i];
+    return w;
+}
+
+uint64_t dag_span(const DagTask *dag)
+{
+    uint64_t s = 0;
+    for (int i = 0; dag && i < dag->node_count; i++) {
+        if (dag->bottom_level[i] > s) s = dag->bottom_level[i];
+    }
+    return s;
+}
+
+/* ── Federated allocation ─────────────────────────────────────────── */
+
+static double dag_density(const DagTask *dag)
+{
+    return (double)dag_work(dag) / (double)dag->deadline;
+}
+
+bool dag_federated_allocate(DagSystem *sys)
+{
+    if (!sys) return false;
+
+    bool ok = true;
+    int  next_core = 0;
+
+    /* Heavy DAGs: dedicated clusters */
+    for (int d = 0; d < sys->dag_count; d++) {
+        DagTask *dag = sys->dags[d];
+        uint64_t work = dag_work(dag);
+        uint64_t span = dag_span(dag);
+
+        dag->heavy      = (work > dag->deadline);
+        dag->first_core = DAG_NONE;
+        dag->core_count = 0;
+        if (!dag->heavy) continue;
+
+        if (span >= dag->deadline) {
+            ok = false;                  /* Critical path alone too long */
+            continue;
+        }
+        uint64_t slack = dag->deadline - span;
+        int n = (int)((work - span + slack - 1) / slack);
+        if (next_core + n > sys->cores) {
+            ok = false;
+            continue;
+        }
+        dag->first_core = next_core;
+        dag->core_count = n;
+        next_core += n;
+    }
+    sys->dedicated_cores = next_core;
+
+    for (int c = 0; c < DAG_MAX_CORES; c++) sys->shared_density[c] = 0.0;
+
+    /* Light DAGs: first-fit decreasing density on the shared cores */
+    DagTask *light[DAG_MAX_TASKS];
+    int nl = 0;
+    for (int d = 0; d < sys->dag_count; d++) {
+        if (!sys->dags[d]->heavy) light[nl++] = sys->dags[d];
+    }
+    for (int a = 1; a < nl; a++) {
+        DagTask *v = light[a];
+        int b = a - 1;
+        while (b >= 0 && dag_density(light[b]) < dag_density(v)) {
+            light[b + 1] = light[b];
+            b--;
+        }
+        light[b + 1] = v;
+    }
+
+    for (int k = 0; k < nl; k++) {
+        DagTask *dag = light[k];
+        double dens = dag_density(dag);
+        int chosen = DAG_NONE;
+        int least  = DAG_NONE;
+
+        for (int c = next_core; c < sys->cores; c++) {
+            if (sys->shared_density[c] + dens <= 1.0 + 1e-9) {
+                chosen = c;
+                break;
+            }
+            if (least == DAG_NONE ||
+                sys->shared_density[c] < sys->shared_density[least]) {
+                least = c;
+            }
+        }
+        if (chosen == DAG_NONE) {
+            ok = false;
+            chosen = least;              /* Overload the emptiest core */
+        }
+        if (chosen == DAG_NONE) continue; /* No shared cores at all   */
+
+        dag->first_core = chosen;
+        dag->core_count = 1;
+        sys->shared_density[chosen] += dens;
+    }
+
+    sys->allocated   = true;
+    sys->schedulable = ok;
+    return ok;
+}
+
+/* ── Simulation ───────────────────────────────────────────────────── */
+
+/* Highest bottom-level node that is ready and not yet started */
+static int pick_ready_node(const DagTask *dag)
+{
+    int best = DAG_NONE;
+    for (int i = 0; i < dag->node_count; i++) {
+        uint32_t bit = 1u << i;
+        if (dag->started_mask & bit) continue;
+        if ((dag->preds[i] & ~dag->done_mask) != 0) continue;
+        if (best == DAG_NONE ||
+            dag->bottom_level[i] > dag->bottom_level[best]) {
+            best = i;
+        }
+    }
+    return best;
+}
+
+static void release_job(DagSystem *sys, int d)
+{
+    DagTask *dag = sys->dags[d];
+
+    if (dag->active) {
+        /* Previous job still running at its next release: drop it */
+        dag->jobs_dropped++;
+        dag->deadline_misses++;
+        for (int c = 0; c < sys->cores; c++) {
+            if (sys->core_dag[c] == d) {
+                sys->core_dag[c]  = DAG_NONE;
+                sys->core_node[c] = DAG_NONE;
+            }
+        }
+    }
+
+    dag->active       = true;
+    dag->release      = sys->now;
+    dag->done_mask    = 0;
+    dag->started_mask = 0;
+    for (int i = 0; i < dag->node_count; i++) {
+        dag->node_left[i] = dag->node_wcet[i];
+    }
+    dag->jobs_released++;
+}
+
+static void schedule_cluster(DagSystem *sys, int d)
+{
+    DagTask *dag = sys->dags[d];
+    for (int c = dag->first_core; c < dag->first_core + dag->core_count; c++) {
+        if (sys->core_node[c] != DAG_NONE) continue;  /* Node runs to end */
+        if (!dag->active) continue;
+        int node = pick_ready_node(dag);
+        if (node == DAG_NONE) break;
+        dag->started_mask |= 1u << node;
+        sys->core_dag[c]  = d;
+        sys->core_node[c] = node;
+    }
+}
+
+static void schedule_shared(DagSystem *sys, int c)
+{
+    /* EDF among the light DAGs with an active job on this core */
+    int best = DAG_NONE;
+    for (int d = 0; d < sys->dag_count; d++) {
+        const DagTask *dag = sys->dags[d];
+        if (dag->heavy || dag->first_core != c || !dag->active) continue;
+        if (best == DAG_NONE ||
+            dag->release + dag->deadline <
+            sys->dags[best]->release + sys->dags[best]->deadline) {
+            best = d;
+        }
+    }
+
+    if (sys->core_dag[c] != DAG_NONE && sys->core_dag[c] != best) {
+        sys->preemptions++;
+    }
+    sys->core_dag[c]  = best;
+    sys->core_node[c] = DAG_NONE;
+    if (best == DAG_NONE) return;
+
+    /* Light DAGs execute sequentially: resume the started node first */
+    DagTask *dag = sys->dags[best];
+    uint32_t in_progress = dag->started_mask & ~dag->done_mask;
+    int node = DAG_NONE;
+    for (int i = 0; i < dag->node_count; i++) {
+        if (in_progress & (1u << i)) { node = i; break; }
+    }
+    if (node == DAG_NONE) {
+        node = pick_ready_node(dag);
+        if (node != DAG_NONE) dag->started_mask |= 1u << node;
+    }
+    sys->core_node[c] = node;
+    if (node == DAG_NONE) sys->core_dag[c] = DAG_NONE;
+}
+
+static void dag_tick(DagSystem *sys)
+{
+    /* Periodic DAG job releases */
+    for (int d = 0; d < sys->dag_count; d++) {
+        if (sys->now % sys->dags[d]->period == 0) release_job(sys, d);
+    }
+
+    /* Dispatch */
+    for (int d = 0; d < sys->dag_count; d++) {
+        if (sys->dags[d]->heavy) schedule_cluster(sys, d);
+    }
+    for (int c = sys->dedicated_cores; c < sys->cores; c++) {
+        schedule_shared(sys, c);
+    }
+
+    if (sys->trace_len < DAG_TRACE_MAX) {
+        for (int c = 0; c < sys->cores; c++) {
+            sys->trace[sys->trace_len][c] =
+                (sys->core_node[c] != DAG_NONE) ? sys->core_dag[c] : DAG_NONE;
+        }
+        sys->trace_len++;
+    }
+
+    /* Execute one tick on every busy core */
+    for (int c = 0; c < sys->cores; c++) {
+        int d = sys->core_dag[c];
+        int node = sys->core_node[c];
+        if (d == DAG_NONE || node == DAG_NONE) continue;
+
+        DagTask *dag = sys->dags[d];
+        sys->core_busy[c]++;
+        if (--dag->node_left[node] > 0) continue;
+
+        /* Node complete: successors become ready next tick */
+        dag->done_mask |= 1u << node;
+        sys->core_node[c] = DAG_NONE;
+        if (dag->heavy) sys->core_dag[c] = DAG_NONE;
+
+        if (dag->done_mask == all_nodes_mask(dag)) {
+            uint64_t resp = sys->now + 1 - dag->release;
+            dag->active = false;
+            dag->jobs_completed++;
+            dag->resp_total += resp;
+            if (resp < dag->resp_min) dag->resp_min = resp;
+            if (resp > dag->resp_max) dag->resp_max = resp;
+            if (resp > dag->deadline) dag->deadline_misses++;
+            if (!dag->heavy) sys->core_dag[c] = DAG_NONE;
+        }
+    }
+
+    sys->now++;
+}
+
+void dag_simulate(DagSystem *sys, uint64_t ticks)
+{
+    if (!sys) return;
+    if (!sys->allocated) dag_federated_allocate(sys);
+    for (uint64_t i = 0; i < ticks; i++) {
+        dag_tick(sys);
+    }
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+void dag_print_report(const DagSystem *sys)
+{
+    if (!sys) return;
+
+    printf("\n");
+    printf("================================================================\n");
+    printf("         FEDERATED DAG SCHEDULING  —  %d cores\n", sys->cores);
+    printf("================================================================\n\n");
+
+    printf("  %-10s %5s %5s %5s %5s %6s %-9s %4s %4s %5s %5s %5s %5s\n",
+           "DAG", "Nodes", "Work", "Span", "D", "Type", "Cores",
+           "Jobs", "Miss", "Rmin", "Ravg", "Rmax", "Bound");
+
+    for (int d = 0; d < sys->dag_count; d++) {
+        const DagTask *dag = sys->dags[d];
+        uint64_t work = dag_work(dag);
+        uint64_t span = dag_span(dag);
+
+        char cores[16];
+        if (dag->core_count == 0) {
+            snprintf(cores, sizeof(cores), "none");
+        } else if (dag->heavy) {
+            snprintf(cores, sizeof(cores), "C%d-C%d", dag->first_core,
+                     dag->first_core + dag->core_count - 1);
+        } else {
+            snprintf(cores, sizeof(cores), "C%d*", dag->first_core);
+        }
+
+        /* Graham bound for a dedicated cluster, deadline otherwise */
+        uint64_t bound = dag->deadline;
+        if (dag->heavy && dag->core_count > 0) {
+            uint64_t n = (uint64_t)dag->core_count;
+            bound = span + (work - span + n - 1) / n;
+        }
+
+        uint64_t ravg = dag->jobs_completed
+                      ? dag->resp_total / dag->jobs_completed : 0;
+        printf("  %-10s %5d %5" PRIu64 " %5" PRIu64 " %5" PRIu64
+               " %6s %-9s %4u %4u %5" PRIu64 " %5" PRIu64
+               " %5" PRIu64 " %5" PRIu64 "\n",
+               dag->name, dag->node_count, work, span, dag->deadline,
+               dag->heavy ? "heavy" : "light", cores,
+               dag->jobs_released, dag->deadline_misses,
+               dag->jobs_completed ? dag->resp_min : 0, ravg,
+               dag->resp_max, bound);
+    }
+
+    printf("\n  (* = shared core, EDF)  Dedicated cores: %d of %d\n",
+           sys->dedicated_cores, sys->cores);
+    printf("  Federated test: %s\n",
+           sys->schedulable ? "SCHEDULABLE" : "NOT SCHEDULABLE");
+    printf("  Shared-core preemptions: %" PRIu64 "\n", sys->preemptions);
+
+    printf("\n  Core utilization over %" PRIu64 " ticks:\n", sys->now);
+    for (int c = 0; c < sys->cores; c++) {
+        printf("    C%-2d %5.1f%%\n", c, sys->now
+               ? 100.0 * (double)sys->core_busy[c] / (double)sys->now : 0.0);
+    }
+
+    if (sys->trace_len > 0) {
+        printf("\n  Schedule (first %d ticks):\n", sys->trace_len);
+        for (int c = 0; c < sys->cores; c++) {
+            printf("    C%-2d |", c);
+            for (int s = 0; s < sys->trace_len; s++) {
+                int d = sys->trace[s][c];
+                putchar(d == DAG_NONE ? '.' : (char)('A' + d % 26));
+            }
+            printf("|\n");
+        }
+        printf("    Legend:");
+        for (int d = 0; d < sys->dag_count; d++) {
+            printf(" %c=%s", 'A' + d % 26, sys->dags[d]->name);
+        }
+        printf("  .=idle\n");
+    }
+    printf("\n");
+}
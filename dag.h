@@ -0,0 +1,123 @@
+/*
+ * dag.h - Parallel DAG Tasks with Federated Scheduling
+ *
+ * A DAG task is a periodic fork/join job made of nodes (sub-jobs with
+ * their own WCETs) connected by precedence edges. Federated scheduling
+ * gives every heavy DAG (work > deadline) a dedicated cluster of
+ *
+ *     n = ceil((work - span) / (deadline - span))
+ *
+ * cores scheduled greedily, and packs light DAGs as sequential jobs
+ * onto the remaining shared cores under EDF.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef DAG_H
+#define DAG_H
+
+#include "smp.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define DAG_NAME_MAX     32
+#define DAG_MAX_NODES    32      /* Predecessor sets are 32-bit masks */
+#define DAG_MAX_TASKS    16
+#define DAG_MAX_CORES    SMP_MAX_CORES
+#define DAG_TRACE_MAX    100
+#define DAG_NONE         (-1)
+
+/* ── DAG task ─────────────────────────────────────────────────────── */
+typedef struct DagTask {
+    char      name[DAG_NAME_MAX];
+    uint64_t  period;
+    uint64_t  deadline;
+
+    /* Graph */
+    int       node_count;
+    char      node_name[DAG_MAX_NODES][DAG_NAME_MAX];
+    uint64_t  node_wcet[DAG_MAX_NODES];
+    uint32_t  preds[DAG_MAX_NODES];        /* Bit j: edge j -> i      */
+    uint64_t  bottom_level[DAG_MAX_NODES]; /* Longest path to a sink  */
+
+    /* Federated allocation */
+    bool      heavy;
+    int       first_core;
+    int       core_count;                  /* Dedicated (heavy) or 1  */
+
+    /* Current job */
+    bool      active;
+    uint64_t  release;
+    uint32_t  done_mask;
+    uint32_t  started_mask;
+    uint64_t  node_left[DAG_MAX_NODES];
+
+    /* Statistics */
+    uint32_t  jobs_released;
+    uint32_t  jobs_completed;
+    uint32_t  deadline_misses;
+    uint32_t  jobs_dropped;
+    uint64_t  resp_min;
+    uint64_t  resp_max;
+    uint64_t  resp_total;
+} DagTask;
+
+/* ── DAG system (m cores) ─────────────────────────────────────────── */
+typedef struct {
+    int       cores;
+    DagTask  *dags[DAG_MAX_TASKS];
+    int       dag_count;
+
+    bool      allocated;
+    bool      schedulable;
+    int       dedicated_cores;
+    double    shared_density[DAG_MAX_CORES];
+
+    /* Simulation */
+    uint64_t  now;
+    int       core_dag[DAG_MAX_CORES];     /* Running (dag, node) or  */
+    int       core_node[DAG_MAX_CORES];    /* DAG_NONE when idle      */
+    uint64_t  core_busy[DAG_MAX_CORES];
+    uint64_t  preemptions;
+
+    int       trace[DAG_TRACE_MAX][DAG_MAX_CORES];   /* DAG index */
+    int       trace_len;
+} DagSystem;
+
+/* ── Public API ───────────────────────────────────────────────────── */
+
+void dag_system_init(DagSystem *sys, int cores);
+void dag_system_destroy(DagSystem *sys);
+
+/** Create an empty DAG task (deadline 0 = implicit, equal to period). */
+DagTask *dag_create(DagSystem *sys, const char *name,
+                    uint64_t period, uint64_t deadline);
+
+/** Add a node; returns its index or DAG_NONE if the DAG is full. */
+int dag_add_node(DagTask *dag, const char *name, uint64_t wcet);
+
+/** Add edge from -> to. Rejected (false) if it would create a cycle. */
+bool dag_add_edge(DagTask *dag, int from, int to);
+
+/** Total work (volume): sum of all node WCETs. */
+uint64_t dag_work(const DagTask *dag);
+
+/** Span: length of the longest (critical) path. */
+uint64_t dag_span(const DagTask *dag);
+
+/**
+ * Federated core allocation. Heavy DAGs get dedicated clusters; light
+ * DAGs are packed first-fit by decreasing density onto shared cores.
+ * Returns true if the whole system passes the federated test.
+ */
+bool dag_federated_allocate(DagSystem *sys);
+
+/** Simulate `ticks` ticks (allocates first if needed). */
+void dag_simulate(DagSystem *sys, uint64_t ticks);
+
+/** Print allocation, per-DAG end-to-end response times and a Gantt. */
+void dag_print_report(const DagSystem *sys);
+
+#endif /* DAG_H */
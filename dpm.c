@@ -0,0 +1,413 @@
+/*
+ * dpm.c - Idle-Time Dynamic Power Management
+ *
+ * Break-even time of a sleep state (Benini, Bogliolo, De Micheli):
+ *
+ *   T_be = max(T_tr, (E_tr - T_tr * P_sleep) / (P_idle - P_sleep))
+ *
+ * with T_tr = entry + exit latency and E_tr the transition energy.
+ * Transition ticks are charged at E_tr / T_tr.
+ *
+ * The state machine runs at the end of each tick: ENTER and EXIT count
+ * down their latencies; ASLEEP begins its exit so that it completes at
+ * the next timed event (timer wake-up), when unannounced work appears
+ * (late wake-up), or, when procrastinating, Z ticks after the first
+ * arrival it is holding. Z is the largest delay for which the
+ * response-time analysis with Z added to every busy period,
+ * R_i = Z + C_i + sum_{hp j} ceil(R_i / T_j) * C_j <= D_i, still holds
+ * (Jejurikar and Gupta).
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "dpm.h"
+#include "rtos_time.h"
+#include "timeline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <inttypes.h>
+
+/* ── Helpers ──────────────────────────────────────────────────────── */
+
+static double transition_mw(const DpmSleepState *s)
+{
+    uint32_t ticks = s->entry_ticks + s->exit_ticks;
+    return ticks ? s->transition_uj / ticks : 0.0;
+}
+
+static void record(Scheduler *sched, const char *what)
+{
+    if (sched->timeline) {
+        char buf[ANNOTATION_MAX];
+        snprintf(buf, sizeof(buf), "DPM: %s %s", what,
+                 sched->dpm->state[sched->dpm->sleep_state].name);
+        timeline_record(sched->timeline, sched->system_ticks, NULL,
+                        VIS_NONE, buf);
+    }
+}
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+void dpm_enable(Scheduler *sched, DpmPolicy policy, uint32_t window)
+{
+    if (!sched) return;
+    if (window == 0 || window > DPM_WINDOW_MAX) {
+        fprintf(stderr, "dpm_enable: window must be 1..%d ticks\n",
+                DPM_WINDOW_MAX);
+        return;
+    }
+
+    if (!sched->dpm) {
+        sched->dpm = calloc(1, sizeof(DpmState));
+        if (!sched->dpm) {
+            fprintf(stderr, "dpm_enable: out of memory\n");
+            return;
+        }
+        sched->dpm->active_mw       = 1000.0;
+        sched->dpm->idle_mw         = 300.0;
+        sched->dpm->window_util_min = 1.0;
+    }
+    sched->dpm->policy     = policy;
+    sched->dpm->window_len = window;
+    sched->dpm->procrastination = (policy == DPM_PROCRASTINATE)
+                                ? dpm_procrastination_bound(sched) : 0;
+}
+
+void dpm_disable(Scheduler *sched)
+{
+    if (!sched) return;
+    free(sched->dpm);
+    sched->dpm = NULL;
+}
+
+void dpm_set_power(Scheduler *sched, double active_mw, double idle_mw)
+{
+    if (!sched || !sched->dpm) return;
+    sched->dpm->active_mw = active_mw;
+    sched->dpm->idle_mw   = idle_mw;
+}
+
+uint64_t dpm_add_state(Scheduler *sched, const char *name, double power_mw,
+                       uint32_t entry_ticks, uint32_t exit_ticks,
+                       double transition_uj)
+{
+    DpmState *dpm = sched ? sched->dpm : NULL;
+    if (!dpm) return 0;
+    if (dpm->state_count >= DPM_MAX_STATES) {
+        fprintf(stderr, "dpm_add_state: state table full\n");
+        return 0;
+    }
+    if (power_mw >= dpm->idle_mw ||
+        (dpm->state_count > 0 &&
+         power_mw >= dpm->state[dpm->state_count - 1].power_mw)) {
+        fprintf(stderr, "dpm_add_state: %s must draw less than the "
+                "shallower states\n", name);
+        return 0;
+    }
+
+    DpmSleepState *s = &dpm->state[dpm->state_count++];
+    *s = (DpmSleepState){ .power_mw = power_mw, .entry_ticks = entry_ticks,
+                          .exit_ticks = exit_ticks,
+                          .transition_uj = transition_uj };
+    snprintf(s->name, DPM_STATE_NAME_MAX, "%s", name);
+
+    uint64_t t_tr = entry_ticks + exit_ticks;
+    double   t_e  = (transition_uj - (double)t_tr * power_mw) /
+                    (dpm->idle_mw - power_mw);
+    s->break_even = (t_e > (double)t_tr) ? (uint64_t)ceil(t_e) : t_tr;
+    if (s->break_even == 0) s->break_even = 1;
+    return s->break_even;
+}
+
+/* Response time of ti when its busy period starts z ticks late:
+   R = z + C_i + sum_{hp j} ceil(R / T_j) * C_j. Returns a value past
+   D_i when the task no longer meets its deadline. */
+static uint64_t delayed_response(const Scheduler *sched,
+                                 const TaskControlBlock *ti, uint64_t z)
+{
+    uint64_t r = z + ti->wcet, prev = 0;
+    while (r != prev && r <= ti->relative_deadline) {
+        prev = r;
+        r    = z + ti->wcet;
+        for (int j = 0; j < sched->task_count; j++) {
+            const TaskControlBlock *tj = sched->all_tasks[j];
+            if (tj == ti || !tj || tj == sched->idle_task ||
+                tj->period == 0 || tj->priority > ti->priority) {
+                continue;
+            }
+            r += ((prev + tj->period - 1) / tj->period) * tj->wcet;
+        }
+    }
+    return r;
+}
+
+static bool delay_feasible(const Scheduler *sched, uint64_t z)
+{
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *ti = sched->all_tasks[i];
+        if (!ti || ti == sched->idle_task || ti->period == 0) continue;
+        if (delayed_response(sched, ti, z) > ti->relative_deadline) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t dpm_procrastination_bound(const Scheduler *sched)
+{
+    if (!sched) return 0;
+
+    /* Feasibility is monotone in z and z < min D_i, so binary-search
+       the largest delay that keeps every task schedulable */
+    uint64_t hi = 0;
+    bool     any = false;
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *ti = sched->all_tasks[i];
+        if (!ti || ti == sched->idle_task || ti->period == 0) continue;
+        if (!any || ti->relative_deadline < hi) hi = ti->relative_deadline;
+        any = true;
+    }
+    if (!any || !delay_feasible(sched, 0)) return 0;
+
+    uint64_t lo = 0;
+    while (lo < hi) {
+        uint64_t mid = lo + (hi - lo + 1) / 2;
+        if (delay_feasible(sched, mid)) lo = mid;
+        else                            hi = mid - 1;
+    }
+    return lo;
+}
+
+/* ── Idle accounting ──────────────────────────────────────────────── */
+
+static void account(DpmState *dpm, bool busy)
+{
+    /* Sliding window */
+    uint8_t *slot = &dpm->window[dpm->window_pos];
+    dpm->window_busy += (uint32_t)busy - *slot;
+    *slot = busy;
+    dpm->window_pos = (dpm->window_pos + 1) % dpm->window_len;
+
+    if (busy) {
+        dpm->busy_ticks++;
+        if (dpm->idle_run > 0) {
+            int b = 0;
+            while (b < DPM_HIST_BUCKETS - 1 && (dpm->idle_run >> (b + 1))) b++;
+            dpm->hist[b]++;
+            dpm->idle_intervals++;
+            dpm->idle_closed_ticks += dpm->idle_run;
+            if (dpm->idle_run > dpm->idle_longest) {
+                dpm->idle_longest = dpm->idle_run;
+            }
+            dpm->idle_run = 0;
+        }
+    } else {
+        dpm->idle_ticks++;
+        dpm->idle_run++;
+    }
+
+    if (dpm->busy_ticks + dpm->idle_ticks >= dpm->window_len) {
+        double u = (double)dpm->window_busy / dpm->window_len;
+        if (u < dpm->window_util_min) dpm->window_util_min = u;
+        if (u > dpm->window_util_max) dpm->window_util_max = u;
+    }
+}
+
+/* ── Sleep state machine ──────────────────────────────────────────── */
+
+bool dpm_core_asleep(const Scheduler *sched)
+{
+    return sched && sched->dpm && sched->dpm->phase != DPM_RUN;
+}
+
+static void begin_exit(Scheduler *sched)
+{
+    DpmState *dpm = sched->dpm;
+    dpm->phase     = DPM_EXIT;
+    dpm->countdown = dpm->state[dpm->sleep_state].exit_ticks;
+    dpm->hold_until = 0;
+    record(sched, "waking from");
+    if (dpm->countdown == 0) {
+        dpm->phase = DPM_RUN;
+        dpm->wakeups++;
+        dpm->batched_jobs += (uint32_t)sched->ready_count;
+    }
+}
+
+static void try_sleep(Scheduler *sched)
+{
+    DpmState *dpm = sched->dpm;
+    uint64_t  now = sched->system_ticks;
+    uint64_t  event = next_event_tick(sched);
+
+    /* Time until the core must be running again */
+    uint64_t gap = (event == UINT64_MAX) ? UINT64_MAX
+                 : event - now + dpm->procrastination;
+
+    /* Cheapest state over the predicted interval among those whose
+       break-even time fits; staying awake costs gap * P_idle */
+    int    pick = -1;
+    double best = (gap == UINT64_MAX) ? INFINITY : (double)gap * dpm->idle_mw;
+    for (int s = 0; s < dpm->state_count; s++) {
+        const DpmSleepState *st = &dpm->state[s];
+        uint64_t t_tr = (uint64_t)st->entry_ticks + st->exit_ticks;
+        if (st->break_even > gap || t_tr > gap) continue;
+
+        double e = (gap == UINT64_MAX) ? st->power_mw
+                 : st->transition_uj + (double)(gap - t_tr) * st->power_mw;
+        if (gap == UINT64_MAX || e < best) {
+            best = e;
+            pick = s;
+        }
+    }
+    if (pick < 0) return;
+
+    DpmSleepState *st = &dpm->state[pick];
+    dpm->sleep_state = pick;
+    dpm->phase       = DPM_ENTER;
+    dpm->countdown   = st->entry_ticks;
+    dpm->hold_until  = 0;
+    dpm->wake_at     = (event == UINT64_MAX) ? UINT64_MAX
+                     : event + dpm->procrastination - st->exit_ticks;
+    st->entries++;
+    record(sched, "entering");
+    if (dpm->countdown == 0) dpm->phase = DPM_ASLEEP;
+}
+
+void dpm_tick(Scheduler *sched, TaskControlBlock *curr)
+{
+    DpmState *dpm = sched ? sched->dpm : NULL;
+    if (!dpm) return;
+
+    /* Account the tick just executed */
+    bool busy = dpm->phase == DPM_RUN && curr && curr != sched->idle_task;
+    account(dpm, busy);
+
+    const DpmSleepState *st = &dpm->state[dpm->sleep_state];
+    switch (dpm->phase) {
+    case DPM_RUN:
+        dpm->energy_uj += busy ? dpm->active_mw : dpm->idle_mw;
+        break;
+    case DPM_ENTER:
+    case DPM_EXIT:
+        dpm->energy_uj += transition_mw(st);
+        break;
+    case DPM_ASLEEP:
+        dpm->energy_uj += st->power_mw;
+        dpm->state[dpm->sleep_state].resident_ticks++;
+        break;
+    }
+
+    /* Advance the state machine */
+    uint64_t now  = sched->system_ticks;
+    bool     work = sched->ready_count > 0;
+
+    if (dpm->phase == DPM_ENTER || dpm->phase == DPM_EXIT) {
+        if (dpm->countdown > 0) dpm->countdown--;
+        if (dpm->countdown == 0) {
+            if (dpm->phase == DPM_EXIT) {
+                dpm->phase = DPM_RUN;
+                dpm->wakeups++;
+                dpm->batched_jobs += (uint32_t)sched->ready_count;
+                return;
+            }
+            dpm->phase = DPM_ASLEEP;
+        }
+    }
+
+    if (dpm->phase != DPM_RUN && work &&
+        dpm->policy == DPM_PROCRASTINATE && dpm->hold_until == 0) {
+        dpm->hold_until = now + dpm->procrastination;
+    }
+
+    if (dpm->phase == DPM_ASLEEP) {
+        uint32_t exit_ticks = st->exit_ticks;
+        bool     wake;
+        if (dpm->policy == DPM_PROCRASTINATE && work) {
+            uint64_t start = dpm->hold_until > exit_ticks
+                           ? dpm->hold_until - exit_ticks : 0;
+            wake = now >= start || now >= dpm->wake_at;
+        } else if (work) {
+            wake = true;
+            if (now < dpm->wake_at) dpm->late_wakeups++;
+        } else {
+            wake = now >= dpm->wake_at;
+        }
+        if (wake) begin_exit(sched);
+        return;
+    }
+
+    if (dpm->phase == DPM_RUN && dpm->policy != DPM_ACCOUNT_ONLY &&
+        (!curr || curr == sched->idle_task) && !work) {
+        try_sleep(sched);
+    }
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+double dpm_baseline_uj(const Scheduler *sched)
+{
+    const DpmState *dpm = sched ? sched->dpm : NULL;
+    if (!dpm) return 0.0;
+    return (double)dpm->busy_ticks * dpm->active_mw +
+           (double)dpm->idle_ticks * dpm->idle_mw;
+}
+
+double dpm_mean_idle_interval(const Scheduler *sched)
+{
+    const DpmState *dpm = sched ? sched->dpm : NULL;
+    if (!dpm || dpm->idle_intervals == 0) return 0.0;
+    return (double)dpm->idle_closed_ticks / dpm->idle_intervals;
+}
+
+void dpm_print_report(const Scheduler *sched)
+{
+    const DpmState *dpm = sched ? sched->dpm : NULL;
+    if (!dpm) return;
+
+    uint64_t total = dpm->busy_ticks + dpm->idle_ticks;
+    printf("\n  Busy %" PRIu64 " / idle %" PRIu64 " ticks (U = %.3f); "
+           "%u-tick window U min %.2f, max %.2f\n",
+           dpm->busy_ticks, dpm->idle_ticks,
+           total ? (double)dpm->busy_ticks / (double)total : 0.0,
+           dpm->window_len, dpm->window_util_min, dpm->window_util_max);
+    printf("  Idle intervals: %u, mean %.1f ticks, longest %" PRIu64 "\n",
+           dpm->idle_intervals, dpm_mean_idle_interval(sched),
+           dpm->idle_longest);
+
+    printf("  Length   ");
+    for (int b = 0; b < DPM_HIST_BUCKETS; b++) {
+        if (b == DPM_HIST_BUCKETS - 1) printf(" %5d+", 1 << b);
+        else                           printf(" %6d", 1 << b);
+    }
+    printf("\n  Count    ");
+    for (int b = 0; b < DPM_HIST_BUCKETS; b++) printf(" %6u", dpm->hist[b]);
+    printf("\n");
+
+    if (dpm->state_count > 0 && dpm->policy != DPM_ACCOUNT_ONLY) {
+        printf("\n  %-8s %7s %6s %5s %8s %8s %9s\n", "State", "Power",
+               "Entry", "Exit", "BreakEvn", "Entries", "Resident");
+        for (int s = 0; s < dpm->state_count; s++) {
+            const DpmSleepState *st = &dpm->state[s];
+            printf("  %-8s %4.0f mW %6u %5u %8" PRIu64 " %8u %9" PRIu64 "\n",
+                   st->name, st->power_mw, st->entry_ticks, st->exit_ticks,
+                   st->break_even, st->entries, st->resident_ticks);
+        }
+        printf("  Wake-ups %u (%u late), %.2f jobs per wake-up",
+               dpm->wakeups, dpm->late_wakeups,
+               dpm->wakeups ? (double)dpm->batched_jobs / dpm->wakeups : 0.0);
+        if (dpm->policy == DPM_PROCRASTINATE) {
+            printf(", procrastination Z = %" PRIu64 " ticks",
+                   dpm->procrastination);
+        }
+        printf("\n");
+    }
+
+    double base = dpm_baseline_uj(sched);
+    printf("  Energy %.1f mJ vs. %.1f mJ always awake (%.1f%% saved)\n",
+           dpm->energy_uj / 1000.0, base / 1000.0,
+           base > 0.0 ? 100.0 * (base - dpm->energy_uj) / base : 0.0);
+}
@@ -0,0 +1,161 @@
+/*
+ * dpm.h - Idle-Time Dynamic Power Management
+ *
+ * Measures idle time (utilization over a sliding window, histogram of
+ * idle-interval lengths) and puts an idle core into simulated sleep
+ * states. Each state has entry and exit latencies and a transition
+ * energy, from which its break-even time follows: the shortest idle
+ * interval for which entering the state saves energy. On every idle
+ * instant the state that costs least over the time to the next timed
+ * event (a periodic release or the end of a task delay) is chosen among
+ * those whose break-even time fits, and the wake-up is timed so the exit
+ * completes at that event.
+ *
+ * Procrastination (Jejurikar & Gupta) keeps the core asleep after a job
+ * arrives for up to Z ticks, the largest delay that response-time
+ * analysis with Z added to each busy period still accepts, so that
+ * several arrivals are served in one busy period and idle gaps merge
+ * into longer, deeper sleeps.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef DPM_H
+#define DPM_H
+
+#include "scheduler.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define DPM_MAX_STATES      4
+#define DPM_STATE_NAME_MAX  12
+#define DPM_WINDOW_MAX      1024    /* Sliding-window length bound     */
+#define DPM_HIST_BUCKETS    10      /* Idle intervals 1, 2-3, 4-7, ... */
+
+/* ── Policies ─────────────────────────────────────────────────────── */
+typedef enum {
+    DPM_ACCOUNT_ONLY,       /* Measure idle time, never sleep         */
+    DPM_SLEEP,              /* Sleep when the break-even time fits    */
+    DPM_PROCRASTINATE       /* Sleep and defer wake-ups by up to Z    */
+} DpmPolicy;
+
+/* Core power state */
+typedef enum {
+    DPM_RUN,                /* Executing or idling at active power    */
+    DPM_ENTER,              /* Transitioning into a sleep state       */
+    DPM_ASLEEP,
+    DPM_EXIT                /* Waking up                              */
+} DpmPhase;
+
+/* A sleep state */
+typedef struct {
+    char      name[DPM_STATE_NAME_MAX];
+    double    power_mw;
+    uint32_t  entry_ticks;
+    uint32_t  exit_ticks;
+    double    transition_uj;        /* Energy of entry + exit          */
+    uint64_t  break_even;           /* Derived, in ticks               */
+
+    /* Statistics */
+    uint32_t  entries;
+    uint64_t  resident_ticks;
+} DpmSleepState;
+
+/* ── Per-core state ───────────────────────────────────────────────── */
+struct DpmState {
+    DpmPolicy      policy;
+
+    /* Power model (one tick = 1 ms, so mW * ticks = uJ) */
+    double         active_mw;
+    double         idle_mw;             /* Awake with nothing to run   */
+
+    DpmSleepState  state[DPM_MAX_STATES];   /* Shallow to deep         */
+    int            state_count;
+
+    /* Sleep state machine */
+    DpmPhase       phase;
+    int            sleep_state;         /* Index into state[]          */
+    uint32_t       countdown;           /* Ticks left in ENTER / EXIT  */
+    uint64_t       wake_at;             /* Tick the exit starts        */
+    uint64_t       hold_until;          /* Procrastinated start        */
+    uint64_t       procrastination;     /* Z                           */
+
+    /* Idle accounting */
+    uint8_t        window[DPM_WINDOW_MAX];  /* 1 = busy tick           */
+    uint32_t       window_len;
+    uint32_t       window_pos;
+    uint32_t       window_busy;
+    double         window_util_min;
+    double         window_util_max;
+    uint64_t       busy_ticks;
+    uint64_t       idle_ticks;
+    uint64_t       idle_run;            /* Current idle interval       */
+    uint32_t       idle_intervals;      /* Closed intervals            */
+    uint64_t       idle_closed_ticks;   /* Idle ticks in those         */
+    uint64_t       idle_longest;
+    uint32_t       hist[DPM_HIST_BUCKETS];
+
+    /* Energy and wake statistics */
+    double         energy_uj;
+    uint32_t       wakeups;
+    uint32_t       late_wakeups;        /* Work arrived unannounced    */
+    uint32_t       batched_jobs;        /* Jobs waiting at wake-ups    */
+};
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+/**
+ * Enable power management with a `window`-tick utilization window.
+ * Call after the task set is created: Z is computed here.
+ */
+void dpm_enable(Scheduler *sched, DpmPolicy policy, uint32_t window);
+
+/** Disable and free the DPM state. */
+void dpm_disable(Scheduler *sched);
+
+/** Set the active and active-idle power (mW). */
+void dpm_set_power(Scheduler *sched, double active_mw, double idle_mw);
+
+/**
+ * Add a sleep state; states must be added shallow to deep. Returns its
+ * break-even time in ticks, or 0 on error.
+ */
+uint64_t dpm_add_state(Scheduler *sched, const char *name, double power_mw,
+                       uint32_t entry_ticks, uint32_t exit_ticks,
+                       double transition_uj);
+
+/**
+ * Longest delay Z by which the start of a busy period can be deferred:
+ * the largest Z with Z + C_i + sum_{hp j} ceil(R_i / T_j) * C_j <= D_i
+ * for every periodic task. Returns 0 if none is schedulable at Z = 0.
+ */
+uint64_t dpm_procrastination_bound(const Scheduler *sched);
+
+/* ── Runtime hooks ────────────────────────────────────────────────── */
+
+/** True while the core sleeps or transitions (nothing is dispatched). */
+bool dpm_core_asleep(const Scheduler *sched);
+
+/**
+ * Called at the end of tick_handler: accounts the tick just executed,
+ * then advances the sleep state machine given the jobs now ready.
+ */
+void dpm_tick(Scheduler *sched, TaskControlBlock *curr);
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+/** Energy the same run would have used idling at active-idle power. */
+double dpm_baseline_uj(const Scheduler *sched);
+
+/**
+ * Mean length of the idle intervals that have ended; an interval still
+ * open at the end of the run is not counted.
+ */
+double dpm_mean_idle_interval(const Scheduler *sched);
+
+/** Print idle accounting, the interval histogram and energy saved. */
+void dpm_print_report(const Scheduler *sched);
+
+#endif /* DPM_H */
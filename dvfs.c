@@ -0,0 +1,478 @@
+/*
+ * dvfs.c - Dynamic Voltage and Frequency Scaling
+ *
+ * Each running tick adds the current speed (per mille) to the task's
+ * cycle credit; every DVFS_SPEED_SCALE of credit retires one cycle of
+ * remaining_work. A job of c cycles at constant speed s therefore runs
+ * for ceil(c / s) ticks, which is the job length the tests below use.
+ *
+ * Cycle-conserving EDF picks the lowest speed with sum(c_i/T_i) <= 1,
+ * where c_i is the WCET while a job is pending and its actual cycles
+ * once it completed. Cycle-conserving RM hands the cycles available at
+ * the static speed until the next deadline to pending jobs in priority
+ * order and picks the lowest speed that fits the allocation.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "dvfs.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+/* ── Default operating points ─────────────────────────────────────── */
+
+static const DvfsOpp default_opps[] = {
+    {  200,  800 },
+    {  400,  900 },
+    {  600, 1000 },
+    {  800, 1100 },
+    { 1000, 1200 },
+};
+
+/* ── Helpers ──────────────────────────────────────────────────────── */
+
+static bool is_periodic(const Scheduler *sched, const TaskControlBlock *t)
+{
+    return t && t != sched->idle_task && t->period > 0 &&
+           t->state != TASK_TERMINATED;
+}
+
+static bool job_pending(const TaskControlBlock *t)
+{
+    return (t->state == TASK_READY || t->state == TASK_RUNNING ||
+            t->state == TASK_BLOCKED) && t->remaining_work > 0;
+}
+
+/* Ticks a job of `cycles` takes at `speed` per mille */
+static uint64_t ticks_at(uint64_t cycles, uint32_t speed)
+{
+    return (cycles * DVFS_SPEED_SCALE + speed - 1) / speed;
+}
+
+static void set_opp(DvfsState *dvfs, int opp)
+{
+    if (opp == dvfs->current) return;
+    dvfs->current = opp;
+    dvfs->switches++;
+}
+
+/* ── Schedulability at a given speed ──────────────────────────────── */
+
+/* EDF: total density with job lengths at `speed` */
+static bool edf_fits(const Scheduler *sched, uint32_t speed)
+{
+    double density = 0.0;
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *t = sched->all_tasks[i];
+        if (!is_periodic(sched, t)) continue;
+        uint64_t d = t->relative_deadline < t->period
+                   ? t->relative_deadline : t->period;
+        density += (double)ticks_at(t->wcet, speed) / (double)d;
+    }
+    return density <= 1.0 + 1e-9;
+}
+
+/* Fixed priorities: response-time analysis at `speed` */
+static bool rm_fits(const Scheduler *sched, uint32_t speed)
+{
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *ti = sched->all_tasks[i];
+        if (!is_periodic(sched, ti)) continue;
+
+        uint64_t ci = ticks_at(ti->wcet, speed);
+        uint64_t r  = ci, prev = 0;
+        while (r != prev && r <= ti->relative_deadline) {
+            prev = r;
+            r    = ci;
+            for (int j = 0; j < sched->task_count; j++) {
+                const TaskControlBlock *tj = sched->all_tasks[j];
+                if (j == i || !is_periodic(sched, tj) ||
+                    tj->priority > ti->priority) {
+                    continue;
+                }
+                r += ((prev + tj->period - 1) / tj->period) *
+                     ticks_at(tj->wcet, speed);
+            }
+        }
+        if (r > ti->relative_deadline) return false;
+    }
+    return true;
+}
+
+int dvfs_static_opp(const Scheduler *sched)
+{
+    const DvfsState *dvfs = sched ? sched->dvfs : NULL;
+    if (!dvfs) return -1;
+
+    for (int k = 0; k < dvfs->opp_count; k++) {
+        uint32_t speed = dvfs_speed(dvfs, k);
+        bool fits = (dvfs->dispatch == DVFS_DISPATCH_EDF)
+                  ? edf_fits(sched, speed)
+                  : rm_fits(sched, speed);
+        if (fits) return k;
+    }
+    return -1;
+}
+
+/* ── Governors ────────────────────────────────────────────────────── */
+
+static int cc_edf_select(const Scheduler *sched)
+{
+    const DvfsState *dvfs = sched->dvfs;
+
+    for (int k = 0; k < dvfs->static_opp; k++) {
+        uint32_t speed = dvfs_speed(dvfs, k);
+        double   u     = 0.0;
+        for (int i = 0; i < sched->task_count; i++) {
+            const TaskControlBlock *t = sched->all_tasks[i];
+            if (!is_periodic(sched, t)) continue;
+            /* Pending: plan for the WCET; done: the cycles it used */
+            uint64_t c = job_pending(t) ? t->wcet : t->dvfs_cycles;
+            u += (double)ticks_at(c, speed) / (double)t->period;
+        }
+        if (u <= 1.0 + 1e-9) return k;
+    }
+    return dvfs->static_opp;
+}
+
+/* Deadline of the task's current period, or of its next one */
+static uint64_t period_deadline(const Scheduler *sched,
+                                const TaskControlBlock *t)
+{
+    if (t->absolute_deadline > sched->system_ticks &&
+        t->absolute_deadline != UINT64_MAX) {
+        return t->absolute_deadline;
+    }
+    if (t->next_release == UINT64_MAX) return UINT64_MAX;
+    return t->next_release + t->relative_deadline;
+}
+
+static int cc_rm_select(const Scheduler *sched)
+{
+    const DvfsState *dvfs = sched->dvfs;
+    uint64_t now = sched->system_ticks;
+
+    uint64_t next_deadline = UINT64_MAX;
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *t = sched->all_tasks[i];
+        if (!is_periodic(sched, t)) continue;
+        uint64_t d = period_deadline(sched, t);
+        if (d < next_deadline) next_deadline = d;
+    }
+    if (next_deadline == UINT64_MAX) return 0;
+    if (next_deadline <= now) return dvfs->static_opp;
+    uint64_t window = next_deadline - now;
+
+    /* Pending jobs in priority order (RM priorities are periods and
+       may exceed PRIORITY_IDLE, so sort rather than scan levels) */
+    const TaskControlBlock *order[MAX_ALL_TASKS];
+    int n = 0;
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *t = sched->all_tasks[i];
+        if (!is_periodic(sched, t) || !job_pending(t)) continue;
+
+        int j = n++;
+        while (j > 0 && order[j - 1]->priority > t->priority) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = t;
+    }
+
+    /* Cycles the static speed could run before the next deadline,
+       allocated to pending jobs in priority order */
+    uint64_t budget = window * dvfs_speed(dvfs, dvfs->static_opp) /
+                      DVFS_SPEED_SCALE;
+    uint64_t alloc  = 0;
+    for (int k = 0; k < n && budget > 0; k++) {
+        const TaskControlBlock *t = order[k];
+        uint64_t left = t->wcet > t->dvfs_cycles
+                      ? t->wcet - t->dvfs_cycles : 0;
+        uint64_t d    = left < budget ? left : budget;
+        alloc  += d;
+        budget -= d;
+    }
+
+    for (int k = 0; k < dvfs->static_opp; k++) {
+        if (ticks_at(alloc, dvfs_speed(dvfs, k)) <= window) return k;
+    }
+    return dvfs->static_opp;
+}
+
+static void governor_update(Scheduler *sched)
+{
+    DvfsState *dvfs = sched->dvfs;
+
+    switch (dvfs->governor) {
+    case DVFS_GOV_MAX:
+        set_opp(dvfs, dvfs->opp_count - 1);
+        break;
+    case DVFS_GOV_STATIC:
+        set_opp(dvfs, dvfs->static_opp);
+        break;
+    case DVFS_GOV_CC:
+        set_opp(dvfs, dvfs->dispatch == DVFS_DISPATCH_EDF
+                      ? cc_edf_select(sched) : cc_rm_select(sched));
+        break;
+    }
+}
+
+/* EDF on the priority dispatcher: rank pending jobs by deadline */
+static void edf_rerank(Scheduler *sched, TaskControlBlock *released)
+{
+    TaskControlBlock *order[MAX_ALL_TASKS];
+    int n = 0;
+
+    for (int i = 0; i < sched->task_count; i++) {
+        TaskControlBlock *t = sched->all_tasks[i];
+        if (!t || t == sched->idle_task) continue;
+        if (t != released && !job_pending(t)) continue;
+
+        /* Insertion sort by (deadline, base priority) */
+        int j = n++;
+        while (j > 0 &&
+               (order[j - 1]->absolute_deadline > t->absolute_deadline ||
+                (order[j - 1]->absolute_deadline == t->absolute_deadline &&
+                 order[j - 1]->original_priority > t->original_priority))) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = t;
+    }
+
+    for (int r = 0; r < n; r++) {
+        if (order[r]->priority != r + 1) task_set_priority(order[r], r + 1);
+    }
+}
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+void dvfs_enable(Scheduler *sched, DvfsDispatch dispatch,
+                 DvfsGovernor governor)
+{
+    if (!sched) return;
+
+    if (!sched->dvfs) {
+        sched->dvfs = calloc(1, sizeof(DvfsState));
+        if (!sched->dvfs) {
+            fprintf(stderr, "dvfs_enable: out of memory\n");
+            return;
+        }
+        int n = (int)(sizeof(default_opps) / sizeof(default_opps[0]));
+        memcpy(sched->dvfs->opp, default_opps, sizeof(default_opps));
+        sched->dvfs->opp_count = n;
+        sched->dvfs->current   = n - 1;
+        sched->dvfs->static_mw = 50.0;
+        sched->dvfs->ceff_nf   = 1.0;
+        sched->dvfs->idle_mw   = 20.0;
+    }
+    sched->dvfs->dispatch = dispatch;
+    sched->dvfs->governor = governor;
+
+    int s = dvfs_static_opp(sched);
+    if (s < 0) {
+        fprintf(stderr, "dvfs_enable: task set does not fit even at "
+                "%" PRIu32 " MHz\n",
+                sched->dvfs->opp[sched->dvfs->opp_count - 1].freq_mhz);
+        s = sched->dvfs->opp_count - 1;
+    }
+    sched->dvfs->static_opp = s;
+
+    if (dispatch == DVFS_DISPATCH_EDF) edf_rerank(sched, NULL);
+    governor_update(sched);
+    sched->dvfs->switches = 0;
+}
+
+void dvfs_disable(Scheduler *sched)
+{
+    if (!sched) return;
+    free(sched->dvfs);
+    sched->dvfs = NULL;
+}
+
+bool dvfs_set_opps(Scheduler *sched, const DvfsOpp *opps, int count)
+{
+    DvfsState *dvfs = sched ? sched->dvfs : NULL;
+    if (!dvfs || !opps || count < 1 || count > DVFS_MAX_OPPS) {
+        fprintf(stderr, "dvfs_set_opps: invalid table\n");
+        return false;
+    }
+    for (int k = 1; k < count; k++) {
+        if (opps[k].freq_mhz <= opps[k - 1].freq_mhz) {
+            fprintf(stderr, "dvfs_set_opps: frequencies must ascend\n");
+            return false;
+        }
+    }
+
+    memcpy(dvfs->opp, opps, (size_t)count * sizeof(DvfsOpp));
+    dvfs->opp_count = count;
+    dvfs->current   = count - 1;
+
+    int s = dvfs_static_opp(sched);
+    dvfs->static_opp = (s < 0) ? count - 1 : s;
+    governor_update(sched);
+    return true;
+}
+
+bool dvfs_set_demand(Scheduler *sched, TaskControlBlock *task,
+                     const uint64_t *cycles, int count)
+{
+    DvfsState *dvfs = sched ? sched->dvfs : NULL;
+    if (!dvfs || !task || !cycles || count < 1 ||
+        count > DVFS_PATTERN_MAX) {
+        fprintf(stderr, "dvfs_set_demand: invalid pattern\n");
+        return false;
+    }
+
+    DvfsDemand *d = NULL;
+    for (int i = 0; i < dvfs->demand_count; i++) {
+        if (dvfs->demand[i].task == task) d = &dvfs->demand[i];
+    }
+    if (!d) {
+        if (dvfs->demand_count >= DVFS_MAX_DEMANDS) {
+            fprintf(stderr, "dvfs_set_demand: table full\n");
+            return false;
+        }
+        d = &dvfs->demand[dvfs->demand_count++];
+    }
+    d->task  = task;
+    d->count = count;
+    memcpy(d->cycles, cycles, (size_t)count * sizeof(uint64_t));
+
+    /* The first job was released by task_create */
+    if (task->invocations == 1 && task->dvfs_cycles == 0 &&
+        task->remaining_work == task->wcet) {
+        task->remaining_work = cycles[0];
+    }
+    return true;
+}
+
+/* ── Analysis ─────────────────────────────────────────────────────── */
+
+uint32_t dvfs_speed(const DvfsState *dvfs, int opp)
+{
+    uint32_t fmax = dvfs->opp[dvfs->opp_count - 1].freq_mhz;
+    return (uint32_t)((uint64_t)dvfs->opp[opp].freq_mhz *
+                      DVFS_SPEED_SCALE / fmax);
+}
+
+double dvfs_power_mw(const DvfsState *dvfs, int opp)
+{
+    double v = dvfs->opp[opp].voltage_mv / 1000.0;
+    return dvfs->static_mw + dvfs->ceff_nf * v * v * dvfs->opp[opp].freq_mhz;
+}
+
+/* ── Runtime hooks ────────────────────────────────────────────────── */
+
+void dvfs_job_released(Scheduler *sched, TaskControlBlock *task)
+{
+    DvfsState *dvfs = sched ? sched->dvfs : NULL;
+    if (!dvfs || !task) return;
+
+    for (int i = 0; i < dvfs->demand_count; i++) {
+        const DvfsDemand *d = &dvfs->demand[i];
+        if (d->task == task) {
+            task->remaining_work =
+                d->cycles[(task->invocations - 1) % (uint32_t)d->count];
+            break;
+        }
+    }
+    task->dvfs_cycles = 0;
+    task->dvfs_credit = 0;
+
+    if (dvfs->dispatch == DVFS_DISPATCH_EDF) edf_rerank(sched, task);
+    governor_update(sched);
+}
+
+void dvfs_execute(Scheduler *sched, TaskControlBlock *curr)
+{
+    DvfsState *dvfs = sched ? sched->dvfs : NULL;
+    if (!curr || curr->remaining_work == 0) return;
+    if (!dvfs || curr == sched->idle_task) {
+        curr->remaining_work--;
+        return;
+    }
+
+    curr->dvfs_credit += dvfs_speed(dvfs, dvfs->current);
+    while (curr->dvfs_credit >= DVFS_SPEED_SCALE &&
+           curr->remaining_work > 0) {
+        curr->dvfs_credit -= DVFS_SPEED_SCALE;
+        curr->remaining_work--;
+        curr->dvfs_cycles++;
+        curr->dvfs_cycles_total++;
+    }
+
+    if (curr->remaining_work == 0) {
+        /* Early completion: reclaim the unused cycles */
+        curr->dvfs_credit = 0;
+        curr->dvfs_jobs_done++;
+        governor_update(sched);
+    }
+}
+
+void dvfs_tick(Scheduler *sched, TaskControlBlock *curr, bool busy)
+{
+    DvfsState *dvfs = sched ? sched->dvfs : NULL;
+    if (!dvfs) return;
+
+    busy = busy && curr && curr != sched->idle_task;
+    if (busy) {
+        double e = dvfs_power_mw(dvfs, dvfs->current);
+        dvfs->energy_uj      += e;
+        dvfs->busy_energy_uj += e;
+        dvfs->busy_ticks++;
+        dvfs->opp_ticks[dvfs->current]++;
+    } else {
+        dvfs->energy_uj += dvfs->idle_mw;
+        dvfs->idle_ticks++;
+    }
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+void dvfs_print_report(const Scheduler *sched)
+{
+    const DvfsState *dvfs = sched ? sched->dvfs : NULL;
+    if (!dvfs) return;
+
+    static const char *gov_name[] = { "max", "static", "cycle-conserving" };
+
+    printf("\n  %-10s %5s %5s %5s %5s %9s %6s\n",
+           "Task", "WCET", "T", "Jobs", "Done", "AvgCycles", "Misses");
+    printf("  %-10s %5s %5s %5s %5s %9s %6s\n",
+           "----", "----", "-", "----", "----", "---------", "------");
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *t = sched->all_tasks[i];
+        if (!is_periodic(sched, t)) continue;
+        printf("  %-10s %5" PRIu64 " %5" PRIu64 " %5u %5u %9.2f %6u\n",
+               t->name, t->wcet, t->period, t->invocations,
+               t->dvfs_jobs_done,
+               t->dvfs_jobs_done
+                   ? (double)t->dvfs_cycles_total / t->dvfs_jobs_done : 0.0,
+               t->deadline_misses);
+    }
+
+    uint64_t busy = dvfs->busy_ticks ? dvfs->busy_ticks : 1;
+    printf("\n  %8s %8s %9s %11s\n", "Freq", "Voltage", "Power", "Busy share");
+    for (int k = 0; k < dvfs->opp_count; k++) {
+        printf("  %4" PRIu32 " MHz %5.2f V %6.0f mW %10.1f%%%s\n",
+               dvfs->opp[k].freq_mhz, dvfs->opp[k].voltage_mv / 1000.0,
+               dvfs_power_mw(dvfs, k),
+               100.0 * (double)dvfs->opp_ticks[k] / (double)busy,
+               k == dvfs->static_opp ? "  <- static" : "");
+    }
+
+    uint64_t total = dvfs->busy_ticks + dvfs->idle_ticks;
+    printf("\n  %s dispatch, %s governor: %" PRIu32 " frequency switches\n",
+           dvfs->dispatch == DVFS_DISPATCH_EDF ? "EDF" : "RM",
+           gov_name[dvfs->governor], dvfs->switches);
+    printf("  Busy %" PRIu64 " / idle %" PRIu64 " ticks, energy %.1f mJ "
+           "(busy %.1f mJ), average %.1f mW\n",
+           dvfs->busy_ticks, dvfs->idle_ticks, dvfs->energy_uj / 1000.0,
+           dvfs->busy_energy_uj / 1000.0,
+           total ? dvfs->energy_uj / (double)total : 0.0);
+}
@@ -0,0 +1,145 @@
+/*
+ * dvfs.h - Dynamic Voltage and Frequency Scaling
+ *
+ * Simulated core-frequency model with discrete operating points and a
+ * CMOS power model. Work (wcet, remaining_work) is counted in cycles at
+ * the maximum frequency, one per tick at full speed; at a lower speed a
+ * tick retires only a fraction of a cycle. Governors follow Pillai &
+ * Shin (SOSP 2001): static slowdown chosen from a schedulability test,
+ * and cycle-conserving EDF/RM, which reclaim the slack left by jobs
+ * that finish under their WCET.
+ *
+ * DVFS changes how long jobs take in ticks, so exec_time-based budgets
+ * (mixed criticality, elastic WCET monitoring) are not meaningful on a
+ * DVFS-enabled core.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef DVFS_H
+#define DVFS_H
+
+#include "scheduler.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define DVFS_MAX_OPPS       8
+#define DVFS_MAX_DEMANDS    16
+#define DVFS_PATTERN_MAX    8
+#define DVFS_SPEED_SCALE    1000    /* Speeds are in per mille of f_max */
+
+/* ── Operating points and policies ────────────────────────────────── */
+typedef struct {
+    uint32_t  freq_mhz;
+    uint32_t  voltage_mv;
+} DvfsOpp;
+
+/* How jobs are dispatched on the core */
+typedef enum {
+    DVFS_DISPATCH_RM,       /* Task priorities as configured (RM)     */
+    DVFS_DISPATCH_EDF       /* Priorities re-ranked by deadline       */
+} DvfsDispatch;
+
+/* How the operating point is chosen */
+typedef enum {
+    DVFS_GOV_MAX,           /* Always the highest operating point     */
+    DVFS_GOV_STATIC,        /* Lowest point passing the offline test  */
+    DVFS_GOV_CC             /* Cycle-conserving slack reclamation     */
+} DvfsGovernor;
+
+/* Scripted actual demand of a task's jobs (cycles, repeating) */
+typedef struct {
+    TaskControlBlock *task;
+    uint64_t          cycles[DVFS_PATTERN_MAX];
+    int               count;
+} DvfsDemand;
+
+/* ── Per-core state ───────────────────────────────────────────────── */
+struct DvfsState {
+    DvfsDispatch  dispatch;
+    DvfsGovernor  governor;
+
+    DvfsOpp       opp[DVFS_MAX_OPPS];     /* Ascending frequency       */
+    int           opp_count;
+    int           current;                /* Index into opp[]          */
+    int           static_opp;             /* Offline slowdown point    */
+
+    /* Power model: P = static + Ceff * V^2 * f  (nF * V^2 * MHz = mW) */
+    double        static_mw;
+    double        ceff_nf;
+    double        idle_mw;                /* Core idle (clock-gated)   */
+
+    DvfsDemand    demand[DVFS_MAX_DEMANDS];
+    int           demand_count;
+
+    /* Statistics (one tick = 1 ms, so mW * ticks = uJ) */
+    double        energy_uj;
+    double        busy_energy_uj;
+    uint64_t      busy_ticks;
+    uint64_t      idle_ticks;
+    uint64_t      opp_ticks[DVFS_MAX_OPPS];
+    uint32_t      switches;
+};
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+/**
+ * Enable DVFS on a core with a default five-point table (200-1000 MHz).
+ * Call after the task set is created: the static operating point is
+ * chosen here. With DVFS_DISPATCH_RM the core should use
+ * SCHED_RATE_MONOTONIC (or equivalent fixed priorities).
+ */
+void dvfs_enable(Scheduler *sched, DvfsDispatch dispatch,
+                 DvfsGovernor governor);
+
+/** Disable and free the DVFS state. */
+void dvfs_disable(Scheduler *sched);
+
+/** Replace the operating-point table (ascending frequency). */
+bool dvfs_set_opps(Scheduler *sched, const DvfsOpp *opps, int count);
+
+/**
+ * Give a task a repeating actual demand: job n needs cycles[n % count]
+ * cycles instead of its WCET. Governors still plan with the WCET.
+ */
+bool dvfs_set_demand(Scheduler *sched, TaskControlBlock *task,
+                     const uint64_t *cycles, int count);
+
+/* ── Analysis ─────────────────────────────────────────────────────── */
+
+/** Speed of an operating point in per mille of the maximum frequency. */
+uint32_t dvfs_speed(const DvfsState *dvfs, int opp);
+
+/** Power drawn while executing at an operating point (mW). */
+double dvfs_power_mw(const DvfsState *dvfs, int opp);
+
+/**
+ * Lowest operating point at which the periodic task set passes the
+ * dispatcher's test (EDF density or RM response-time analysis), with
+ * job lengths rounded up to whole ticks. Returns -1 if none does.
+ */
+int dvfs_static_opp(const Scheduler *sched);
+
+/* ── Runtime hooks ────────────────────────────────────────────────── */
+
+/**
+ * Called by check_periodic_releases() for a released job: applies the
+ * scripted demand, re-ranks EDF priorities and re-runs the governor.
+ */
+void dvfs_job_released(Scheduler *sched, TaskControlBlock *task);
+
+/**
+ * Retire one tick of work for the running task at the current speed.
+ * Called by tick_handler instead of decrementing remaining_work.
+ */
+void dvfs_execute(Scheduler *sched, TaskControlBlock *curr);
+
+/** Per-tick energy and residency accounting. */
+void dvfs_tick(Scheduler *sched, TaskControlBlock *curr, bool busy);
+
+/** Print per-task outcomes, operating-point residency and energy. */
+void dvfs_print_report(const Scheduler *sched);
+
+#endif /* DVFS_H */
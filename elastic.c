@@ -0,0 +1,309 @@
+/*
+ * elastic.c - Elastic Task Model (Buttazzo et al.)
+ *
+ * Compression (Buttazzo, Lipari, Abeni, RTSS 1998): with U0_i the
+ * nominal utilization C_i/Tmin_i and U_d the target,
+ *
+ *   U_i = U0_i - (U0_v - (U_d - U_f)) * E_i / E_v
+ *
+ * where U0_v and E_v sum over tasks still free to stretch and U_f over
+ * rigid tasks, tasks clamped at their maximum period and the periodic
+ * tasks on the core that were never registered as elastic. A task whose
+ * U_i falls below C_i/Tmax_i is clamped and the pass repeats. The sums
+ * are maintained incrementally, so a rescale is one pass over the
+ * elastic tasks unless clamping occurs.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "elastic.h"
+#include "timeline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <inttypes.h>
+#include <time.h>
+
+/* ── Helpers ──────────────────────────────────────────────────────── */
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static bool is_elastic(const Scheduler *sched, const TaskControlBlock *t)
+{
+    return t && t != sched->idle_task && t->period_max > 0;
+}
+
+static double nominal_u(const TaskControlBlock *t)
+{
+    return (double)t->elastic_wcet / (double)t->period_min;
+}
+
+/* Load of the periodic tasks on the core that are not elastic: it
+   counts against the target like a rigid task's */
+static double other_periodic_u(const Scheduler *sched)
+{
+    double u = 0.0;
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *t = sched->all_tasks[i];
+        if (!t || t == sched->idle_task || t->period == 0 ||
+            t->state == TASK_TERMINATED || is_elastic(sched, t)) {
+            continue;
+        }
+        u += (double)t->wcet / (double)t->period;
+    }
+    return u;
+}
+
+/* Add (sign = +1) or remove (sign = -1) a task's share of the sums */
+static void sums_update(ElasticState *es, const TaskControlBlock *t,
+                        double sign)
+{
+    if (t->elastic_coeff > 0.0) {
+        es->sum_u0_elastic += sign * nominal_u(t);
+        es->sum_e          += sign * t->elastic_coeff;
+    } else {
+        es->sum_u_rigid    += sign * nominal_u(t);
+    }
+}
+
+/* Change a task's period in place, keeping its release grid */
+static bool apply_period(Scheduler *sched, TaskControlBlock *t,
+                         uint64_t period)
+{
+    uint64_t old = t->period;
+    if (period == old) return false;
+
+    if (t->relative_deadline == old) t->relative_deadline = period;
+    if (t->next_release != UINT64_MAX) {
+        t->next_release = t->next_release - old + period;
+    }
+    t->period = period;
+
+    if (sched->timeline) {
+        char buf[ANNOTATION_MAX];
+        snprintf(buf, sizeof(buf),
+                 "ELASTIC: %s period %" PRIu64 " -> %" PRIu64,
+                 t->name, old, period);
+        timeline_record(sched->timeline, sched->system_ticks, t,
+                        VIS_NONE, buf);
+    }
+    return true;
+}
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+void elastic_enable(Scheduler *sched, double target)
+{
+    if (!sched) return;
+
+    if (!sched->elastic) {
+        sched->elastic = calloc(1, sizeof(ElasticState));
+        if (!sched->elastic) {
+            fprintf(stderr, "elastic_enable: out of memory\n");
+            return;
+        }
+        sched->elastic->feasible = true;
+    }
+    sched->elastic->target = target;
+}
+
+void elastic_disable(Scheduler *sched)
+{
+    if (!sched) return;
+    free(sched->elastic);
+    sched->elastic = NULL;
+}
+
+bool elastic_add_task(TaskControlBlock *task, uint64_t period_min,
+                      uint64_t period_max, double coeff)
+{
+    Scheduler    *sched = task ? task->scheduler : NULL;
+    ElasticState *es    = sched ? sched->elastic : NULL;
+    if (!es) return false;
+
+    if (task->period == 0 || period_min == 0 || period_max < period_min ||
+        coeff < 0.0) {
+        fprintf(stderr, "elastic_add_task: invalid range for %s\n",
+                task->name);
+        return false;
+    }
+    if (is_elastic(sched, task)) elastic_remove_task(task);
+
+    task->period_min    = period_min;
+    task->period_max    = period_max;
+    task->elastic_coeff = coeff;
+    task->elastic_wcet  = task->wcet;
+    sums_update(es, task, +1.0);
+    es->task_count++;
+
+    return elastic_rescale(sched);
+}
+
+void elastic_remove_task(TaskControlBlock *task)
+{
+    Scheduler    *sched = task ? task->scheduler : NULL;
+    ElasticState *es    = sched ? sched->elastic : NULL;
+    if (!es || !is_elastic(sched, task)) return;
+
+    sums_update(es, task, -1.0);
+    task->period_max = 0;
+    if (--es->task_count == 0) {
+        /* Drop accumulated rounding error */
+        es->sum_u0_elastic = es->sum_e = es->sum_u_rigid = 0.0;
+    }
+
+    elastic_rescale(sched);
+}
+
+bool elastic_set_target(Scheduler *sched, double target)
+{
+    if (!sched || !sched->elastic) return false;
+    sched->elastic->target = target;
+    return elastic_rescale(sched);
+}
+
+/* ── Compression ──────────────────────────────────────────────────── */
+
+bool elastic_rescale(Scheduler *sched)
+{
+    ElasticState *es = sched ? sched->elastic : NULL;
+    if (!es) return false;
+
+    uint64_t t0 = now_ns();
+
+    bool   clamped[MAX_ALL_TASKS] = { false };
+    double u[MAX_ALL_TASKS]       = { 0.0 };
+    double u_other = other_periodic_u(sched);
+    double u_fixed = es->sum_u_rigid + u_other;
+    double u0_var  = es->sum_u0_elastic;
+    double e_var   = es->sum_e;
+
+    for (;;) {
+        double excess = u0_var + u_fixed - es->target;
+        bool   again  = false;
+
+        for (int i = 0; i < sched->task_count; i++) {
+            TaskControlBlock *t = sched->all_tasks[i];
+            if (!is_elastic(sched, t)) continue;
+
+            double u0   = nominal_u(t);
+            double umin = (double)t->elastic_wcet / (double)t->period_max;
+
+            if (t->elastic_coeff <= 0.0) { u[i] = u0;   continue; }
+            if (clamped[i])              { u[i] = umin; continue; }
+
+            double ui = (excess > 0.0 && e_var > 0.0)
+                      ? u0 - excess * t->elastic_coeff / e_var
+                      : u0;
+            if (ui < umin) {
+                /* Fully stretched: fixed from now on */
+                clamped[i] = true;
+                u_fixed   += umin;
+                u0_var    -= u0;
+                e_var     -= t->elastic_coeff;
+                again      = true;
+            }
+            u[i] = ui;
+        }
+        if (!again) break;
+    }
+
+    double total = u_other;
+    bool   compressed = false;
+    bool   changed = false;
+    for (int i = 0; i < sched->task_count; i++) {
+        TaskControlBlock *t = sched->all_tasks[i];
+        if (!is_elastic(sched, t)) continue;
+
+        uint64_t period;
+        if (clamped[i])                 period = t->period_max;
+        else if (t->elastic_wcet == 0)  period = t->period_min;
+        else period = (uint64_t)ceil((double)t->elastic_wcet / u[i] - 1e-9);
+        if (period < t->period_min) period = t->period_min;
+        if (period > t->period_max) period = t->period_max;
+
+        changed |= apply_period(sched, t, period);
+        total += (double)t->elastic_wcet / (double)period;
+        if (period > t->period_min) compressed = true;
+    }
+
+    /* Rate-monotonic priorities follow the new periods */
+    if (changed && sched->policy == SCHED_RATE_MONOTONIC) {
+        rms_recalculate_priorities(sched);
+    }
+
+    es->utilization       = total;
+    es->feasible          = (total <= es->target + 1e-9);
+    es->last_rescale_tick = sched->system_ticks;
+    es->rescales++;
+    if (compressed) es->compressions++;
+
+    uint64_t dt = now_ns() - t0;
+    es->rescale_ns_total += dt;
+    if (dt > es->rescale_ns_max) es->rescale_ns_max = dt;
+
+    if (!es->feasible) {
+        fprintf(stderr, "elastic: U=%.3f exceeds target %.3f even at "
+                "maximum periods\n", total, es->target);
+    }
+    return es->feasible;
+}
+
+/* ── Runtime monitoring ───────────────────────────────────────────── */
+
+void elastic_tick(Scheduler *sched, TaskControlBlock *curr)
+{
+    ElasticState *es = sched ? sched->elastic : NULL;
+    if (!es || !is_elastic(sched, curr) || curr->state != TASK_RUNNING) {
+        return;
+    }
+
+    if (curr->exec_time > curr->elastic_wcet) {
+        sums_update(es, curr, -1.0);
+        curr->elastic_wcet = curr->exec_time;
+        sums_update(es, curr, +1.0);
+        es->wcet_updates++;
+        elastic_rescale(sched);
+    }
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+void elastic_print_report(const Scheduler *sched)
+{
+    const ElasticState *es = sched ? sched->elastic : NULL;
+    if (!es) return;
+
+    printf("\n  %-10s %5s %6s %6s %6s %5s %7s %7s\n",
+           "Task", "E", "Tmin", "Tmax", "T", "C", "U", "Misses");
+    printf("  %-10s %5s %6s %6s %6s %5s %7s %7s\n",
+           "----", "-", "----", "----", "-", "-", "-", "------");
+
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *t = sched->all_tasks[i];
+        if (!is_elastic(sched, t)) continue;
+        printf("  %-10s %5.2f %6" PRIu64 " %6" PRIu64 " %6" PRIu64
+               " %5" PRIu64 " %7.3f %7u\n",
+               t->name, t->elastic_coeff, t->period_min, t->period_max,
+               t->period, t->elastic_wcet,
+               (double)t->elastic_wcet / (double)t->period,
+               t->deadline_misses);
+    }
+
+    printf("\n  Target U %.3f, current U %.3f (%s)\n", es->target,
+           es->utilization, es->feasible ? "fits" : "OVERLOAD");
+    printf("  Rescales %u (%u compressed), WCET estimate updates %u\n",
+           es->rescales, es->compressions, es->wcet_updates);
+    printf("  Rescale time: avg %.0f ns, max %" PRIu64 " ns\n",
+           es->rescales ? (double)es->rescale_ns_total / es->rescales : 0.0,
+           es->rescale_ns_max);
+}
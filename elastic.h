@@ -0,0 +1,84 @@
+/*
+ * elastic.h - Elastic Task Model (Buttazzo et al.)
+ *
+ * Periodic tasks are springs: each has a nominal (minimum) period, a
+ * maximum period and an elastic coefficient. When the total load would
+ * exceed the target utilization, periods are stretched in proportion
+ * to the coefficients so the set fits; when load drops they relax back
+ * toward nominal. Periods and deadlines are updated in place.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef ELASTIC_H
+#define ELASTIC_H
+
+#include "scheduler.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ── Per-core elastic state ───────────────────────────────────────── */
+struct ElasticState {
+    double    target;          /* Desired total utilization (U_d)     */
+
+    /* Running sums, updated incrementally as tasks join, leave or
+       change their WCET estimate */
+    double    sum_u0_elastic;  /* Nominal U of tasks with E > 0       */
+    double    sum_e;           /* Sum of elastic coefficients          */
+    double    sum_u_rigid;     /* U of tasks with E = 0                */
+    int       task_count;
+
+    bool      feasible;        /* Last rescale met the target          */
+    double    utilization;     /* Core U after the last rescale        */
+
+    /* Statistics */
+    uint32_t  rescales;
+    uint32_t  compressions;    /* Rescales that stretched some period  */
+    uint32_t  wcet_updates;    /* Runtime monitor raised an estimate   */
+    uint64_t  last_rescale_tick;
+    uint64_t  rescale_ns_total;
+    uint64_t  rescale_ns_max;
+};
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+/** Enable elastic scheduling with target utilization `target`. */
+void elastic_enable(Scheduler *sched, double target);
+
+/** Disable and free the elastic state (periods stay as they are). */
+void elastic_disable(Scheduler *sched);
+
+/**
+ * Admit a periodic task as elastic: its period may range over
+ * [period_min, period_max] and `coeff` (>= 0, 0 = rigid) weights how
+ * much it stretches. The WCET estimate starts at task->wcet. The set
+ * is rescaled immediately; returns false if it cannot meet the target
+ * even with every period at its maximum.
+ */
+bool elastic_add_task(TaskControlBlock *task, uint64_t period_min,
+                      uint64_t period_max, double coeff);
+
+/** Remove a task from the elastic set (the others may expand). */
+void elastic_remove_task(TaskControlBlock *task);
+
+/** Change the target utilization and rescale. */
+bool elastic_set_target(Scheduler *sched, double target);
+
+/**
+ * Recompute all elastic periods from the running sums and apply them
+ * in place. Returns true if the target utilization is met.
+ */
+bool elastic_rescale(Scheduler *sched);
+
+/**
+ * Runtime load monitor, called by tick_handler for the tick just
+ * executed: a job running past its task's WCET estimate raises the
+ * estimate and triggers a rescale within the same tick.
+ */
+void elastic_tick(Scheduler *sched, TaskControlBlock *curr);
+
+/** Print per-task period ranges, current periods and the load summary. */
+void elastic_print_report(const Scheduler *sched);
+
+#endif /* ELASTIC_H */
@@ -0,0 +1,368 @@
+/*
+ * evstream.c - Streaming Event Input Implementation
+ *
+ * Lines are cut in place: the newline after a complete line is replaced
+ * by a terminator and the line parsed where it lies. When no complete
+ * line is left, the unread tail moves to the front of the buffer and
+ * the rest is refilled from the input. Names are resolved when a line
+ * is parsed; since the next line is read only after the previous
+ * command has been applied, objects created earlier in the stream are
+ * already known.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "evstream.h"
+#include "isr.h"
+
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <inttypes.h>
+
+#define EVSTREAM_ERRORS_SHOWN   8   /* Reported lines per stream       */
+
+/* ── Helpers ──────────────────────────────────────────────────────── */
+
+static void line_error(EventStream *s, const char *what, const char *arg)
+{
+    if (s->errors++ < EVSTREAM_ERRORS_SHOWN) {
+        fprintf(stderr, "evstream: line %" PRIu64 ": %s%s%s\n", s->lines,
+                what, arg ? " " : "", arg ? arg : "");
+    } else if (s->errors == EVSTREAM_ERRORS_SHOWN + 1) {
+        fprintf(stderr, "evstream: further errors not shown\n");
+    }
+}
+
+/* Next complete line, terminated in place; false at end of input */
+static bool next_line(EventStream *s, char **line)
+{
+    for (;;) {
+        char *p  = s->buf + s->start;
+        char *nl = memchr(p, '\n', s->end - s->start);
+        if (nl) {
+            *nl = '\0';
+            s->start = (size_t)(nl - s->buf) + 1;
+            s->lines++;
+            if (s->skipping) {
+                s->skipping = false;        /* Tail of an over-long line */
+                continue;
+            }
+            *line = p;
+            return true;
+        }
+        if (s->eof) {
+            if (s->start == s->end) return false;
+            s->buf[s->end] = '\0';          /* Last line, no newline */
+            s->start = s->end;
+            s->lines++;
+            if (s->skipping) return false;
+            *line = p;
+            return true;
+        }
+
+        /* Keep the partial line, then refill behind it */
+        memmove(s->buf, p, s->end - s->start);
+        s->end  -= s->start;
+        s->start = 0;
+        if (s->end == EVSTREAM_BUF_SIZE) {
+            s->lines++;
+            line_error(s, "line too long, skipped", NULL);
+            s->lines--;                     /* Counted at its newline */
+            s->skipping = true;
+            s->end = 0;
+        }
+        size_t n = fread(s->buf + s->end, 1, EVSTREAM_BUF_SIZE - s->end,
+                         s->in);
+        s->bytes += n;
+        s->end   += n;
+        if (n == 0) s->eof = true;
+    }
+}
+
+static bool at_end(const char *p)
+{
+    while (isspace((unsigned char)*p)) p++;
+    return *p == '\0';
+}
+
+static TaskControlBlock *find_task(const Scheduler *sched, const char *name)
+{
+    for (int i = 0; i < sched->task_count; i++) {
+        TaskControlBlock *t = sched->all_tasks[i];
+        if (t && strcmp(t->name, name) == 0) return t;
+    }
+    return NULL;
+}
+
+static IsrSource *find_irq(const Scheduler *sched, const char *name)
+{
+    for (int i = 0; sched->isr && i < sched->isr->count; i++) {
+        if (!sched->isr->src[i].removed &&
+            strcmp(sched->isr->src[i].name, name) == 0) {
+            return &sched->isr->src[i];
+        }
+    }
+    return NULL;
+}
+
+static bool parse_param(const char *word, InjectParam *param)
+{
+    static const char *const names[] = {
+        [INJECT_PRIORITY] = "priority", [INJECT_PERIOD]   = "period",
+        [INJECT_WCET]     = "wcet",     [INJECT_DEADLINE] = "deadline",
+    };
+    for (int i = 0; i < 4; i++) {
+        if (strcmp(word, names[i]) == 0) {
+            *param = (InjectParam)i;
+            return true;
+        }
+    }
+    return false;
+}
+
+/* Parse one non-blank line into `cmd`; false (reported) if malformed */
+static bool parse_line(EventStream *s, const char *line, EvCommand *cmd)
+{
+    Scheduler *sched = s->scheduler;
+    char verb[16], name[TASK_NAME_MAX], word[16];
+    uint64_t tick, a = 0, b = 0, c = 0, d = 0;
+    int used = 0, n;
+
+    if (sscanf(line, "%" SCNu64 " %15s %31s%n", &tick, verb, name,
+               &used) != 3) {
+        line_error(s, "expected <tick> <command> <name>", NULL);
+        return false;
+    }
+    if (tick < s->last_tick) {
+        line_error(s, "tick goes backwards:", line);
+        return false;
+    }
+    const char *rest = line + used;
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->tick = tick;
+    cmd->kind = EVCMD_EVENT;
+
+    if (strcmp(verb, "task") == 0) {
+        used = 0;
+        n = sscanf(rest, "%" SCNu64 " %" SCNu64 " %" SCNu64 "%n",
+                   &a, &b, &c, &used);
+        rest += used;
+        if (n == 3 && sscanf(rest, "%" SCNu64 "%n", &d, &used) == 1) {
+            rest += used;
+        }
+        if (n != 3 || !at_end(rest) || a >= PRIORITY_IDLE || c == 0) {
+            line_error(s, "expected task <name> <priority> <period> "
+                       "<wcet> [<deadline>]", NULL);
+            return false;
+        }
+        if (find_task(sched, name)) {
+            line_error(s, "task already exists:", name);
+            return false;
+        }
+        cmd->kind     = EVCMD_TASK;
+        cmd->priority = (int)a;
+        cmd->period   = b;
+        cmd->wcet     = c;
+        cmd->deadline = d;
+        snprintf(cmd->name, TASK_NAME_MAX, "%s", name);
+    } else if (strcmp(verb, "sem") == 0) {
+        n = sscanf(rest, "%" SCNu64 " %" SCNu64 "%n", &a, &b, &used);
+        if (n != 2 || !at_end(rest + used) || b == 0 || a > b ||
+            b > INT32_MAX) {
+            line_error(s, "expected sem <name> <initial> <max>", NULL);
+            return false;
+        }
+        if (evstream_semaphore(s, name) ||
+            s->sem_count >= EVSTREAM_MAX_SEMS) {
+            line_error(s, "semaphore exists or too many:", name);
+            return false;
+        }
+        cmd->kind      = EVCMD_SEM;
+        cmd->initial   = (int)a;
+        cmd->max_count = (int)b;
+        snprintf(cmd->name, TASK_NAME_MAX, "%s", name);
+    } else if (strcmp(verb, "release") == 0 || strcmp(verb, "set") == 0) {
+        TaskControlBlock *t = find_task(sched, name);
+        if (!t) {
+            line_error(s, "unknown task", name);
+            return false;
+        }
+        cmd->event.task = t;
+        if (verb[0] == 'r') {
+            cmd->event.kind = INJECT_RELEASE;
+            if (!at_end(rest)) {
+                line_error(s, "expected release <task>", NULL);
+                return false;
+            }
+        } else {
+            cmd->event.kind = INJECT_PARAM;
+            n = sscanf(rest, " %15s %" SCNu64 "%n", word, &a, &used);
+            if (n != 2 || !at_end(rest + used) ||
+                !parse_param(word, &cmd->event.param)) {
+                line_error(s, "expected set <task> priority|period|wcet|"
+                           "deadline <value>", NULL);
+                return false;
+            }
+            cmd->event.value = a;
+        }
+    } else if (strcmp(verb, "signal") == 0) {
+        cmd->event.kind = INJECT_SIGNAL;
+        cmd->event.sem  = evstream_semaphore(s, name);
+        if (!cmd->event.sem || !at_end(rest)) {
+            line_error(s, "unknown semaphore", name);
+            return false;
+        }
+    } else if (strcmp(verb, "irq") == 0) {
+        cmd->event.kind = INJECT_IRQ;
+        cmd->event.irq  = find_irq(sched, name);
+        if (!cmd->event.irq || !at_end(rest)) {
+            line_error(s, "unknown interrupt source", name);
+            return false;
+        }
+    } else {
+        line_error(s, "unknown command", verb);
+        return false;
+    }
+
+    s->last_tick = tick;
+    return true;
+}
+
+/* Read up to the next valid command; false at end of input */
+static bool read_command(EventStream *s)
+{
+    char *line;
+    while (next_line(s, &line)) {
+        if (at_end(line) || line[strspn(line, " \t")] == '#') continue;
+        if (parse_line(s, line, &s->next)) {
+            s->has_next = true;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void apply_command(EventStream *s, const EvCommand *cmd)
+{
+    Scheduler *sched = s->scheduler;
+
+    switch (cmd->kind) {
+    case EVCMD_EVENT:
+        if (inject_apply(sched, &cmd->event)) s->applied++;
+        else                                  s->ignored++;
+        return;
+    case EVCMD_TASK:
+        if (!task_create(sched, cmd->name, NULL, NULL, cmd->priority,
+                         cmd->period, cmd->deadline, cmd->wcet)) {
+            s->errors++;
+            return;
+        }
+        s->tasks_created++;
+        break;
+    case EVCMD_SEM: {
+        Semaphore *sem = semaphore_create(sched, cmd->name, cmd->initial,
+                                          cmd->max_count);
+        if (!sem) {
+            s->errors++;
+            return;
+        }
+        s->sem_owned[s->sem_count] = true;
+        s->sem[s->sem_count++]     = sem;
+        break;
+    }
+    }
+    s->applied++;
+}
+
+/* ── Public API ───────────────────────────────────────────────────── */
+
+EventStream *evstream_open(Scheduler *sched, FILE *in)
+{
+    if (!sched || !in) return NULL;
+    if (sched->stream) {
+        fprintf(stderr, "evstream_open: scheduler already has a stream\n");
+        return NULL;
+    }
+
+    EventStream *s = calloc(1, sizeof(EventStream));
+    if (!s) {
+        fprintf(stderr, "evstream_open: out of memory\n");
+        return NULL;
+    }
+    s->scheduler  = sched;
+    s->in         = in;
+    sched->stream = s;
+    return s;
+}
+
+void evstream_close(EventStream *stream)
+{
+    if (!stream) return;
+    for (int i = 0; i < stream->sem_count; i++) {
+        if (stream->sem_owned[i]) semaphore_destroy(stream->sem[i]);
+    }
+    if (stream->scheduler->stream == stream) {
+        stream->scheduler->stream = NULL;
+    }
+    free(stream);
+}
+
+bool evstream_bind_semaphore(EventStream *stream, Semaphore *sem)
+{
+    if (!stream || !sem) return false;
+    if (evstream_semaphore(stream, sem->name) ||
+        stream->sem_count >= EVSTREAM_MAX_SEMS) {
+        fprintf(stderr, "evstream_bind_semaphore: %s exists or too many\n",
+                sem->name);
+        return false;
+    }
+    stream->sem_owned[stream->sem_count] = false;
+    stream->sem[stream->sem_count++]     = sem;
+    return true;
+}
+
+Semaphore *evstream_semaphore(const EventStream *stream, const char *name)
+{
+    for (int i = 0; stream && i < stream->sem_count; i++) {
+        if (strcmp(stream->sem[i]->name, name) == 0) return stream->sem[i];
+    }
+    return NULL;
+}
+
+bool evstream_done(const EventStream *stream)
+{
+    return !stream || (stream->eof && !stream->has_next &&
+                       stream->start == stream->end);
+}
+
+/* ── Hooks ────────────────────────────────────────────────────────── */
+
+void evstream_tick(Scheduler *sched)
+{
+    EventStream *s = sched ? sched->stream : NULL;
+    if (!s) return;
+
+    while (s->has_next || read_command(s)) {
+        if (s->next.tick > sched->system_ticks) return;     /* Not due */
+        s->has_next = false;
+        apply_command(s, &s->next);
+    }
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+void evstream_print_report(const EventStream *stream)
+{
+    if (!stream) return;
+
+    printf("\n  Stream: %" PRIu64 " bytes, %" PRIu64 " lines; %" PRIu64
+           " commands applied (%u tasks created), %" PRIu64 " without "
+           "effect, %" PRIu64 " lines rejected\n", stream->bytes,
+           stream->lines, stream->applied, stream->tasks_created,
+           stream->ignored, stream->errors);
+    printf("  Reader footprint: %zu bytes (%d-byte line buffer)%s\n",
+           sizeof(EventStream), EVSTREAM_BUF_SIZE,
+           evstream_done(stream) ? ", input exhausted" : "");
+}
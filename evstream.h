@@ -0,0 +1,130 @@
+/*
+ * evstream.h - Streaming Event Input
+ *
+ * Drives a simulation from a text stream (a file, or stdin fed by a
+ * pipe) instead of creating everything up front. Each line is one
+ * timestamped command:
+ *
+ *   <tick> task <name> <priority> <period> <wcet> [<deadline>]
+ *   <tick> sem <name> <initial> <max>
+ *   <tick> release <task>
+ *   <tick> signal <semaphore>
+ *   <tick> irq <interrupt source>
+ *   <tick> set <task> priority|period|wcet|deadline <value>
+ *
+ * Blank lines and lines starting with '#' are skipped. Ticks must not
+ * decrease. A command is applied at the first tick boundary at which
+ * system_ticks >= <tick>; events go through inject_apply(), so they
+ * behave exactly like injected ones.
+ *
+ * The reader parses incrementally out of a fixed buffer and holds at
+ * most one command that is not yet due, so memory stays constant
+ * however long the input is. A malformed, out-of-order or over-long
+ * line is reported with its line number and skipped.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef EVSTREAM_H
+#define EVSTREAM_H
+
+#include "scheduler.h"
+#include "semaphore.h"
+#include "inject.h"
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define EVSTREAM_BUF_SIZE   4096    /* Longest line, and read chunk    */
+#define EVSTREAM_MAX_SEMS   16      /* Named semaphores                */
+
+typedef enum {
+    EVCMD_EVENT,            /* Release, signal, interrupt, parameter   */
+    EVCMD_TASK,             /* Create a task                           */
+    EVCMD_SEM               /* Create a semaphore                      */
+} EvCommandKind;
+
+/* ── Parsed command ───────────────────────────────────────────────── */
+typedef struct {
+    EvCommandKind     kind;
+    uint64_t          tick;
+    InjectEvent       event;        /* EVCMD_EVENT                     */
+
+    /* EVCMD_TASK / EVCMD_SEM */
+    char              name[TASK_NAME_MAX];
+    int               priority;
+    uint64_t          period;
+    uint64_t          wcet;
+    uint64_t          deadline;
+    int               initial;
+    int               max_count;
+} EvCommand;
+
+/* ── Stream ───────────────────────────────────────────────────────── */
+typedef struct EventStream {
+    Scheduler        *scheduler;
+    FILE             *in;
+
+    /* Input buffer: unread bytes are buf[start, end) */
+    char              buf[EVSTREAM_BUF_SIZE + 1];
+    size_t            start;
+    size_t            end;
+    bool              eof;
+    bool              skipping;     /* Discarding an over-long line    */
+
+    EvCommand         next;         /* Parsed, not yet due             */
+    bool              has_next;
+    uint64_t          last_tick;
+
+    Semaphore        *sem[EVSTREAM_MAX_SEMS];
+    bool              sem_owned[EVSTREAM_MAX_SEMS];
+    int               sem_count;
+
+    /* Statistics */
+    uint64_t          bytes;
+    uint64_t          lines;
+    uint64_t          applied;
+    uint64_t          ignored;      /* Applied with no effect          */
+    uint64_t          errors;       /* Lines skipped                   */
+    uint32_t          tasks_created;
+} EventStream;
+
+/* ── Public API ───────────────────────────────────────────────────── */
+
+/**
+ * Attach a stream reading `in` (which the caller keeps open and
+ * closes) to the scheduler; tick_handler() then applies its commands.
+ * Commands at tick 0 are applied by the first tick, or at once by an
+ * explicit evstream_tick() before the run.
+ */
+EventStream *evstream_open(Scheduler *sched, FILE *in);
+
+/** Detach and free the stream and the semaphores it created. */
+void evstream_close(EventStream *stream);
+
+/** Make a semaphore created elsewhere known to the stream by name. */
+bool evstream_bind_semaphore(EventStream *stream, Semaphore *sem);
+
+/** Find a semaphore the stream knows by name (NULL if unknown). */
+Semaphore *evstream_semaphore(const EventStream *stream, const char *name);
+
+/** Whether the input is exhausted and every command applied. */
+bool evstream_done(const EventStream *stream);
+
+/* ── Hooks ────────────────────────────────────────────────────────── */
+
+/**
+ * Per-tick processing (called by tick_handler after injected events,
+ * once the elapsed tick is accounted): read and apply every command
+ * due by the current tick.
+ */
+void evstream_tick(Scheduler *sched);
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+/** Print bytes and lines read, commands applied and errors. */
+void evstream_print_report(const EventStream *stream);
+
+#endif /* EVSTREAM_H */
@@ -0,0 +1,246 @@
+/*
+ * inject.c - Thread-Safe External Event Injection Implementation
+ *
+ * The queue is a bounded ring of cells with per-cell turn counters.
+ * Cell i is free for position p when its turn equals p and holds the
+ * event of position p when its turn equals p + 1. A producer claims
+ * position p by advancing `tail` with a compare-and-swap, writes the
+ * event and publishes it by storing turn = p + 1 (release). The single
+ * consumer reads in position order and recycles the cell for position
+ * p + INJECT_QUEUE_CAP. A producer that has claimed a position but not
+ * yet published it stops the drain there; the rest follows next tick.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "inject.h"
+#include "rtos_time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+/* ── Helpers ──────────────────────────────────────────────────────── */
+
+static const char *kind_name(InjectKind kind)
+{
+    switch (kind) {
+    case INJECT_RELEASE: return "release";
+    case INJECT_SIGNAL:  return "signal";
+    case INJECT_IRQ:     return "irq";
+    case INJECT_PARAM:   return "param";
+    }
+    return "?";
+}
+
+static int cmp_event(const void *a, const void *b)
+{
+    const InjectEvent *x = a, *y = b;
+    if (x->source != y->source) return x->source < y->source ? -1 : 1;
+    if (x->seq != y->seq)       return x->seq < y->seq ? -1 : 1;
+    return 0;
+}
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+bool inject_enable(Scheduler *sched)
+{
+    if (!sched) return false;
+    if (sched->inject) return true;
+
+    InjectState *q = calloc(1, sizeof(InjectState));
+    if (!q) {
+        fprintf(stderr, "inject_enable: out of memory\n");
+        return false;
+    }
+    for (uint64_t i = 0; i < INJECT_QUEUE_CAP; i++) {
+        atomic_init(&q->cell[i].turn, i);
+    }
+    atomic_init(&q->tail, 0);
+    atomic_init(&q->rejected, 0);
+    sched->inject = q;
+    return true;
+}
+
+void inject_disable(Scheduler *sched)
+{
+    if (!sched) return;
+    free(sched->inject);
+    sched->inject = NULL;
+}
+
+bool inject_producer_init(InjectProducer *prod, Scheduler *sched,
+                          uint32_t source)
+{
+    if (!prod || !sched || !sched->inject) {
+        fprintf(stderr, "inject_producer_init: injection not enabled\n");
+        return false;
+    }
+    prod->queue    = sched->inject;
+    prod->source   = source;
+    prod->next_seq = 0;
+    prod->posted   = 0;
+    prod->rejected = 0;
+    return true;
+}
+
+/* ── Posting ──────────────────────────────────────────────────────── */
+
+bool inject_post(InjectProducer *prod, InjectEvent event)
+{
+    if (!prod || !prod->queue) return false;
+    InjectState *q = prod->queue;
+
+    uint64_t pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    InjectCell *cell;
+    for (;;) {
+        cell = &q->cell[pos % INJECT_QUEUE_CAP];
+        uint64_t turn = atomic_load_explicit(&cell->turn,
+                                             memory_order_acquire);
+        if (turn == pos) {
+            /* Free for this position: claim it (pos reloads on failure) */
+            if (atomic_compare_exchange_weak_explicit(
+                    &q->tail, &pos, pos + 1,
+                    memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (turn < pos) {
+            /* Still holds the event of the previous lap: full */
+            atomic_fetch_add_explicit(&q->rejected, 1,
+                                      memory_order_relaxed);
+            prod->rejected++;
+            return false;
+        } else {
+            pos = atomic_load_explicit(&q->tail, memory_order_relaxed);
+        }
+    }
+
+    event.source = prod->source;
+    event.seq    = prod->next_seq++;
+    cell->event  = event;
+    atomic_store_explicit(&cell->turn, pos + 1, memory_order_release);
+    prod->posted++;
+    return true;
+}
+
+bool inject_release(InjectProducer *prod, TaskControlBlock *task)
+{
+    if (!task) return false;
+    return inject_post(prod, (InjectEvent){ .kind = INJECT_RELEASE,
+                                            .task = task });
+}
+
+bool inject_signal(InjectProducer *prod, Semaphore *sem)
+{
+    if (!sem) return false;
+    return inject_post(prod, (InjectEvent){ .kind = INJECT_SIGNAL,
+                                            .sem = sem });
+}
+
+bool inject_irq(InjectProducer *prod, IsrSource *irq)
+{
+    if (!irq) return false;
+    return inject_post(prod, (InjectEvent){ .kind = INJECT_IRQ,
+                                            .irq = irq });
+}
+
+bool inject_param(InjectProducer *prod, TaskControlBlock *task,
+                  InjectParam param, uint64_t value)
+{
+    if (!task) return false;
+    return inject_post(prod, (InjectEvent){ .kind = INJECT_PARAM,
+                                            .task = task, .param = param,
+                                            .value = value });
+}
+
+/* ── Hooks ────────────────────────────────────────────────────────── */
+
+bool inject_apply(Scheduler *sched, const InjectEvent *ev)
+{
+    if (!sched || !ev) return false;
+    TaskControlBlock *t = ev->task;
+
+    switch (ev->kind) {
+    case INJECT_RELEASE:
+        if (!t) return false;                           /* Raw post */
+        if (t->state != TASK_SUSPENDED) return false;   /* Job pending */
+        release_job(sched, t);
+        return true;
+    case INJECT_SIGNAL:
+        if (!ev->sem) return false;
+        semaphore_signal(ev->sem, NULL);
+        return true;
+    case INJECT_IRQ:
+        if (!sched->isr || !ev->irq) return false;
+        isr_raise(sched, ev->irq);
+        return true;
+    case INJECT_PARAM:
+        if (!t) return false;
+        switch (ev->param) {
+        case INJECT_PRIORITY: task_set_priority(t, (int)ev->value); break;
+        case INJECT_PERIOD:   t->period            = ev->value;     break;
+        case INJECT_WCET:     t->wcet              = ev->value;     break;
+        case INJECT_DEADLINE: t->relative_deadline = ev->value;     break;
+        }
+        return true;
+    }
+    return false;
+}
+
+void inject_tick(Scheduler *sched)
+{
+    InjectState *q = sched ? sched->inject : NULL;
+    if (!q) return;
+
+    /* Take every published event, in position order */
+    uint32_t n = 0;
+    while (n < INJECT_QUEUE_CAP) {
+        InjectCell *cell = &q->cell[q->head % INJECT_QUEUE_CAP];
+        uint64_t turn = atomic_load_explicit(&cell->turn,
+                                             memory_order_acquire);
+        if (turn != q->head + 1) break;     /* Empty or being written */
+
+        q->batch[n++] = cell->event;
+        atomic_store_explicit(&cell->turn, q->head + INJECT_QUEUE_CAP,
+                              memory_order_release);
+        q->head++;
+    }
+    if (n == 0) return;
+
+    /* Deterministic order: producer, then its post order */
+    qsort(q->batch, n, sizeof(InjectEvent), cmp_event);
+    for (uint32_t i = 0; i < n; i++) {
+        if (inject_apply(sched, &q->batch[i])) {
+            q->applied++;
+            q->by_kind[q->batch[i].kind]++;
+        } else {
+            q->ignored++;
+        }
+    }
+
+    q->drained += n;
+    q->batches++;
+    if (n > q->batch_max) q->batch_max = n;
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+void inject_print_report(const Scheduler *sched)
+{
+    const InjectState *q = sched ? sched->inject : NULL;
+    if (!q) return;
+
+    printf("\n  Injected events: %" PRIu64 " drained in %" PRIu64
+           " ticks (largest batch %u), %" PRIu64 " applied, %" PRIu64
+           " ignored, %" PRIu64 " rejected (queue full)\n", q->drained,
+           q->batches, q->batch_max, q->applied, q->ignored,
+           (uint64_t)atomic_load_explicit(
+               &((InjectState *)q)->rejected, memory_order_relaxed));
+    printf("  ");
+    for (int k = 0; k < 4; k++) {
+        printf("%s%s %" PRIu64, k ? ", " : "", kind_name((InjectKind)k),
+               q->by_kind[k]);
+    }
+    printf("\n");
+}
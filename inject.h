@@ -0,0 +1,143 @@
+/*
+ * inject.h - Thread-Safe External Event Injection
+ *
+ * Host threads other than the one running the simulation (a CAN reader,
+ * a hardware-in-the-loop bridge) post events into a bounded lock-free
+ * multi-producer / single-consumer queue:
+ *
+ *   release a task, signal a semaphore, raise an interrupt,
+ *   change a task parameter (priority, period, WCET, deadline).
+ *
+ * Posting never blocks: a producer claims a slot with one compare-and-
+ * swap, and a full queue rejects the event. Only the simulation thread
+ * touches the Scheduler. tick_handler() drains the queue once the
+ * elapsed tick is accounted and applies the batch sorted by (source,
+ * post order), so the result of a tick depends only on which events
+ * arrived before it, not on how the producer threads interleaved.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef INJECT_H
+#define INJECT_H
+
+#include "scheduler.h"
+#include "semaphore.h"
+#include "isr.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define INJECT_QUEUE_CAP    1024    /* Power of two                    */
+
+typedef enum {
+    INJECT_RELEASE,         /* Release a job of a suspended task       */
+    INJECT_SIGNAL,          /* Signal a semaphore                      */
+    INJECT_IRQ,             /* Raise an external interrupt             */
+    INJECT_PARAM            /* Set a task parameter                    */
+} InjectKind;
+
+typedef enum {
+    INJECT_PRIORITY,
+    INJECT_PERIOD,
+    INJECT_WCET,
+    INJECT_DEADLINE
+} InjectParam;
+
+/* ── Event ────────────────────────────────────────────────────────── */
+typedef struct {
+    InjectKind        kind;
+    uint32_t          source;       /* Posting producer                */
+    uint32_t          seq;          /* Per-producer post order         */
+    TaskControlBlock *task;         /* RELEASE, PARAM                  */
+    Semaphore        *sem;          /* SIGNAL                          */
+    IsrSource        *irq;          /* IRQ                             */
+    InjectParam       param;
+    uint64_t          value;
+} InjectEvent;
+
+/* One slot; `turn` says whether it may be written or read next */
+typedef struct {
+    _Atomic uint64_t  turn;
+    InjectEvent       event;
+} InjectCell;
+
+/* ── Per-core state ───────────────────────────────────────────────── */
+struct InjectState {
+    InjectCell        cell[INJECT_QUEUE_CAP];
+    _Atomic uint64_t  tail;         /* Next position to claim          */
+    uint64_t          head;         /* Next position to drain          */
+    _Atomic uint64_t  rejected;     /* Posts refused, queue full       */
+
+    InjectEvent       batch[INJECT_QUEUE_CAP];  /* Consumer only       */
+
+    /* Statistics (consumer only) */
+    uint64_t          drained;
+    uint64_t          applied;
+    uint64_t          ignored;      /* Task busy, no target, no IRQs   */
+    uint64_t          batches;      /* Ticks that applied events       */
+    uint32_t          batch_max;
+    uint64_t          by_kind[4];
+};
+
+/* ── Producer handle (one per host thread) ────────────────────────── */
+typedef struct {
+    InjectState      *queue;
+    uint32_t          source;
+    uint32_t          next_seq;
+    uint64_t          posted;
+    uint64_t          rejected;
+} InjectProducer;
+
+/* ── Configuration (simulation thread) ────────────────────────────── */
+
+/** Create the injection queue. */
+bool inject_enable(Scheduler *sched);
+
+/** Remove the queue; no producer may still be posting. */
+void inject_disable(Scheduler *sched);
+
+/**
+ * Prepare a handle for one producer thread. `source` identifies it and
+ * orders its events against other producers' in the same tick.
+ */
+bool inject_producer_init(InjectProducer *prod, Scheduler *sched,
+                          uint32_t source);
+
+/* ── Posting (any thread, never blocks) ───────────────────────────── */
+
+/** Post an event; false if the queue is full. */
+bool inject_post(InjectProducer *prod, InjectEvent event);
+
+/* Shorthands for inject_post() */
+bool inject_release(InjectProducer *prod, TaskControlBlock *task);
+bool inject_signal(InjectProducer *prod, Semaphore *sem);
+bool inject_irq(InjectProducer *prod, IsrSource *irq);
+bool inject_param(InjectProducer *prod, TaskControlBlock *task,
+                  InjectParam param, uint64_t value);
+
+/* ── Hooks ────────────────────────────────────────────────────────── */
+
+/**
+ * Apply one event now (simulation thread only). Returns false if it
+ * had no effect: a release of a task whose job is still pending, an
+ * interrupt with the interrupt layer disabled, or an event posted with
+ * no target.
+ */
+bool inject_apply(Scheduler *sched, const InjectEvent *ev);
+
+/**
+ * Per-tick processing (called by tick_handler after the elapsed tick is
+ * charged, before delayed wake-ups and periodic releases): drain the
+ * queue and apply the events in (source, seq) order.
+ */
+void inject_tick(Scheduler *sched);
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+/** Print events drained, applied, ignored and rejected. */
+void inject_print_report(const Scheduler *sched);
+
+#endif /* INJECT_H */
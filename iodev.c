@@ -0,0 +1,297 @@
+/*
+ * iodev.c - Simulated I/O Devices with Completion Interrupts
+ *
+ * A request's service time is drawn when it is submitted, so runs are
+ * reproducible for a given submission order. An operation that ends at
+ * tick t raises the device's interrupt at t; the ISR runs from t + 1 and
+ * completes every request whose operation has finished by then, so two
+ * operations finishing while the ISR is pending share one completion.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "iodev.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <inttypes.h>
+
+/* ── Helpers ──────────────────────────────────────────────────────── */
+
+static const char *dist_name(IoServiceDist dist)
+{
+    switch (dist) {
+    case IODEV_SVC_FIXED:       return "fixed";
+    case IODEV_SVC_UNIFORM:     return "uniform";
+    case IODEV_SVC_EXPONENTIAL: return "exp";
+    }
+    return "?";
+}
+
+/* Deterministic draws (LCG, Numerical Recipes constants) */
+static uint32_t next_random(IoDevice *dev)
+{
+    dev->seed = dev->seed * 1664525u + 1013904223u;
+    return dev->seed >> 8;
+}
+
+static uint64_t draw_service(IoDevice *dev)
+{
+    uint64_t span = dev->svc_max - dev->svc_min;
+    switch (dev->dist) {
+    case IODEV_SVC_FIXED:
+        return dev->svc_min;
+    case IODEV_SVC_UNIFORM:
+        return dev->svc_min + next_random(dev) % (span + 1);
+    case IODEV_SVC_EXPONENTIAL: {
+        double u = (next_random(dev) + 1.0) / (double)(1u << 24);
+        uint64_t x = (uint64_t)llround(-(double)dev->svc_mean * log(u));
+        return dev->svc_min + (x > span ? span : x);
+    }
+    }
+    return dev->svc_min;
+}
+
+/* Start an operation on the oldest queued requests, if idle */
+static void start_operation(IoDevice *dev)
+{
+    if (dev->busy || dev->fifo_count == 0) return;
+
+    uint64_t duration = dev->overhead;
+    for (int n = 0; n < dev->batch_max && dev->fifo_count > 0; n++) {
+        IoRequest *r = &dev->req[dev->fifo[dev->fifo_head]];
+        dev->fifo_head = (dev->fifo_head + 1) % IODEV_QUEUE_MAX;
+        dev->fifo_count--;
+        r->state  = IOREQ_ACTIVE;
+        duration += r->service;
+    }
+    dev->busy       = true;
+    dev->busy_until = dev->scheduler->system_ticks + duration;
+    dev->operations++;
+}
+
+/* Completion ISR: finish the requests of every operation that ended */
+static void device_irq(Scheduler *sched, IsrSource *src, void *ctx)
+{
+    (void)src;
+    IoDevice *dev = ctx;
+    dev->interrupts++;
+
+    for (int i = 0; i < dev->depth; i++) {
+        IoRequest *r = &dev->req[i];
+        if (r->state != IOREQ_COMPLETING) continue;
+
+        r->state   = IOREQ_DONE;
+        r->done_at = sched->system_ticks;
+        uint64_t lat = r->done_at - r->submit_at;
+        dev->latency_sum += lat;
+        if (lat > dev->latency_max) dev->latency_max = lat;
+        dev->completed++;
+
+        if (r->waiting) {
+            r->waiting = false;
+            task_set_state(r->task, TASK_READY);
+        }
+    }
+}
+
+static bool valid_request(const IoDevice *dev, int req)
+{
+    return dev && req >= 0 && req < dev->depth &&
+           dev->req[req].state != IOREQ_FREE;
+}
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+IoDevice *iodev_create(Scheduler *sched, const char *name,
+                       IoServiceDist dist, uint64_t svc_min,
+                       uint64_t svc_max, int depth, int irq_level,
+                       uint32_t irq_cost)
+{
+    if (!sched || !name) return NULL;
+    if (svc_min == 0 || svc_max < svc_min || depth < 1 ||
+        depth > IODEV_QUEUE_MAX) {
+        fprintf(stderr, "iodev_create: %s needs 0 < min <= max service "
+                "and depth 1..%d\n", name, IODEV_QUEUE_MAX);
+        return NULL;
+    }
+    if (!sched->io) {
+        sched->io = calloc(1, sizeof(IoState));
+        if (!sched->io) {
+            fprintf(stderr, "iodev_create: out of memory\n");
+            return NULL;
+        }
+    }
+    if (sched->io->count >= IO_MAX_DEVICES) {
+        fprintf(stderr, "iodev_create: more than %d devices\n",
+                IO_MAX_DEVICES);
+        return NULL;
+    }
+
+    IoDevice *dev = calloc(1, sizeof(IoDevice));
+    if (!dev || !isr_enable(sched)) {
+        free(dev);
+        return NULL;
+    }
+    snprintf(dev->name, IODEV_NAME_MAX, "%s", name);
+    dev->scheduler = sched;
+    dev->dist      = dist;
+    dev->svc_min   = svc_min;
+    dev->svc_max   = svc_max;
+    dev->svc_mean  = (svc_max - svc_min) / 4 ? (svc_max - svc_min) / 4 : 1;
+    dev->seed      = 2463534242u;
+    dev->batch_max = 1;
+    dev->depth     = depth;
+
+    /* Operations end at least svc_min apart */
+    dev->irq = isr_add_external(sched, name, irq_level, irq_cost, svc_min);
+    if (!dev->irq) {
+        free(dev);
+        return NULL;
+    }
+    isr_set_callback(dev->irq, device_irq, dev);
+
+    sched->io->dev[sched->io->count++] = dev;
+    return dev;
+}
+
+void iodev_destroy(IoDevice *dev)
+{
+    if (!dev) return;
+    Scheduler *sched = dev->scheduler;
+
+    for (int i = 0; i < dev->depth; i++) {
+        if (dev->req[i].waiting) task_set_state(dev->req[i].task, TASK_READY);
+    }
+    if (dev->irq) isr_remove_source(sched, dev->irq);
+
+    IoState *io = sched->io;
+    for (int i = 0; io && i < io->count; i++) {
+        if (io->dev[i] != dev) continue;
+        io->dev[i] = io->dev[--io->count];
+        break;
+    }
+    free(dev);
+}
+
+bool iodev_set_batching(IoDevice *dev, uint64_t overhead, int batch_max)
+{
+    if (!dev || batch_max < 1) return false;
+    dev->overhead  = overhead;
+    dev->batch_max = batch_max;
+    dev->irq->period = overhead + dev->svc_min;
+    return true;
+}
+
+/* ── Requests ─────────────────────────────────────────────────────── */
+
+int iodev_submit(IoDevice *dev, TaskControlBlock *task)
+{
+    if (!dev || !task) return -1;
+
+    int slot = -1;
+    for (int i = 0; i < dev->depth; i++) {
+        if (dev->req[i].state == IOREQ_FREE) {
+            slot = i;
+            break;
+        }
+    }
+    if (slot < 0) {
+        dev->rejected++;
+        return -1;
+    }
+
+    IoRequest *r = &dev->req[slot];
+    memset(r, 0, sizeof(*r));
+    r->state     = IOREQ_QUEUED;
+    r->task      = task;
+    r->service   = draw_service(dev);
+    r->submit_at = dev->scheduler->system_ticks;
+    dev->fifo[(dev->fifo_head + dev->fifo_count) % IODEV_QUEUE_MAX] = slot;
+    dev->fifo_count++;
+    dev->submitted++;
+
+    start_operation(dev);
+    return slot;
+}
+
+bool iodev_poll(const IoDevice *dev, int req)
+{
+    return valid_request(dev, req) && dev->req[req].state == IOREQ_DONE;
+}
+
+bool iodev_wait(IoDevice *dev, int req)
+{
+    if (!valid_request(dev, req) || dev->req[req].state == IOREQ_DONE) {
+        return false;
+    }
+    IoRequest *r = &dev->req[req];
+    r->waiting = true;
+    task_set_state(r->task, TASK_BLOCKED);
+    scheduler_schedule(dev->scheduler);
+    return true;
+}
+
+uint64_t iodev_collect(IoDevice *dev, int req)
+{
+    if (!iodev_poll(dev, req)) return UINT64_MAX;
+    IoRequest *r = &dev->req[req];
+    r->state = IOREQ_FREE;
+    return r->done_at - r->submit_at;
+}
+
+/* ── Hooks ────────────────────────────────────────────────────────── */
+
+void io_tick(Scheduler *sched)
+{
+    IoState *io = sched ? sched->io : NULL;
+    if (!io) return;
+
+    for (int d = 0; d < io->count; d++) {
+        IoDevice *dev = io->dev[d];
+        if (!dev->busy) continue;
+
+        dev->busy_ticks++;
+        if (sched->system_ticks < dev->busy_until) continue;
+
+        /* Transfer done: raise the completion and take the next batch */
+        for (int i = 0; i < dev->depth; i++) {
+            if (dev->req[i].state == IOREQ_ACTIVE) {
+                dev->req[i].state = IOREQ_COMPLETING;
+            }
+        }
+        dev->busy = false;
+        isr_raise(sched, dev->irq);
+        start_operation(dev);
+    }
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+void io_print_report(const Scheduler *sched)
+{
+    const IoState *io = sched ? sched->io : NULL;
+    if (!io) return;
+
+    printf("\n  %-8s %-8s %7s %5s %5s %5s %6s %5s %5s %7s %13s\n",
+           "Device", "Service", "Range", "Depth", "Batch", "Reqs",
+           "Reject", "Ops", "IRQs", "Busy", "Latency avg/max");
+    for (int d = 0; d < io->count; d++) {
+        const IoDevice *dev = io->dev[d];
+        char range[16];
+        snprintf(range, sizeof(range), "%" PRIu64 "-%" PRIu64,
+                 dev->svc_min, dev->svc_max);
+        double busy = sched->system_ticks
+                    ? 100.0 * dev->busy_ticks / sched->system_ticks : 0.0;
+        double avg = dev->completed
+                   ? (double)dev->latency_sum / dev->completed : 0.0;
+        printf("  %-8s %-8s %7s %5d %5d %5u %6u %5u %5u %6.1f%% %6.1f /%4"
+               PRIu64 "\n", dev->name, dist_name(dev->dist), range,
+               dev->depth, dev->batch_max, dev->completed, dev->rejected,
+               dev->operations, dev->interrupts, busy, avg,
+               dev->latency_max);
+    }
+}
@@ -0,0 +1,161 @@
+/*
+ * iodev.h - Simulated I/O Devices with Completion Interrupts
+ *
+ * A device accepts up to `depth` outstanding requests from tasks and
+ * serves them one operation at a time. An operation takes up to
+ * `batch_max` queued requests in FIFO order and lasts
+ *
+ *   overhead + sum of the requests' service times
+ *
+ * with each service time drawn from the device's distribution (fixed,
+ * uniform, or shifted exponential truncated at the maximum). When an
+ * operation finishes, the device raises its completion interrupt; the
+ * ISR completes the requests and makes their blocked tasks READY. With
+ * batching, one setup and one interrupt serve several requests.
+ *
+ * A task may block on a request (iodev_wait) or poll it (iodev_poll),
+ * spinning on the CPU until it completes.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef IODEV_H
+#define IODEV_H
+
+#include "scheduler.h"
+#include "isr.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define IO_MAX_DEVICES      8
+#define IODEV_NAME_MAX      16
+#define IODEV_QUEUE_MAX     16      /* Outstanding requests per device */
+
+typedef enum {
+    IODEV_SVC_FIXED,        /* Always svc_min                          */
+    IODEV_SVC_UNIFORM,      /* Uniform in [svc_min, svc_max]           */
+    IODEV_SVC_EXPONENTIAL   /* svc_min + Exp(mean), capped at svc_max  */
+} IoServiceDist;
+
+typedef enum {
+    IOREQ_FREE,
+    IOREQ_QUEUED,           /* Waiting for the device                  */
+    IOREQ_ACTIVE,           /* In the current operation                */
+    IOREQ_COMPLETING,       /* Operation done, interrupt pending       */
+    IOREQ_DONE              /* Completed, not yet collected            */
+} IoReqState;
+
+typedef struct {
+    IoReqState        state;
+    TaskControlBlock *task;
+    bool              waiting;      /* Task blocked on it              */
+    uint64_t          service;      /* Drawn service time              */
+    uint64_t          submit_at;
+    uint64_t          done_at;
+} IoRequest;
+
+/* ── Device ───────────────────────────────────────────────────────── */
+typedef struct IoDevice {
+    char              name[IODEV_NAME_MAX];
+    Scheduler        *scheduler;
+    IsrSource        *irq;
+
+    /* Service model */
+    IoServiceDist     dist;
+    uint64_t          svc_min;
+    uint64_t          svc_max;
+    uint64_t          svc_mean;     /* Exponential part, above svc_min */
+    uint32_t          seed;
+    uint64_t          overhead;     /* Per operation                   */
+    int               batch_max;
+    int               depth;
+
+    /* Requests */
+    IoRequest         req[IODEV_QUEUE_MAX];
+    int               fifo[IODEV_QUEUE_MAX];    /* Queued, oldest first */
+    int               fifo_head;
+    int               fifo_count;
+    bool              busy;
+    uint64_t          busy_until;
+
+    /* Statistics */
+    uint32_t          submitted;
+    uint32_t          rejected;     /* Queue full                      */
+    uint32_t          completed;
+    uint32_t          operations;
+    uint32_t          interrupts;   /* Completion ISRs run             */
+    uint64_t          busy_ticks;
+    uint64_t          latency_sum;  /* Submit to completion            */
+    uint64_t          latency_max;
+} IoDevice;
+
+/* ── Per-core state ───────────────────────────────────────────────── */
+struct IoState {
+    IoDevice  *dev[IO_MAX_DEVICES];
+    int        count;
+};
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+/**
+ * Create a device with `depth` request slots whose completions raise
+ * an interrupt at `irq_level` costing `irq_cost` ticks. Enables the
+ * interrupt layer if needed.
+ */
+IoDevice *iodev_create(Scheduler *sched, const char *name,
+                       IoServiceDist dist, uint64_t svc_min,
+                       uint64_t svc_max, int depth, int irq_level,
+                       uint32_t irq_cost);
+
+/**
+ * Remove a device and unregister its completion interrupt; tasks
+ * blocked on it are made READY. Devices still present when the core is
+ * destroyed are freed by scheduler_destroy().
+ */
+void iodev_destroy(IoDevice *dev);
+
+/**
+ * Set the per-operation overhead and the most queued requests one
+ * operation may take (1 = no batching).
+ */
+bool iodev_set_batching(IoDevice *dev, uint64_t overhead, int batch_max);
+
+/* ── Requests ─────────────────────────────────────────────────────── */
+
+/**
+ * Submit an asynchronous request for `task`. Returns its handle, or -1
+ * if all `depth` slots are in use.
+ */
+int iodev_submit(IoDevice *dev, TaskControlBlock *task);
+
+/** Whether request `req` has completed. */
+bool iodev_poll(const IoDevice *dev, int req);
+
+/**
+ * Block the request's task until its completion interrupt. Returns
+ * false (without blocking) if it has already completed.
+ */
+bool iodev_wait(IoDevice *dev, int req);
+
+/**
+ * Free a completed request's slot and return its latency from submit
+ * to completion (UINT64_MAX if it has not completed).
+ */
+uint64_t iodev_collect(IoDevice *dev, int req);
+
+/* ── Hooks ────────────────────────────────────────────────────────── */
+
+/**
+ * Per-tick processing (called by tick_handler after the ISRs): finish
+ * operations due now, raising their interrupts, and start the next.
+ */
+void io_tick(Scheduler *sched);
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+/** Print each device's load, interrupts and request latency. */
+void io_print_report(const Scheduler *sched);
+
+#endif /* IODEV_H */
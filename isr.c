@@ -0,0 +1,491 @@
+/*
+ * isr.c - Interrupt Sources and Deferred Processing
+ *
+ * Tick t is simulated as the interval [t-1, t): interrupts due at t-1
+ * are raised first, then one tick of the highest-level pending ISR runs.
+ * An ISR completing at t performs its deferral at t, so its handler can
+ * be dispatched at t and the shortest possible latency equals the ISR
+ * cost.
+ *
+ * A handler "starts" at the first tick it runs with no work charged to
+ * its current job (exec_time == 0); each start serves the oldest raised
+ * interrupt of its source, whose latency is then recorded.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "isr.h"
+#include "rtos_time.h"
+#include "timeline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+/* ── Helpers ──────────────────────────────────────────────────────── */
+
+static const char *kind_name(IsrKind kind)
+{
+    switch (kind) {
+    case ISR_PERIODIC: return "periodic";
+    case ISR_SPORADIC: return "sporadic";
+    case ISR_BURSTY:   return "bursty";
+    case ISR_EXTERNAL: return "external";
+    }
+    return "?";
+}
+
+/* Deterministic jitter (LCG, Numerical Recipes constants) */
+static uint32_t next_random(IsrSource *src)
+{
+    src->seed = src->seed * 1664525u + 1013904223u;
+    return src->seed >> 8;
+}
+
+static int hist_bucket(uint64_t latency)
+{
+    int b = 0;
+    if (latency == 0) return 0;
+    while (b < ISR_HIST_BUCKETS - 2 && (latency >> b) > 1) b++;
+    return b + 1;
+}
+
+static IsrSource *add_source(Scheduler *sched, const char *name, int level,
+                             uint32_t cost, IsrKind kind, uint64_t period)
+{
+    IsrState *st = sched ? sched->isr : NULL;
+    if (!st || !name) return NULL;
+    int used = 0;
+    for (int i = 0; i < st->count; i++) used += !st->src[i].removed;
+    if (used >= ISR_MAX_SOURCES) {
+        fprintf(stderr, "isr: more than %d sources\n", ISR_MAX_SOURCES);
+        return NULL;
+    }
+    if (cost == 0 || period == 0) {
+        fprintf(stderr, "isr: %s needs a cost and a period\n", name);
+        return NULL;
+    }
+
+    /* Reuse the slot of a removed source before growing the table */
+    IsrSource *src = NULL;
+    for (int i = 0; i < st->count && !src; i++) {
+        if (st->src[i].removed) src = &st->src[i];
+    }
+    if (!src) src = &st->src[st->count++];
+    memset(src, 0, sizeof(*src));
+    snprintf(src->name, ISR_NAME_MAX, "%s", name);
+    src->kind   = kind;
+    src->level  = level;
+    src->cost   = cost;
+    src->period = period;
+    src->burst  = 1;
+    src->next_arrival = sched->system_ticks;
+    return src;
+}
+
+static void advance_arrival(IsrSource *src)
+{
+    switch (src->kind) {
+    case ISR_PERIODIC:
+        src->next_arrival += src->period;
+        break;
+    case ISR_SPORADIC:
+        src->next_arrival += src->period +
+                             next_random(src) % (src->jitter + 1);
+        break;
+    case ISR_BURSTY:
+        if (--src->burst_left > 0) {
+            src->next_arrival += src->spacing;
+        } else {
+            src->burst_start += src->period;
+            src->next_arrival = src->burst_start;
+            src->burst_left   = src->burst;
+        }
+        break;
+    case ISR_EXTERNAL:
+        break;
+    }
+}
+
+static void raise_irq(IsrSource *src, uint64_t at)
+{
+    src->raised++;
+    if (src->pending++ == 0) src->left = src->cost;
+
+    if (!src->handler) return;      /* No task latency to measure */
+    if (src->q_count == ISR_QUEUE_CAP) {
+        src->lost++;
+        return;
+    }
+    src->raise[(src->q_head + src->q_count) % ISR_QUEUE_CAP] = at;
+    src->q_count++;
+}
+
+static bool handler_pending(const TaskControlBlock *t)
+{
+    return t->state != TASK_SUSPENDED && t->state != TASK_TERMINATED &&
+           t->remaining_work > 0;
+}
+
+/* Deferral at ISR completion */
+static void isr_done(Scheduler *sched, IsrSource *src)
+{
+    src->handled++;
+    if (--src->pending > 0) src->left = src->cost;
+
+    switch (src->action) {
+    case ISR_ACTION_NOTIFY:
+        if (handler_pending(src->handler)) src->backlog++;
+        else release_job(sched, src->handler);
+        break;
+    case ISR_ACTION_SIGNAL:
+        semaphore_signal(src->sem, NULL);
+        break;
+    case ISR_ACTION_CALLBACK:
+        src->callback(sched, src, src->ctx);
+        break;
+    case ISR_ACTION_NONE:
+        break;
+    }
+}
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+bool isr_enable(Scheduler *sched)
+{
+    if (!sched) return false;
+    if (!sched->isr) {
+        sched->isr = calloc(1, sizeof(IsrState));
+        if (!sched->isr) {
+            fprintf(stderr, "isr_enable: out of memory\n");
+            return false;
+        }
+        sched->isr->in_service = -1;
+    }
+    return true;
+}
+
+void isr_disable(Scheduler *sched)
+{
+    if (!sched) return;
+    free(sched->isr);
+    sched->isr = NULL;
+}
+
+IsrSource *isr_add_periodic(Scheduler *sched, const char *name, int level,
+                            uint32_t cost, uint64_t period,
+                            uint64_t offset)
+{
+    IsrSource *src = add_source(sched, name, level, cost, ISR_PERIODIC,
+                                period);
+    if (src) src->next_arrival += offset;
+    return src;
+}
+
+IsrSource *isr_add_sporadic(Scheduler *sched, const char *name, int level,
+                            uint32_t cost, uint64_t min_gap,
+                            uint64_t jitter, uint32_t seed)
+{
+    IsrSource *src = add_source(sched, name, level, cost, ISR_SPORADIC,
+                                min_gap);
+    if (!src) return NULL;
+    src->jitter = jitter;
+    src->seed   = seed;
+    src->next_arrival += next_random(src) % (jitter + 1);
+    return src;
+}
+
+IsrSource *isr_add_bursty(Scheduler *sched, const char *name, int level,
+                          uint32_t cost, uint64_t period, uint32_t burst,
+                          uint64_t spacing)
+{
+    if (burst == 0 || (burst > 1 && (spacing == 0 ||
+                                     spacing * (burst - 1) >= period))) {
+        fprintf(stderr, "isr_add_bursty: %s bursts must fit their "
+                "period\n", name ? name : "(null)");
+        return NULL;
+    }
+    IsrSource *src = add_source(sched, name, level, cost, ISR_BURSTY,
+                                period);
+    if (!src) return NULL;
+    src->burst       = burst;
+    src->spacing     = spacing;
+    src->burst_left  = burst;
+    src->burst_start = src->next_arrival;
+    return src;
+}
+
+IsrSource *isr_add_external(Scheduler *sched, const char *name, int level,
+                            uint32_t cost, uint64_t min_gap)
+{
+    IsrSource *src = add_source(sched, name, level, cost, ISR_EXTERNAL,
+                                min_gap);
+    if (src) src->next_arrival = UINT64_MAX;
+    return src;
+}
+
+void isr_remove_source(Scheduler *sched, IsrSource *src)
+{
+    IsrState *st = sched ? sched->isr : NULL;
+    if (!st || !src || src < st->src || src >= st->src + st->count) return;
+
+    if (st->in_service == (int)(src - st->src)) st->in_service = -1;
+    memset(src, 0, sizeof(*src));
+    src->removed = true;
+    src->next_arrival = UINT64_MAX;
+}
+
+void isr_raise(Scheduler *sched, IsrSource *src)
+{
+    if (!sched || !src || src->removed) return;
+    raise_irq(src, sched->system_ticks);
+}
+
+bool isr_set_callback(IsrSource *src, IsrCallback callback, void *ctx)
+{
+    if (!src || !callback) return false;
+    src->action   = ISR_ACTION_CALLBACK;
+    src->handler  = NULL;
+    src->callback = callback;
+    src->ctx      = ctx;
+    return true;
+}
+
+bool isr_notify_task(IsrSource *src, TaskControlBlock *handler)
+{
+    if (!src || !handler) return false;
+    if (handler->period != 0) {
+        fprintf(stderr, "isr_notify_task: %s must be aperiodic\n",
+                handler->name);
+        return false;
+    }
+    src->action  = ISR_ACTION_NOTIFY;
+    src->handler = handler;
+
+    /* The handler runs only when notified */
+    handler->remaining_work = 0;
+    handler->invocations    = 0;
+    task_set_state(handler, TASK_SUSPENDED);
+    return true;
+}
+
+bool isr_signal_semaphore(IsrSource *src, Semaphore *sem,
+                          TaskControlBlock *waiter)
+{
+    if (!src || !sem || !waiter) return false;
+    src->action  = ISR_ACTION_SIGNAL;
+    src->handler = waiter;
+    src->sem     = sem;
+    return true;
+}
+
+/* ── Hooks ────────────────────────────────────────────────────────── */
+
+bool isr_tick(Scheduler *sched, TaskControlBlock *curr)
+{
+    IsrState *st = sched ? sched->isr : NULL;
+    if (!st) return false;
+    uint64_t t = sched->system_ticks - 1;     /* Tick being executed */
+
+    int run = -1;
+    for (int i = 0; i < st->count; i++) {
+        IsrSource *src = &st->src[i];
+        if (src->removed) continue;
+        while (src->next_arrival <= t) {
+            raise_irq(src, src->next_arrival);
+            advance_arrival(src);
+        }
+        /* Queued notifications once the handler is free */
+        if (src->backlog > 0 && !handler_pending(src->handler) &&
+            src->handler->state == TASK_SUSPENDED) {
+            src->backlog--;
+            release_job(sched, src->handler);
+        }
+        if (src->pending > 0 &&
+            (run < 0 || src->level < st->src[run].level)) {
+            run = i;
+        }
+    }
+
+    if (run >= 0) {
+        IsrSource *src = &st->src[run];
+        int prev = st->in_service;
+        if (prev >= 0 && prev != run && st->src[prev].pending > 0 &&
+            st->src[prev].left < st->src[prev].cost) {
+            st->nested++;
+        }
+        st->in_service = run;
+        src->isr_ticks++;
+        st->isr_ticks++;
+        if (--src->left == 0) {
+            isr_done(sched, src);
+            if (src->pending == 0) st->in_service = -1;
+        }
+        return true;
+    }
+
+    /* A handler's first tick serves its oldest raised interrupt */
+    if (curr && curr != sched->idle_task && curr->state == TASK_RUNNING &&
+        curr->exec_time == 0 && curr->remaining_work > 0) {
+        for (int i = 0; i < st->count; i++) {
+            IsrSource *src = &st->src[i];
+            if (src->handler != curr || src->q_count == 0) continue;
+
+            uint64_t lat = t - src->raise[src->q_head];
+            src->q_head = (src->q_head + 1) % ISR_QUEUE_CAP;
+            src->q_count--;
+            if (src->served == 0 || lat < src->latency_min) {
+                src->latency_min = lat;
+            }
+            if (lat > src->latency_max) src->latency_max = lat;
+            src->latency_sum += lat;
+            src->served++;
+            st->hist[hist_bucket(lat)]++;
+            break;
+        }
+    }
+    return false;
+}
+
+/* ── Analysis ─────────────────────────────────────────────────────── */
+
+uint64_t isr_arrivals(const IsrSource *src, uint64_t window)
+{
+    if (!src || window == 0) return 0;
+    switch (src->kind) {
+    case ISR_PERIODIC:
+    case ISR_SPORADIC:
+    case ISR_EXTERNAL:
+        return (window + src->period - 1) / src->period;
+    case ISR_BURSTY: {
+        /* Worst window starts with a burst */
+        uint64_t full = window / src->period;
+        uint64_t rem  = window % src->period;
+        uint64_t part = 0;
+        if (rem > 0) {
+            part = (src->spacing ? (rem + src->spacing - 1) / src->spacing
+                                 : src->burst);
+            if (part > src->burst) part = src->burst;
+        }
+        return full * src->burst + part;
+    }
+    }
+    return 0;
+}
+
+/* Source that activates `t`, if it is a bottom half */
+static const IsrSource *source_of(const IsrState *st,
+                                  const TaskControlBlock *t)
+{
+    for (int i = 0; st && i < st->count; i++) {
+        if (st->src[i].handler == t) return &st->src[i];
+    }
+    return NULL;
+}
+
+/* Demand of tasks with priority at least `prio` (except `self`) and of
+   all ISRs over a window `w` */
+static uint64_t interference(const Scheduler *sched,
+                             const TaskControlBlock *self, int prio,
+                             uint64_t w, bool include_isr)
+{
+    const IsrState *st = sched->isr;
+    uint64_t sum = 0;
+
+    for (int j = 0; j < sched->task_count; j++) {
+        const TaskControlBlock *tj = sched->all_tasks[j];
+        if (!tj || tj == self || tj == sched->idle_task ||
+            tj->state == TASK_TERMINATED || tj->priority > prio) {
+            continue;
+        }
+        if (tj->period > 0) {
+            sum += ((w + tj->period - 1) / tj->period) * tj->wcet;
+        } else {
+            const IsrSource *s = source_of(st, tj);
+            if (s) sum += isr_arrivals(s, w) * tj->wcet;
+        }
+    }
+    for (int i = 0; include_isr && st && i < st->count; i++) {
+        if (st->src[i].removed) continue;
+        sum += isr_arrivals(&st->src[i], w) * st->src[i].cost;
+    }
+    return sum;
+}
+
+uint64_t isr_response_time(const Scheduler *sched,
+                           const TaskControlBlock *task, bool include_isr)
+{
+    if (!sched || !task) return 0;
+
+    uint64_t limit = task->relative_deadline;
+    if (limit == 0) {
+        const IsrSource *s = source_of(sched->isr, task);
+        limit = s ? s->period : UINT64_MAX;
+    }
+
+    uint64_t r = task->wcet, prev = 0;
+    while (r != prev && r <= limit) {
+        prev = r;
+        r = task->wcet + interference(sched, task, task->priority, prev,
+                                      include_isr);
+    }
+    return (r > limit) ? 0 : r;
+}
+
+uint64_t isr_latency_bound(const Scheduler *sched, const IsrSource *src)
+{
+    if (!sched || !src || !src->handler) return 0;
+
+    /* Busy window before the handler's first tick: every ISR, the tasks
+       that outrank the handler, and the handler's own earlier jobs for
+       interrupts still queued (counted with the handler as `self`) */
+    uint64_t w = src->cost, prev = 0;
+    while (w != prev && w < 100 * src->period) {
+        prev = w;
+        w = interference(sched, NULL, src->handler->priority, prev, true);
+        if (w < src->cost) w = src->cost;
+    }
+    return (w >= 100 * src->period) ? 0 : w;
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+void isr_print_report(const Scheduler *sched)
+{
+    const IsrState *st = sched ? sched->isr : NULL;
+    if (!st) return;
+
+    printf("\n  %-8s %-9s %5s %4s %-9s %6s %6s %5s %15s %6s\n", "Source",
+           "Kind", "Level", "Cost", "Handler", "Raised", "Served", "Lost",
+           "Latency min/avg/max", "Bound");
+    for (int i = 0; i < st->count; i++) {
+        const IsrSource *s = &st->src[i];
+        if (s->removed) continue;
+        double avg = s->served ? (double)s->latency_sum / s->served : 0.0;
+        printf("  %-8s %-9s %5d %4u %-9s %6u %6u %5u %5" PRIu64 " /%4.1f /%3"
+               PRIu64 " %6" PRIu64 "\n", s->name, kind_name(s->kind),
+               s->level, s->cost, s->handler ? s->handler->name : "-",
+               s->raised, s->served, s->lost, s->latency_min, avg,
+               s->latency_max, isr_latency_bound(sched, s));
+    }
+
+    printf("\n  ISR time %" PRIu64 " ticks, %u nested preemptions\n",
+           st->isr_ticks, st->nested);
+    printf("  Interrupt-to-task latency histogram (ticks):\n   ");
+    for (int b = 0; b < ISR_HIST_BUCKETS; b++) {
+        if (b == 0)                         printf(" %6s", "0");
+        else if (b == 1)                    printf(" %6s", "1");
+        else if (b == ISR_HIST_BUCKETS - 1) printf(" %5d+", 1 << (b - 1));
+        else {
+            char lbl[16];
+            snprintf(lbl, sizeof(lbl), "%d-%d", 1 << (b - 1),
+                     (1 << b) - 1);
+            printf(" %6s", lbl);
+        }
+    }
+    printf("\n   ");
+    for (int b = 0; b < ISR_HIST_BUCKETS; b++) printf(" %6u", st->hist[b]);
+    printf("\n");
+}
@@ -0,0 +1,202 @@
+/*
+ * isr.h - Interrupt Sources and Deferred Processing
+ *
+ * Simulated interrupt sources raise interrupts periodically, sporadically
+ * (a minimum gap plus pseudo-random jitter), in bursts, or when a device
+ * model raises them (external sources). Every source has an interrupt
+ * level (0 = highest) above all task priorities and a fixed handler cost
+ * in ticks. While any interrupt is pending the core
+ * runs the highest-level one and no task executes; a higher level
+ * preempts a lower one at tick granularity.
+ *
+ * When its ISR completes, a source can defer the rest of the work to a
+ * task (the bottom half): it either releases an aperiodic handler task
+ * directly or signals a semaphore the handler waits on. A device driver
+ * can instead have a callback run at completion. The latency from
+ * raising the interrupt to the first tick the handler runs is recorded
+ * in a histogram.
+ *
+ * Response-time analysis includes the ISRs as interference from above
+ * every task, and counts each bottom-half task at its source's arrival
+ * rate:
+ *
+ *   R_i = C_i + sum_hp(j) I_j(R_i) + sum_s A_s(R_i) * c_s
+ *
+ * where A_s(w) is the largest number of interrupts of source s in any
+ * window of length w.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef ISR_H
+#define ISR_H
+
+#include "scheduler.h"
+#include "semaphore.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define ISR_MAX_SOURCES     8
+#define ISR_NAME_MAX        16
+#define ISR_QUEUE_CAP       32      /* Interrupts awaiting their handler */
+#define ISR_HIST_BUCKETS    10      /* Latency 0, 1, 2-3, 4-7, ...     */
+
+typedef enum {
+    ISR_PERIODIC,
+    ISR_SPORADIC,           /* Gap = min_gap + jitter in [0, jitter]  */
+    ISR_BURSTY,             /* `burst` arrivals `spacing` apart        */
+    ISR_EXTERNAL            /* Raised by a device, `period` apart at least */
+} IsrKind;
+
+typedef enum {
+    ISR_ACTION_NONE,        /* All work done in the ISR                */
+    ISR_ACTION_NOTIFY,      /* Release an aperiodic handler task       */
+    ISR_ACTION_SIGNAL,      /* Signal a semaphore the handler waits on */
+    ISR_ACTION_CALLBACK     /* Call a driver function at completion    */
+} IsrAction;
+
+typedef struct IsrSource IsrSource;
+
+/** Driver work done when an ISR completes (ISR_ACTION_CALLBACK). */
+typedef void (*IsrCallback)(Scheduler *sched, IsrSource *src, void *ctx);
+
+/* ── Interrupt source ─────────────────────────────────────────────── */
+struct IsrSource {
+    char              name[ISR_NAME_MAX];
+    IsrKind           kind;
+    int               level;        /* 0 = highest                     */
+    uint32_t          cost;         /* ISR execution, ticks            */
+    uint64_t          period;       /* Period, minimum gap, burst period */
+    uint64_t          jitter;       /* Sporadic extra gap bound        */
+    uint32_t          burst;        /* Arrivals per burst              */
+    uint64_t          spacing;      /* Gap inside a burst              */
+    uint32_t          seed;
+
+    /* Deferred processing */
+    IsrAction         action;
+    TaskControlBlock *handler;
+    Semaphore        *sem;
+    IsrCallback       callback;
+    void             *ctx;
+
+    /* Runtime */
+    bool              removed;      /* Slot free for a new source      */
+    uint64_t          next_arrival;
+    uint64_t          burst_start;
+    uint32_t          burst_left;
+    uint32_t          pending;      /* Raised, ISR not yet completed   */
+    uint32_t          left;         /* Ticks left of the ISR in service */
+    uint32_t          backlog;      /* Notifications the handler owes  */
+    uint64_t          raise[ISR_QUEUE_CAP];   /* Awaiting handler start */
+    int               q_head;
+    int               q_count;
+
+    /* Statistics */
+    uint32_t          raised;
+    uint32_t          handled;      /* ISRs completed                  */
+    uint32_t          served;       /* Handler starts measured         */
+    uint32_t          lost;         /* Raise queue overflowed          */
+    uint64_t          isr_ticks;
+    uint64_t          latency_min;
+    uint64_t          latency_max;
+    uint64_t          latency_sum;
+};
+
+/* ── Per-core state ───────────────────────────────────────────────── */
+struct IsrState {
+    IsrSource  src[ISR_MAX_SOURCES];
+    int        count;
+    int        in_service;          /* Source run last tick, -1 = none */
+    uint64_t   isr_ticks;
+    uint32_t   nested;              /* ISRs preempted by a higher level */
+    uint32_t   hist[ISR_HIST_BUCKETS];
+};
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+/** Enable the interrupt layer on a core. */
+bool isr_enable(Scheduler *sched);
+
+/** Remove all interrupt sources. */
+void isr_disable(Scheduler *sched);
+
+/** Interrupt every `period` ticks, first at now + `offset`. */
+IsrSource *isr_add_periodic(Scheduler *sched, const char *name, int level,
+                            uint32_t cost, uint64_t period,
+                            uint64_t offset);
+
+/** Interrupts at least `min_gap` apart, plus up to `jitter` more. */
+IsrSource *isr_add_sporadic(Scheduler *sched, const char *name, int level,
+                            uint32_t cost, uint64_t min_gap,
+                            uint64_t jitter, uint32_t seed);
+
+/** Every `period` ticks, `burst` interrupts `spacing` ticks apart. */
+IsrSource *isr_add_bursty(Scheduler *sched, const char *name, int level,
+                          uint32_t cost, uint64_t period, uint32_t burst,
+                          uint64_t spacing);
+
+/**
+ * Interrupt raised only by isr_raise() (a device), at most once every
+ * `min_gap` ticks; the gap is what response-time analysis assumes.
+ */
+IsrSource *isr_add_external(Scheduler *sched, const char *name, int level,
+                            uint32_t cost, uint64_t min_gap);
+
+/**
+ * Unregister a source: it raises no more interrupts and drops out of
+ * the analysis and the report. Its slot is reused by the next source
+ * added, so `src` must not be used afterwards.
+ */
+void isr_remove_source(Scheduler *sched, IsrSource *src);
+
+/** Raise an external interrupt now; its ISR runs from the next tick. */
+void isr_raise(Scheduler *sched, IsrSource *src);
+
+/** Call `callback` each time the ISR of `src` completes. */
+bool isr_set_callback(IsrSource *src, IsrCallback callback, void *ctx);
+
+/**
+ * Defer to an aperiodic task: each completed ISR releases one job of
+ * `handler` (queued while a job is still pending).
+ */
+bool isr_notify_task(IsrSource *src, TaskControlBlock *handler);
+
+/**
+ * Defer through a semaphore: each completed ISR signals `sem`, which
+ * `waiter` takes once per job.
+ */
+bool isr_signal_semaphore(IsrSource *src, Semaphore *sem,
+                          TaskControlBlock *waiter);
+
+/* ── Hooks ────────────────────────────────────────────────────────── */
+
+/**
+ * Raise due interrupts and run the highest-level pending ISR for the
+ * tick just elapsed (called by tick_handler before the running task is
+ * charged). Returns true if an ISR took the tick.
+ */
+bool isr_tick(Scheduler *sched, TaskControlBlock *curr);
+
+/* ── Analysis ─────────────────────────────────────────────────────── */
+
+/** Most interrupts of `src` in any window of `window` ticks. */
+uint64_t isr_arrivals(const IsrSource *src, uint64_t window);
+
+/**
+ * Fixed-priority response time of `task`, with or without interrupt
+ * interference. Returns 0 if it exceeds the task's deadline.
+ */
+uint64_t isr_response_time(const Scheduler *sched,
+                           const TaskControlBlock *task, bool include_isr);
+
+/** Worst-case latency from raising `src` to its handler's first tick. */
+uint64_t isr_latency_bound(const Scheduler *sched, const IsrSource *src);
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+/** Print per-source counts and latency, and the latency histogram. */
+void isr_print_report(const Scheduler *sched);
+
+#endif /* ISR_H */
@@ -0,0 +1,604 @@
+/*
+ * let.c - Logical Execution Time Communication
+ *
+ * Order of events at a tick under LET: the running job is charged and
+ * may complete (its output goes to the back buffer), then every channel
+ * whose writer's period ended at this tick swaps buffers, and only then
+ * are the inputs of the new periods copied. A value published at t is
+ * therefore read by every job released at t.
+ *
+ * Inputs are sampled at every period boundary of a reader, not when
+ * the simulator gets round to releasing its job, so a job released a
+ * tick late still computes on the values of its logical release. A job
+ * still running at the end of its period has overrun its LET; it
+ * publishes nothing and readers keep seeing the previous value.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "let.h"
+#include "timeline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+/* ── Helpers ──────────────────────────────────────────────────────── */
+
+static const char *mode_name(LetCommMode mode)
+{
+    return mode == LET_COMM_LOGICAL ? "LET" : "direct";
+}
+
+/* Buffers come from the per-core static pool, 8-byte aligned */
+static uint8_t *pool_alloc(LetState *st, size_t size)
+{
+    size_t used = st->shared_bytes + st->copy_bytes;
+    size_t need = (size + 7) & ~(size_t)7;
+    if (used + need > LET_POOL_BYTES) {
+        fprintf(stderr, "let: buffer pool exhausted (%d bytes)\n",
+                LET_POOL_BYTES);
+        return NULL;
+    }
+    return st->pool + used;
+}
+
+static LetTask *find_task(LetState *st, const TaskControlBlock *task,
+                          bool create)
+{
+    for (int i = 0; i < st->task_count; i++) {
+        if (st->task[i].task == task) return &st->task[i];
+    }
+    if (!create) return NULL;
+    if (task->period == 0) {
+        fprintf(stderr, "let: %s is not periodic\n", task->name);
+        return NULL;
+    }
+    if (st->task_count >= LET_MAX_TASKS) {
+        fprintf(stderr, "let: more than %d tasks\n", LET_MAX_TASKS);
+        return NULL;
+    }
+    LetTask *rec = &st->task[st->task_count++];
+    memset(rec, 0, sizeof(*rec));
+    rec->task = (TaskControlBlock *)task;
+    return rec;
+}
+
+/* Copy the published value of every channel `task` reads */
+static void read_inputs(LetState *st, const TaskControlBlock *task)
+{
+    for (int c = 0; c < st->channel_count; c++) {
+        LetChannel *ch = &st->channel[c];
+        for (int r = 0; r < ch->reader_count; r++) {
+            LetReader *rd = &ch->reader[r];
+            if (rd->task != task) continue;
+            memcpy(rd->copy, ch->buf[ch->front], ch->size);
+            rd->stamp = ch->stamp[ch->front];
+            rd->valid = ch->valid[ch->front];
+            memcpy(rd->chain_stamp, ch->chain_stamp[ch->front],
+                   sizeof(rd->chain_stamp));
+            memcpy(rd->chain_valid, ch->chain_valid[ch->front],
+                   sizeof(rd->chain_valid));
+        }
+    }
+}
+
+static void publish(LetState *st, LetChannel *ch, uint64_t now)
+{
+    if (st->mode == LET_COMM_LOGICAL) {
+        int f = 1 - ch->front;
+        ch->front   = f;
+        ch->pending = false;
+        /* Keep the back buffer coherent for partial writes */
+        memcpy(ch->buf[1 - f], ch->buf[f], ch->size);
+        ch->stamp[1 - f] = ch->stamp[f];
+        ch->valid[1 - f] = ch->valid[f];
+        memcpy(ch->chain_stamp[1 - f], ch->chain_stamp[f],
+               sizeof(ch->chain_stamp[f]));
+        memcpy(ch->chain_valid[1 - f], ch->chain_valid[f],
+               sizeof(ch->chain_valid[f]));
+    }
+    ch->publishes++;
+
+    if (ch->valid[ch->front]) {
+        uint64_t lat = now - ch->stamp[ch->front];
+        if (ch->latency_count == 0 || lat < ch->latency_min) {
+            ch->latency_min = lat;
+        }
+        if (lat > ch->latency_max) ch->latency_max = lat;
+        ch->latency_sum += lat;
+        ch->latency_count++;
+    }
+}
+
+static const LetReader *reader_of(const LetChannel *ch,
+                                  const TaskControlBlock *task)
+{
+    for (int r = 0; r < ch->reader_count; r++) {
+        if (ch->reader[r].task == task) return &ch->reader[r];
+    }
+    return NULL;
+}
+
+static int chain_position(const LetChain *chain, const TaskControlBlock *t)
+{
+    for (int i = 0; i < chain->length; i++) {
+        if (chain->task[i] == t) return i;
+    }
+    return -1;
+}
+
+/* Sample stamp of chain `c` in the current job of the task at `pos` */
+static bool chain_input(const LetState *st, int c, int pos,
+                        const LetTask *rec, uint64_t *stamp)
+{
+    if (pos == 0) {
+        *stamp = rec->origin;
+        return true;
+    }
+    const LetReader *rd = reader_of(st->chain[c].link[pos - 1], rec->task);
+    *stamp = rd->chain_stamp[c];
+    return rd->chain_valid[c];
+}
+
+/* An output of the chain's last task becomes visible at `at` */
+static void chain_output(Scheduler *sched, LetChain *chain, uint64_t at,
+                         uint64_t stamp)
+{
+    uint64_t age = at - stamp;
+    chain->outputs++;
+    if (age > chain->max_age) chain->max_age = age;
+
+    if (!chain->have_sample || stamp > chain->last_sample) {
+        if (chain->have_sample) {
+            uint64_t reaction = at - chain->last_sample;
+            if (reaction > chain->max_reaction) {
+                chain->max_reaction = reaction;
+            }
+        }
+        chain->have_sample = true;
+        chain->last_sample = stamp;
+    }
+
+    if (sched->timeline) {
+        char buf[ANNOTATION_MAX];
+        snprintf(buf, sizeof(buf), "CHAIN %s: output of sample @%" PRIu64
+                 ", data age %" PRIu64, chain->name, stamp, age);
+        timeline_record(sched->timeline, at,
+                        chain->task[chain->length - 1], VIS_NONE, buf);
+    }
+}
+
+static void complete(Scheduler *sched, LetTask *rec, uint64_t now)
+{
+    LetState *st = sched->let;
+    rec->active = false;
+    if (rec->late) {
+        rec->late = false;
+        return;                     /* Overran its LET: output dropped */
+    }
+
+    if (rec->step) rec->step(rec->task, rec->ctx);
+
+    /* The output is as old as the oldest input it was computed from */
+    uint64_t stamp = rec->origin;
+    bool     valid = true;
+    for (int c = 0; c < st->channel_count; c++) {
+        const LetChannel *ch = &st->channel[c];
+        for (int r = 0; r < ch->reader_count; r++) {
+            const LetReader *rd = &ch->reader[r];
+            if (rd->task != rec->task) continue;
+            if (!rd->valid) valid = false;
+            else if (rd->stamp < stamp) stamp = rd->stamp;
+        }
+    }
+
+    for (int c = 0; c < st->channel_count; c++) {
+        LetChannel *ch = &st->channel[c];
+        if (ch->writer != rec->task) continue;
+
+        int back = (st->mode == LET_COMM_LOGICAL) ? 1 - ch->front
+                                                  : ch->front;
+        ch->stamp[back] = stamp;
+        ch->valid[back] = valid;
+
+        /* Chains through this label carry their own sample forward */
+        for (int k = 0; k < st->chain_count; k++) {
+            int pos = chain_position(&st->chain[k], rec->task);
+            if (pos < 0 || pos + 1 >= st->chain[k].length ||
+                st->chain[k].link[pos] != ch) {
+                continue;
+            }
+            ch->chain_valid[back][k] =
+                chain_input(st, k, pos, rec, &ch->chain_stamp[back][k]);
+        }
+
+        if (st->mode == LET_COMM_LOGICAL) {
+            ch->pending    = true;
+            ch->publish_at = rec->let_end;
+        } else {
+            publish(st, ch, now);
+        }
+    }
+
+    for (int k = 0; k < st->chain_count; k++) {
+        LetChain *chain = &st->chain[k];
+        uint64_t  s;
+        if (chain->task[chain->length - 1] != rec->task ||
+            !chain_input(st, k, chain->length - 1, rec, &s)) {
+            continue;
+        }
+        if (st->mode == LET_COMM_LOGICAL) {
+            chain->pending       = true;
+            chain->pending_at    = rec->let_end;
+            chain->pending_stamp = s;
+        } else {
+            chain_output(sched, chain, now, s);
+        }
+    }
+}
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+bool let_enable(Scheduler *sched, LetCommMode mode)
+{
+    if (!sched) return false;
+    if (sched->let) {
+        fprintf(stderr, "let_enable: already enabled\n");
+        return false;
+    }
+    sched->let = calloc(1, sizeof(LetState));
+    if (!sched->let) {
+        fprintf(stderr, "let_enable: out of memory\n");
+        return false;
+    }
+    sched->let->mode = mode;
+    return true;
+}
+
+void let_disable(Scheduler *sched)
+{
+    if (!sched) return;
+    free(sched->let);
+    sched->let = NULL;
+}
+
+LetChannel *let_channel_create(Scheduler *sched, const char *name,
+                               TaskControlBlock *writer, size_t size)
+{
+    LetState *st = sched ? sched->let : NULL;
+    if (!st || !name || !writer || size == 0) return NULL;
+    if (st->channel_count >= LET_MAX_CHANNELS) {
+        fprintf(stderr, "let_channel_create: more than %d channels\n",
+                LET_MAX_CHANNELS);
+        return NULL;
+    }
+    if (!find_task(st, writer, true)) return NULL;
+
+    LetChannel *ch = &st->channel[st->channel_count];
+    memset(ch, 0, sizeof(*ch));
+    snprintf(ch->name, sizeof(ch->name), "%s", name);
+    ch->writer = writer;
+    ch->size   = size;
+
+    int bufs = (st->mode == LET_COMM_LOGICAL) ? 2 : 1;
+    for (int b = 0; b < bufs; b++) {
+        ch->buf[b] = pool_alloc(st, size);
+        if (!ch->buf[b]) return NULL;
+        st->shared_bytes += (size + 7) & ~(size_t)7;
+    }
+    st->channel_count++;
+    return ch;
+}
+
+bool let_channel_add_reader(Scheduler *sched, LetChannel *ch,
+                            TaskControlBlock *reader)
+{
+    LetState *st = sched ? sched->let : NULL;
+    if (!st || !ch || !reader) return false;
+    if (ch->reader_count >= LET_MAX_READERS) {
+        fprintf(stderr, "let_channel_add_reader: %s has %d readers\n",
+                ch->name, LET_MAX_READERS);
+        return false;
+    }
+    if (!find_task(st, reader, true)) return false;
+
+    LetReader *rd = &ch->reader[ch->reader_count];
+    rd->copy = pool_alloc(st, ch->size);
+    if (!rd->copy) return false;
+    st->copy_bytes += (ch->size + 7) & ~(size_t)7;
+    rd->task  = reader;
+    rd->valid = false;
+    ch->reader_count++;
+    return true;
+}
+
+LetChannel *let_channel_find(Scheduler *sched, const char *name)
+{
+    LetState *st = sched ? sched->let : NULL;
+    if (!st || !name) return NULL;
+    for (int c = 0; c < st->channel_count; c++) {
+        if (strcmp(st->channel[c].name, name) == 0) return &st->channel[c];
+    }
+    return NULL;
+}
+
+LetChannel *let_writes(Scheduler *sched, TaskControlBlock *task,
+                       const char *name, size_t size)
+{
+    if (let_channel_find(sched, name)) {
+        fprintf(stderr, "let_writes: label %s already has a writer\n",
+                name);
+        return NULL;
+    }
+    return let_channel_create(sched, name, task, size);
+}
+
+bool let_reads(Scheduler *sched, TaskControlBlock *task, const char *name)
+{
+    LetChannel *ch = let_channel_find(sched, name);
+    if (!ch) {
+        fprintf(stderr, "let_reads: label %s has no writer\n",
+                name ? name : "(null)");
+        return false;
+    }
+    return let_channel_add_reader(sched, ch, task);
+}
+
+bool let_set_step(Scheduler *sched, TaskControlBlock *task, LetStep step,
+                  void *ctx)
+{
+    LetState *st = sched ? sched->let : NULL;
+    if (!st || !task) return false;
+    LetTask *rec = find_task(st, task, true);
+    if (!rec) return false;
+    rec->step = step;
+    rec->ctx  = ctx;
+    return true;
+}
+
+bool let_start(Scheduler *sched)
+{
+    LetState *st = sched ? sched->let : NULL;
+    if (!st) {
+        fprintf(stderr, "let_start: not enabled\n");
+        return false;
+    }
+    st->started = true;
+    for (int i = 0; i < st->task_count; i++) {
+        LetTask          *rec = &st->task[i];
+        TaskControlBlock *t   = rec->task;
+        if ((t->state == TASK_READY || t->state == TASK_RUNNING) &&
+            t->remaining_work > 0) {
+            rec->active = true;
+        }
+        if (st->mode == LET_COMM_LOGICAL) {
+            rec->origin  = sched->system_ticks;
+            rec->let_end = sched->system_ticks + t->period;
+            read_inputs(st, t);
+        }
+    }
+    return true;
+}
+
+/* ── Cause-effect chains ──────────────────────────────────────────── */
+
+LetChain *let_chain_create(Scheduler *sched, const char *name,
+                           TaskControlBlock *const tasks[], int count)
+{
+    LetState *st = sched ? sched->let : NULL;
+    if (!st || !name || !tasks) return NULL;
+    if (count < 1 || count > LET_CHAIN_MAX_LEN) {
+        fprintf(stderr, "let_chain_create: %s needs 1..%d tasks\n", name,
+                LET_CHAIN_MAX_LEN);
+        return NULL;
+    }
+    if (st->chain_count >= LET_MAX_CHAINS) {
+        fprintf(stderr, "let_chain_create: more than %d chains\n",
+                LET_MAX_CHAINS);
+        return NULL;
+    }
+
+    LetChain chain;
+    memset(&chain, 0, sizeof(chain));
+    snprintf(chain.name, sizeof(chain.name), "%s", name);
+    chain.length = count;
+    for (int i = 0; i < count; i++) {
+        if (!find_task(st, tasks[i], true)) return NULL;
+        chain.task[i] = tasks[i];
+        if (i == 0) continue;
+
+        for (int c = 0; c < st->channel_count && !chain.link[i - 1]; c++) {
+            LetChannel *ch = &st->channel[c];
+            if (ch->writer == tasks[i - 1] && reader_of(ch, tasks[i])) {
+                chain.link[i - 1] = ch;
+            }
+        }
+        if (!chain.link[i - 1]) {
+            fprintf(stderr, "let_chain_create: no label from %s to %s\n",
+                    tasks[i - 1]->name, tasks[i]->name);
+            return NULL;
+        }
+    }
+
+    st->chain[st->chain_count] = chain;
+    return &st->chain[st->chain_count++];
+}
+
+/* Fixed-priority response time of `ti` (0 if it exceeds the deadline) */
+static uint64_t response_time(const Scheduler *sched,
+                              const TaskControlBlock *ti)
+{
+    uint64_t r = ti->wcet, prev = 0;
+    while (r != prev && r <= ti->relative_deadline) {
+        prev = r;
+        r    = ti->wcet;
+        for (int j = 0; j < sched->task_count; j++) {
+            const TaskControlBlock *tj = sched->all_tasks[j];
+            if (tj == ti || !tj || tj == sched->idle_task ||
+                tj->period == 0 || tj->priority > ti->priority) {
+                continue;
+            }
+            r += ((prev + tj->period - 1) / tj->period) * tj->wcet;
+        }
+    }
+    return (r > ti->relative_deadline) ? 0 : r;
+}
+
+uint64_t let_chain_bound(const Scheduler *sched, const LetChain *chain)
+{
+    const LetState *st = sched ? sched->let : NULL;
+    if (!st || !chain) return 0;
+
+    uint64_t bound = 0;
+    for (int i = 0; i < chain->length; i++) {
+        const TaskControlBlock *t = chain->task[i];
+        uint64_t r = (st->mode == LET_COMM_LOGICAL)
+                   ? t->period : response_time(sched, t);
+        if (r == 0) return 0;
+        bound += t->period + r;
+    }
+    return bound;
+}
+
+/* ── Data access ──────────────────────────────────────────────────── */
+
+const void *let_input(const LetChannel *ch, const TaskControlBlock *reader)
+{
+    if (!ch) return NULL;
+    for (int r = 0; r < ch->reader_count; r++) {
+        if (ch->reader[r].task == reader) return ch->reader[r].copy;
+    }
+    return NULL;
+}
+
+void *let_output(LetChannel *ch)
+{
+    if (!ch) return NULL;
+    /* Only LET channels have a second buffer */
+    return ch->buf[1] ? ch->buf[1 - ch->front] : ch->buf[ch->front];
+}
+
+/* ── Hooks ────────────────────────────────────────────────────────── */
+
+void let_job_released(Scheduler *sched, TaskControlBlock *task)
+{
+    LetState *st = sched ? sched->let : NULL;
+    if (!st || !st->started) return;
+    LetTask *rec = find_task(st, task, false);
+    if (!rec) return;
+
+    /* Under LET the inputs were already read at the period start; a
+       job released late still belongs to that interval */
+    rec->active = true;
+    rec->late   = false;
+}
+
+void let_tick(Scheduler *sched, TaskControlBlock *curr, bool ran)
+{
+    LetState *st = sched ? sched->let : NULL;
+    if (!st || !st->started) return;
+    uint64_t now = sched->system_ticks;
+
+    LetTask *rec = (ran && curr) ? find_task(st, curr, false) : NULL;
+    if (rec && rec->active) {
+        /* Direct mode: inputs are read when the job first runs, at the
+           start of the tick just executed */
+        if (st->mode == LET_COMM_DIRECT && curr->exec_time == 1) {
+            rec->origin = now - 1;
+            read_inputs(st, curr);
+        }
+        if (curr->remaining_work == 0) complete(sched, rec, now);
+    }
+
+    if (st->mode != LET_COMM_LOGICAL) return;
+
+    for (int i = 0; i < st->task_count; i++) {
+        LetTask *t = &st->task[i];
+        if (!t->active || t->late || t->let_end != now) continue;
+        t->late = true;
+        t->overruns++;
+        if (sched->timeline) {
+            char buf[ANNOTATION_MAX];
+            snprintf(buf, sizeof(buf), "LET: %s overran its period, "
+                     "output dropped", t->task->name);
+            timeline_record(sched->timeline, now, t->task, VIS_NONE, buf);
+        }
+    }
+
+    for (int c = 0; c < st->channel_count; c++) {
+        LetChannel *ch = &st->channel[c];
+        if (ch->pending && ch->publish_at <= now) publish(st, ch, now);
+    }
+    for (int k = 0; k < st->chain_count; k++) {
+        LetChain *chain = &st->chain[k];
+        if (chain->pending && chain->pending_at <= now) {
+            chain->pending = false;
+            chain_output(sched, chain, now, chain->pending_stamp);
+        }
+    }
+
+    /* Next logical interval: inputs are sampled at its start whether or
+       not the job has been released yet */
+    for (int i = 0; i < st->task_count; i++) {
+        LetTask *t = &st->task[i];
+        if (t->let_end != now) continue;
+        t->origin   = now;
+        t->let_end += t->task->period;
+        read_inputs(st, t->task);
+    }
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+size_t let_memory_bytes(const Scheduler *sched)
+{
+    const LetState *st = sched ? sched->let : NULL;
+    return st ? st->shared_bytes + st->copy_bytes : 0;
+}
+
+void let_print_report(const Scheduler *sched)
+{
+    const LetState *st = sched ? sched->let : NULL;
+    if (!st) return;
+
+    printf("\n  %s communication: %zu B channel buffers + %zu B reader "
+           "copies = %zu B\n", mode_name(st->mode), st->shared_bytes,
+           st->copy_bytes, let_memory_bytes(sched));
+    printf("  %-10s %-10s %5s %7s %6s %21s\n", "Channel", "Writer", "Size",
+           "Readers", "Publ", "Latency min/avg/max");
+    for (int c = 0; c < st->channel_count; c++) {
+        const LetChannel *ch = &st->channel[c];
+        double avg = ch->latency_count
+                   ? (double)ch->latency_sum / ch->latency_count : 0.0;
+        printf("  %-10s %-10s %5zu %7d %6u %8" PRIu64 " /%5.1f /%4" PRIu64
+               "\n", ch->name, ch->writer->name, ch->size,
+               ch->reader_count, ch->publishes, ch->latency_min, avg,
+               ch->latency_max);
+    }
+    if (st->chain_count > 0) {
+        printf("\n  %-10s %-30s %7s %9s %9s %6s\n", "Chain", "Tasks",
+               "Outputs", "Reaction", "Data age", "Bound");
+    }
+    for (int k = 0; k < st->chain_count; k++) {
+        const LetChain *chain = &st->chain[k];
+        char path[64] = "";
+        size_t len = 0;
+        for (int i = 0; i < chain->length && len < sizeof(path); i++) {
+            len += (size_t)snprintf(path + len, sizeof(path) - len, "%s%s",
+                                    i ? ">" : "", chain->task[i]->name);
+        }
+        printf("  %-10s %-30s %7u %9" PRIu64 " %9" PRIu64 " %6" PRIu64
+               "\n", chain->name, path, chain->outputs,
+               chain->max_reaction, chain->max_age,
+               let_chain_bound(sched, chain));
+    }
+    for (int i = 0; i < st->task_count; i++) {
+        if (st->task[i].overruns) {
+            printf("  %s overran its LET %u times\n",
+                   st->task[i].task->name, st->task[i].overruns);
+        }
+    }
+}
@@ -0,0 +1,243 @@
+/*
+ * let.h - Logical Execution Time Communication
+ *
+ * Tasks exchange data through channels with one writer and any number
+ * of readers. Two communication modes are simulated:
+ *
+ *   LET_COMM_DIRECT   a job reads its inputs when it first runs and its
+ *                     output is visible as soon as it completes (one
+ *                     shared buffer per channel);
+ *   LET_COMM_LOGICAL  inputs are read at the start of each period and
+ *                     the job's output is published at its end, the
+ *                     Logical Execution Time (Henzinger, Kirsch).
+ *
+ * Under LET the writer fills a back buffer while readers see the front
+ * one; the two are swapped at the writer's period end, before readers
+ * whose periods start at that tick copy their inputs. What a job
+ * computes on, and when its result becomes visible, therefore depend
+ * only on the period grid and never on how the jobs were scheduled.
+ *
+ * Every value carries the tick its source task sampled it; the latency
+ * from sample to publication is recorded per channel.
+ *
+ * A cause-effect chain is a declared path of tasks linked by labels
+ * (channels), from a sensing task to an acting one; periods may differ.
+ * Values carry a separate sample stamp per chain, so at each output of
+ * the last task the simulator knows which sample of the first task it
+ * reflects:
+ *
+ *   data age       output time - sample time of the data it used;
+ *   reaction time  output time - the previous output's sample time,
+ *                  measured at the first output of each new sample
+ *                  (worst case for a stimulus arriving just after a
+ *                  sample that was already propagated).
+ *
+ * Both are compared with Davare et al.'s bound sum(T_i + R_i), with R_i
+ * from response-time analysis in direct mode and R_i = T_i under LET.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef LET_H
+#define LET_H
+
+#include "scheduler.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define LET_MAX_CHANNELS    16
+#define LET_MAX_READERS     8       /* Readers per channel             */
+#define LET_MAX_TASKS       32      /* Tasks reading, writing or with a step */
+#define LET_CHANNEL_NAME_MAX 16
+#define LET_POOL_BYTES      4096    /* Static buffer memory            */
+#define LET_MAX_CHAINS      4
+#define LET_CHAIN_MAX_LEN   8
+
+typedef enum {
+    LET_COMM_DIRECT,        /* Read at start, visible at completion    */
+    LET_COMM_LOGICAL        /* Read at period start, visible at end    */
+} LetCommMode;
+
+/**
+ * Job body run at completion: reads let_input() of the channels the
+ * task reads and fills let_output() of the channels it writes.
+ */
+typedef void (*LetStep)(TaskControlBlock *task, void *ctx);
+
+/* A reader's private copy of the channel */
+typedef struct {
+    TaskControlBlock *task;
+    uint8_t          *copy;
+    uint64_t          stamp;        /* Sample tick of the copied value */
+    bool              valid;
+    uint64_t          chain_stamp[LET_MAX_CHAINS];
+    bool              chain_valid[LET_MAX_CHAINS];
+} LetReader;
+
+typedef struct {
+    char              name[LET_CHANNEL_NAME_MAX];
+    TaskControlBlock *writer;
+    size_t            size;
+
+    uint8_t          *buf[2];       /* buf[1] only under LET           */
+    uint64_t          stamp[2];
+    bool              valid[2];
+    uint64_t          chain_stamp[2][LET_MAX_CHAINS];
+    bool              chain_valid[2][LET_MAX_CHAINS];
+    int               front;        /* Buffer readers see              */
+    bool              pending;      /* Back buffer awaits publication  */
+    uint64_t          publish_at;
+
+    LetReader         reader[LET_MAX_READERS];
+    int               reader_count;
+
+    /* Statistics */
+    uint32_t          publishes;
+    uint64_t          latency_min;  /* Sample to publication, ticks    */
+    uint64_t          latency_max;
+    uint64_t          latency_sum;
+    uint32_t          latency_count;
+} LetChannel;
+
+/* Per-task job state */
+typedef struct {
+    TaskControlBlock *task;
+    LetStep           step;
+    void             *ctx;
+    bool              active;       /* Job released and not finished   */
+    bool              late;         /* Active job missed its LET end   */
+    uint64_t          origin;       /* Tick the job read its inputs    */
+    uint64_t          let_end;      /* End of the current interval     */
+    uint32_t          overruns;     /* Jobs still running at let_end   */
+} LetTask;
+
+/* A declared cause-effect chain */
+typedef struct {
+    char              name[LET_CHANNEL_NAME_MAX];
+    TaskControlBlock *task[LET_CHAIN_MAX_LEN];
+    LetChannel       *link[LET_CHAIN_MAX_LEN - 1];  /* task[i] to [i+1] */
+    int               length;
+
+    /* Last task's output awaiting its LET end */
+    bool              pending;
+    uint64_t          pending_at;
+    uint64_t          pending_stamp;
+
+    /* Measurements */
+    uint32_t          outputs;
+    bool              have_sample;
+    uint64_t          last_sample;  /* Newest sample seen at the output */
+    uint64_t          max_age;
+    uint64_t          max_reaction;
+} LetChain;
+
+/* ── Per-core state ───────────────────────────────────────────────── */
+struct LetState {
+    LetCommMode  mode;
+    bool         started;
+
+    LetChannel   channel[LET_MAX_CHANNELS];
+    int          channel_count;
+    LetTask      task[LET_MAX_TASKS];
+    int          task_count;
+    LetChain     chain[LET_MAX_CHAINS];
+    int          chain_count;
+
+    _Alignas(8) uint8_t pool[LET_POOL_BYTES];
+    size_t       shared_bytes;      /* Channel buffers                 */
+    size_t       copy_bytes;        /* Reader copies                   */
+};
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+/** Enable channel communication on a core in the given mode. */
+bool let_enable(Scheduler *sched, LetCommMode mode);
+
+/** Remove all channels and return to no communication model. */
+void let_disable(Scheduler *sched);
+
+/**
+ * Create a channel of `size` bytes written by `writer`. Its buffers are
+ * zero and marked invalid until the writer's first publication.
+ */
+LetChannel *let_channel_create(Scheduler *sched, const char *name,
+                               TaskControlBlock *writer, size_t size);
+
+/** Add `reader` to the channel; it gets a private copy of the value. */
+bool let_channel_add_reader(Scheduler *sched, LetChannel *ch,
+                            TaskControlBlock *reader);
+
+/**
+ * Declare that `task` writes the label `name` of `size` bytes: creates
+ * the channel. Fails if the label already has a writer.
+ */
+LetChannel *let_writes(Scheduler *sched, TaskControlBlock *task,
+                       const char *name, size_t size);
+
+/** Declare that `task` reads the label `name` (declared by its writer). */
+bool let_reads(Scheduler *sched, TaskControlBlock *task, const char *name);
+
+/** Find a label by name (NULL if undeclared). */
+LetChannel *let_channel_find(Scheduler *sched, const char *name);
+
+/** Set the body run when a job of `task` completes. */
+bool let_set_step(Scheduler *sched, TaskControlBlock *task, LetStep step,
+                  void *ctx);
+
+/**
+ * Start the communication model at the current tick, which begins the
+ * first period of every task. Call after creating the channels.
+ */
+bool let_start(Scheduler *sched);
+
+/* ── Cause-effect chains ──────────────────────────────────────────── */
+
+/**
+ * Declare a chain through `count` tasks; each consecutive pair must be
+ * linked by a label the first writes and the second reads. Declare
+ * chains before let_start().
+ */
+LetChain *let_chain_create(Scheduler *sched, const char *name,
+                           TaskControlBlock *const tasks[], int count);
+
+/**
+ * Analytic end-to-end bound sum(T_i + R_i) over the chain's tasks
+ * (0 if some task misses its deadline in the response-time analysis).
+ */
+uint64_t let_chain_bound(const Scheduler *sched, const LetChain *chain);
+
+/* ── Data access (inside a LetStep) ───────────────────────────────── */
+
+/** The value `reader` read for its current job (NULL if not a reader). */
+const void *let_input(const LetChannel *ch, const TaskControlBlock *reader);
+
+/** The buffer the writer's current job fills. */
+void *let_output(LetChannel *ch);
+
+/* ── Hooks ────────────────────────────────────────────────────────── */
+
+/** Job release (called by check_periodic_releases). */
+void let_job_released(Scheduler *sched, TaskControlBlock *task);
+
+/**
+ * Per-tick processing (called by tick_handler before releases):
+ * completion of the running job, direct-mode reads of a job that just
+ * started, and LET publications and reads at period boundaries.
+ */
+void let_tick(Scheduler *sched, TaskControlBlock *curr, bool ran);
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+/** Buffer memory used by channels and reader copies, in bytes. */
+size_t let_memory_bytes(const Scheduler *sched);
+
+/**
+ * Print per-channel publications and latency, per-chain reaction time
+ * and data age against the bound, and the memory cost.
+ */
+void let_print_report(const Scheduler *sched);
+
+#endif /* LET_H */
@@ -5,7 +5,7 @@
  * or all tests at once.
  *
  * Usage:
- *   rtos_scheduler [1-8|all]
+ *   rtos_scheduler [1-33|all]
  *
  * Author: RTOS Project
  * Date:   2026-02-13
@@ -24,6 +24,31 @@ extern void test_transitive_pi(void);
 extern void test_rms(void);
 extern void test_semaphore(void);
 extern void test_deadline_miss(void);
+extern void test_smp_parallel(void);
+extern void test_pfair(void);
+extern void test_dag_federated(void);
+extern void test_memguard(void);
+extern void test_task_bodies(void);
+extern void test_mixed_criticality(void);
+extern void test_mode_change(void);
+extern void test_elastic(void);
+extern void test_mk_firm(void);
+extern void test_dvfs(void);
+extern void test_dpm(void);
+extern void test_cyclic_executive(void);
+extern void test_tt_synthesis(void);
+extern void test_let(void);
+extern void test_cause_effect_chains(void);
+extern void test_precedence_graphs(void);
+extern void test_interrupts(void);
+extern void test_software_timers(void);
+extern void test_task_delays(void);
+extern void test_memory_pools(void);
+extern void test_topics(void);
+extern void test_io_devices(void);
+extern void test_wait_any(void);
+extern void test_event_injection(void);
+extern void test_event_stream(void);
 
 /* ── Usage ────────────────────────────────────────────────────────── */
 
@@ -44,6 +69,31 @@ static void print_usage(const char *prog)
     printf("    6   - Rate Monotonic Scheduling\n");
     printf("    7   - Semaphore Producer-Consumer\n");
     printf("    8   - Deadline Miss Detection\n");
+    printf("    9   - Parallel Multicore Simulation\n");
+    printf("    10  - Pfair (PD2) Multiprocessor Scheduling\n");
+    printf("    11  - DAG Tasks with Federated Scheduling\n");
+    printf("    12  - Memory-Bandwidth Regulation (MemGuard)\n");
+    printf("    13  - Host-Thread Execution of Task Bodies\n");
+    printf("    14  - Mixed-Criticality Scheduling (AMC)\n");
+    printf("    15  - Runtime Mode Changes\n");
+    printf("    16  - Elastic Task Model\n");
+    printf("    17  - (m,k)-Firm Deadline Scheduling\n");
+    printf("    18  - Energy-Aware DVFS\n");
+    printf("    19  - Idle-Time Power Management\n");
+    printf("    20  - Static Cyclic Executive\n");
+    printf("    21  - Time-Triggered Schedule Synthesis\n");
+    printf("    22  - Logical Execution Time (LET)\n");
+    printf("    23  - Cause-Effect Chain Latency\n");
+    printf("    24  - Precedence-Constrained Task Graphs\n");
+    printf("    25  - Interrupt Sources and Bottom-Half Deferral\n");
+    printf("    26  - Software Timers on a Timing Wheel\n");
+    printf("    27  - Task Delays and the Sleep Queue\n");
+    printf("    28  - Fixed-Block Memory Pools\n");
+    printf("    29  - Publish/Subscribe Topic Fan-Out\n");
+    printf("    30  - Simulated I/O Devices\n");
+    printf("    31  - Waiting on Multiple Objects\n");
+    printf("    32  - Thread-Safe External Event Injection\n");
+    printf("    33  - Streaming Event Input\n");
     printf("    all - Run all scenarios\n");
     printf("\n");
     printf("  Example:\n");
@@ -62,6 +112,31 @@ static void run_all(void)
     test_rms();
     test_semaphore();
     test_deadline_miss();
+    test_smp_parallel();
+    test_pfair();
+    test_dag_federated();
+    test_memguard();
+    test_task_bodies();
+    test_mixed_criticality();
+    test_mode_change();
+    test_elastic();
+    test_mk_firm();
+    test_dvfs();
+    test_dpm();
+    test_cyclic_executive();
+    test_tt_synthesis();
+    test_let();
+    test_cause_effect_chains();
+    test_precedence_graphs();
+    test_interrupts();
+    test_software_timers();
+    test_task_delays();
+    test_memory_pools();
+    test_topics();
+    test_io_devices();
+    test_wait_any();
+    test_event_injection();
+    test_event_stream();
 }
 
 /* ── Main ─────────────────────────────────────────────────────────── */
@@ -93,6 +168,56 @@ int main(int argc, char *argv[])
         test_semaphore();
     } else if (strcmp(arg, "8") == 0) {
         test_deadline_miss();
+    } else if (strcmp(arg, "9") == 0) {
+        test_smp_parallel();
+    } else if (strcmp(arg, "10") == 0) {
+        test_pfair();
+    } else if (strcmp(arg, "11") == 0) {
+        test_dag_federated();
+    } else if (strcmp(arg, "12") == 0) {
+        test_memguard();
+    } else if (strcmp(arg, "13") == 0) {
+        test_task_bodies();
+    } else if (strcmp(arg, "14") == 0) {
+        test_mixed_criticality();
+    } else if (strcmp(arg, "15") == 0) {
+        test_mode_change();
+    } else if (strcmp(arg, "16") == 0) {
+        test_elastic();
+    } else if (strcmp(arg, "17") == 0) {
+        test_mk_firm();
+    } else if (strcmp(arg, "18") == 0) {
+        test_dvfs();
+    } else if (strcmp(arg, "19") == 0) {
+        test_dpm();
+    } else if (strcmp(arg, "20") == 0) {
+        test_cyclic_executive();
+    } else if (strcmp(arg, "21") == 0) {
+        test_tt_synthesis();
+    } else if (strcmp(arg, "22") == 0) {
+        test_let();
+    } else if (strcmp(arg, "23") == 0) {
+        test_cause_effect_chains();
+    } else if (strcmp(arg, "24") == 0) {
+        test_precedence_graphs();
+    } else if (strcmp(arg, "25") == 0) {
+        test_interrupts();
+    } else if (strcmp(arg, "26") == 0) {
+        test_software_timers();
+    } else if (strcmp(arg, "27") == 0) {
+        test_task_delays();
+    } else if (strcmp(arg, "28") == 0) {
+        test_memory_pools();
+    } else if (strcmp(arg, "29") == 0) {
+        test_topics();
+    } else if (strcmp(arg, "30") == 0) {
+        test_io_devices();
+    } else if (strcmp(arg, "31") == 0) {
+        test_wait_any();
+    } else if (strcmp(arg, "32") == 0) {
+        test_event_injection();
+    } else if (strcmp(arg, "33") == 0) {
+        test_event_stream();
     } else {
         fprintf(stderr, "Unknown scenario: %s\n", arg);
         print_usage(argv[0]);
@@ -0,0 +1,209 @@
+/*
+ * memguard.c - Per-Core Memory Bandwidth Regulation (MemGuard-style)
+ *
+ * Regulation is evaluated once per tick from tick_handler. The tick in
+ * which a core overflows its budget still completes (the overflow
+ * interrupt fires after the access); every following tick of that
+ * regulation period the core is stalled.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "memguard.h"
+#include "timeline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+void memguard_enable(Scheduler *sched, uint64_t budget, uint64_t period)
+{
+    if (!sched || period == 0) return;
+
+    if (!sched->memguard) {
+        sched->memguard = calloc(1, sizeof(MemGuard));
+        if (!sched->memguard) {
+            fprintf(stderr, "memguard_enable: out of memory\n");
+            return;
+        }
+    }
+
+    MemGuard *mg = sched->memguard;
+    mg->budget       = budget;
+    mg->period       = period;
+    mg->period_start = sched->system_ticks - (sched->system_ticks % period);
+    mg->used         = 0;
+    mg->throttled    = false;
+}
+
+void memguard_disable(Scheduler *sched)
+{
+    if (!sched) return;
+    free(sched->memguard);
+    sched->memguard = NULL;
+}
+
+void memguard_set_task_rate(TaskControlBlock *task, uint32_t rate)
+{
+    if (task) task->mem_rate = rate;
+}
+
+/* ── Per-tick regulation ──────────────────────────────────────────── */
+
+bool memguard_tick(Scheduler *sched, TaskControlBlock *curr)
+{
+    MemGuard *mg = sched ? sched->memguard : NULL;
+    if (!mg) return false;
+
+    /* tick_handler has already advanced time: this is the tick that
+       just executed */
+    uint64_t t = sched->system_ticks - 1;
+
+    /* Replenish at regulation period boundaries */
+    if (t >= mg->period_start + mg->period) {
+        mg->period_start = t - (t % mg->period);
+        mg->used = 0;
+        mg->periods++;
+        if (mg->throttled) {
+            mg->throttled = false;
+            if (sched->timeline) {
+                char buf[ANNOTATION_MAX];
+                snprintf(buf, sizeof(buf),
+                         "MEMGUARD: core %d budget replenished",
+                         sched->core_id);
+                timeline_record(sched->timeline, t, curr, VIS_NONE, buf);
+            }
+        }
+    }
+
+    if (mg->throttled) {
+        mg->throttled_ticks++;
+        if (curr && curr != sched->idle_task &&
+            curr->state == TASK_RUNNING) {
+            curr->throttled_ticks++;
+        }
+        return true;
+    }
+
+    if (!curr || curr == sched->idle_task ||
+        curr->state != TASK_RUNNING || curr->mem_rate == 0) {
+        return false;
+    }
+
+    mg->used           += curr->mem_rate;
+    mg->total_accesses += curr->mem_rate;
+
+    if (mg->used >= mg->budget) {
+        mg->throttled = true;
+        mg->throttle_events++;
+        if (sched->timeline) {
+            char buf[ANNOTATION_MAX];
+            snprintf(buf, sizeof(buf),
+                     "MEMGUARD: core %d throttled (%s used %" PRIu64
+                     "/%" PRIu64 " accesses)",
+                     sched->core_id, curr->name, mg->used, mg->budget);
+            timeline_record(sched->timeline, t, curr, VIS_NONE, buf);
+        }
+    }
+    return false;
+}
+
+/* ── Bandwidth partitioning ───────────────────────────────────────── */
+
+uint64_t memguard_core_demand(const Scheduler *sched, uint64_t period)
+{
+    if (!sched) return 0;
+    uint64_t demand = 0;
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *t = sched->all_tasks[i];
+        if (!t || t == sched->idle_task || t->mem_rate == 0) continue;
+        if (t->period > 0) {
+            /* Accesses per job, scaled to the regulation period */
+            demand += ((uint64_t)t->mem_rate * t->wcet * period +
+                       t->period - 1) / t->period;
+        } else {
+            demand += (uint64_t)t->mem_rate * period;
+        }
+    }
+    return demand;
+}
+
+void memguard_partition(SmpSystem *sys, uint64_t total_budget,
+                        uint64_t period, MemGuardPolicy policy)
+{
+    if (!sys || sys->core_count == 0) return;
+
+    uint64_t demand[SMP_MAX_CORES];
+    uint64_t total_demand = 0;
+    for (int c = 0; c < sys->core_count; c++) {
+        demand[c] = memguard_core_demand(&sys->cores[c], period);
+        total_demand += demand[c];
+    }
+
+    uint64_t given = 0;
+    for (int c = 0; c < sys->core_count; c++) {
+        uint64_t share;
+        if (policy == MEMGUARD_PART_DEMAND && total_demand > 0) {
+            share = total_budget * demand[c] / total_demand;
+        } else {
+            share = total_budget / (uint64_t)sys->core_count;
+        }
+        memguard_enable(&sys->cores[c], share, period);
+        given += share;
+    }
+
+    /* Rounding leftovers go to the core with the highest demand */
+    if (given < total_budget) {
+        int top = 0;
+        for (int c = 1; c < sys->core_count; c++) {
+            if (demand[c] > demand[top]) top = c;
+        }
+        sys->cores[top].memguard->budget += total_budget - given;
+    }
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+void memguard_print_report(const SmpSystem *sys)
+{
+    if (!sys) return;
+
+    printf("\n  %-5s %7s %7s %9s %7s %9s %7s %7s\n",
+           "Core", "Budget", "Demand", "Accesses", "Events",
+           "Throttled", "Share", "Misses");
+    printf("  %-5s %7s %7s %9s %7s %9s %7s %7s\n",
+           "----", "------", "------", "--------", "------",
+           "---------", "-----", "------");
+
+    uint64_t total_throttled = 0;
+    for (int c = 0; c < sys->core_count; c++) {
+        const Scheduler *sched = &sys->cores[c];
+        const MemGuard  *mg    = sched->memguard;
+
+        uint32_t misses = 0;
+        for (int i = 0; i < sched->task_count; i++) {
+            misses += sched->all_tasks[i]->deadline_misses;
+        }
+
+        if (!mg) {
+            printf("  C%-4d %7s %7s %9s %7s %9s %7s %7u\n",
+                   c, "-", "-", "-", "-", "-", "-", misses);
+            continue;
+        }
+
+        double share = sched->system_ticks
+                     ? 100.0 * (double)mg->throttled_ticks /
+                       (double)sched->system_ticks
+                     : 0.0;
+        printf("  C%-4d %7" PRIu64 " %7" PRIu64 " %9" PRIu64
+               " %7" PRIu64 " %9" PRIu64 " %6.1f%% %7u\n",
+               c, mg->budget, memguard_core_demand(sched, mg->period),
+               mg->total_accesses, mg->throttle_events,
+               mg->throttled_ticks, share, misses);
+        total_throttled += mg->throttled_ticks;
+    }
+    printf("  Total throttled ticks: %" PRIu64 "\n", total_throttled);
+}
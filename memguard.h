@@ -0,0 +1,71 @@
+/*
+ * memguard.h - Per-Core Memory Bandwidth Regulation (MemGuard-style)
+ *
+ * Each core gets a budget of memory accesses per regulation period.
+ * Running tasks consume budget at their declared access rate; once a
+ * core exhausts its budget it is throttled (makes no progress) until
+ * the next period. Throttled time is accounted per core and per task.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef MEMGUARD_H
+#define MEMGUARD_H
+
+#include "scheduler.h"
+#include "smp.h"
+#include <stdint.h>
+
+/* ── Bandwidth partitioning policies ──────────────────────────────── */
+typedef enum {
+    MEMGUARD_PART_EVEN,         /* Equal share per core                */
+    MEMGUARD_PART_DEMAND        /* Proportional to declared demand     */
+} MemGuardPolicy;
+
+/* ── Per-core regulator ───────────────────────────────────────────── */
+struct MemGuard {
+    uint64_t  budget;           /* Accesses allowed per period         */
+    uint64_t  period;           /* Regulation period (ticks)           */
+    uint64_t  period_start;
+    uint64_t  used;             /* Accesses in the current period      */
+    bool      throttled;
+
+    /* Statistics */
+    uint64_t  total_accesses;
+    uint64_t  throttle_events;
+    uint64_t  throttled_ticks;
+    uint64_t  periods;
+};
+
+/* ── Public API ───────────────────────────────────────────────────── */
+
+/** Enable regulation on a core (replaces any previous settings). */
+void memguard_enable(Scheduler *sched, uint64_t budget, uint64_t period);
+
+/** Disable regulation and free the regulator. */
+void memguard_disable(Scheduler *sched);
+
+/** Declare a task's memory accesses per executed tick. */
+void memguard_set_task_rate(TaskControlBlock *task, uint32_t rate);
+
+/**
+ * Called by tick_handler for the tick just executed. Returns true if
+ * the core was throttled, i.e. the current task must not progress.
+ */
+bool memguard_tick(Scheduler *sched, TaskControlBlock *curr);
+
+/** Declared accesses per `period` ticks of all tasks on a core. */
+uint64_t memguard_core_demand(const Scheduler *sched, uint64_t period);
+
+/**
+ * Split `total_budget` accesses per `period` across all cores of an
+ * SMP system according to `policy`, enabling regulation on each.
+ */
+void memguard_partition(SmpSystem *sys, uint64_t total_budget,
+                        uint64_t period, MemGuardPolicy policy);
+
+/** Print per-core budgets, consumption and throttling statistics. */
+void memguard_print_report(const SmpSystem *sys);
+
+#endif /* MEMGUARD_H */
@@ -0,0 +1,253 @@
+/*
+ * mempool.c - Fixed-Block Memory Pool Implementation
+ *
+ * A waiter with a timeout is also on the scheduler's sleep queue. Which
+ * of the two wakes it decides the outcome: mempool_free() hands it a
+ * block and makes it READY (which takes it off the sleep queue), or the
+ * timeout makes it READY and task_set_state() calls
+ * mempool_cancel_wait() to take it off the pool's queue.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "mempool.h"
+#include "scheduler.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+/* ── Helpers ──────────────────────────────────────────────────────── */
+
+static void pool_wait_queue_insert(MemPool *pool, TaskControlBlock *task)
+{
+    /* Priority-ordered insertion, FIFO among equals */
+    int pos = pool->wait_count;
+    for (int i = 0; i < pool->wait_count; i++) {
+        if (task->priority < pool->wait_queue[i]->priority) {
+            pos = i;
+            break;
+        }
+    }
+    for (int i = pool->wait_count; i > pos; i--) {
+        pool->wait_queue[i] = pool->wait_queue[i - 1];
+        pool->wait_since[i] = pool->wait_since[i - 1];
+    }
+    pool->wait_queue[pos] = task;
+    pool->wait_since[pos] = pool->scheduler->system_ticks;
+    pool->wait_count++;
+}
+
+static void pool_wait_queue_remove_at(MemPool *pool, int pos)
+{
+    for (int i = pos; i < pool->wait_count - 1; i++) {
+        pool->wait_queue[i] = pool->wait_queue[i + 1];
+        pool->wait_since[i] = pool->wait_since[i + 1];
+    }
+    pool->wait_count--;
+}
+
+/* Index of `block`, or -1 if it is not a block boundary of this pool */
+static long block_index(const MemPool *pool, const void *block)
+{
+    const uint8_t *p = block;
+    if (p < pool->memory ||
+        p >= pool->memory + pool->stride * pool->block_count) {
+        return -1;
+    }
+    size_t off = (size_t)(p - pool->memory);
+    return (off % pool->stride) ? -1 : (long)(off / pool->stride);
+}
+
+/* ── Creation / Destruction ───────────────────────────────────────── */
+
+MemPool *mempool_create(Scheduler *sched, const char *name,
+                        size_t block_size, uint32_t block_count)
+{
+    if (!sched || block_size == 0 || block_count == 0) {
+        fprintf(stderr, "mempool_create: %s needs a block size and "
+                "count\n", name ? name : "(null)");
+        return NULL;
+    }
+
+    MemPool *pool = calloc(1, sizeof(MemPool));
+    if (!pool) return NULL;
+
+    /* Every block must hold the free-list link and stay aligned */
+    size_t align  = _Alignof(max_align_t);
+    size_t stride = block_size < sizeof(void *) ? sizeof(void *)
+                                                : block_size;
+    stride = (stride + align - 1) / align * align;
+
+    pool->memory = calloc(block_count, stride);
+    pool->in_use = calloc(block_count, 1);
+    if (!pool->memory || !pool->in_use) {
+        fprintf(stderr, "mempool_create: out of memory\n");
+        free(pool->memory);
+        free(pool->in_use);
+        free(pool);
+        return NULL;
+    }
+
+    snprintf(pool->name, MEMPOOL_NAME_MAX, "%s", name ? name : "pool");
+    pool->scheduler   = sched;
+    pool->block_size  = block_size;
+    pool->stride      = stride;
+    pool->block_count = block_count;
+
+    /* Chain the blocks in address order */
+    for (uint32_t i = block_count; i-- > 0; ) {
+        void *block = pool->memory + (size_t)i * stride;
+        *(void **)block = pool->free_list;
+        pool->free_list = block;
+    }
+    pool->free_count = block_count;
+    return pool;
+}
+
+void mempool_destroy(MemPool *pool)
+{
+    if (!pool) return;
+
+    while (pool->wait_count > 0) {
+        TaskControlBlock *t = pool->wait_queue[0];
+        pool_wait_queue_remove_at(pool, 0);
+        t->pool_wait  = NULL;
+        t->pool_block = NULL;
+        task_set_state(t, TASK_READY);
+    }
+    free(pool->memory);
+    free(pool->in_use);
+    free(pool);
+}
+
+/* ── Allocation ───────────────────────────────────────────────────── */
+
+void *mempool_alloc(MemPool *pool, TaskControlBlock *task,
+                    uint64_t timeout)
+{
+    if (!pool) return NULL;
+
+    if (pool->free_list) {
+        void *block = pool->free_list;
+        pool->free_list = *(void **)block;
+        pool->free_count--;
+        pool->in_use[block_index(pool, block)] = 1;
+        pool->allocs++;
+
+        uint32_t used = pool->block_count - pool->free_count;
+        if (used > pool->high_water) pool->high_water = used;
+        return block;
+    }
+
+    if (timeout == MEMPOOL_NO_WAIT || !task) {
+        pool->failures++;
+        return NULL;
+    }
+    if (pool->wait_count >= MEMPOOL_WAIT_QUEUE_CAP) {
+        fprintf(stderr, "mempool wait queue full for %s\n", pool->name);
+        pool->failures++;
+        return NULL;
+    }
+
+    /* Block until a free or the timeout */
+    Scheduler *sched = pool->scheduler;
+    task_set_state(task, TASK_BLOCKED);
+    task->pool_wait  = pool;
+    task->pool_block = NULL;
+    pool_wait_queue_insert(pool, task);
+    pool->waits++;
+    if (timeout != MEMPOOL_WAIT_FOREVER) {
+        task->wake_tick = sched->system_ticks + timeout;
+        sleep_queue_insert(sched, task);
+    }
+    scheduler_schedule(sched);
+    return NULL;
+}
+
+void *mempool_received(TaskControlBlock *task)
+{
+    if (!task) return NULL;
+    void *block = task->pool_block;
+    task->pool_block = NULL;
+    return block;
+}
+
+bool mempool_free(MemPool *pool, void *block)
+{
+    if (!pool || !block) return false;
+
+    long idx = block_index(pool, block);
+    if (idx < 0 || !pool->in_use[idx]) {
+        fprintf(stderr, "mempool_free: %s: %s block %p\n", pool->name,
+                idx < 0 ? "foreign" : "already free", block);
+        pool->bad_frees++;
+        return false;
+    }
+    pool->frees++;
+
+    /* Hand the block to the highest-priority waiter */
+    if (pool->wait_count > 0) {
+        TaskControlBlock *t = pool->wait_queue[0];
+        uint64_t waited = pool->scheduler->system_ticks -
+                          pool->wait_since[0];
+        pool_wait_queue_remove_at(pool, 0);
+        if (waited > pool->wait_max) pool->wait_max = waited;
+        pool->allocs++;
+        pool->handoffs++;
+
+        t->pool_wait  = NULL;
+        t->pool_block = block;
+        task_set_state(t, TASK_READY);
+        scheduler_schedule(pool->scheduler);
+        return true;
+    }
+
+    pool->in_use[idx] = 0;
+    *(void **)block = pool->free_list;
+    pool->free_list = block;
+    pool->free_count++;
+    return true;
+}
+
+uint32_t mempool_used(const MemPool *pool)
+{
+    return pool ? pool->block_count - pool->free_count : 0;
+}
+
+void mempool_cancel_wait(TaskControlBlock *task, bool timed_out)
+{
+    MemPool *pool = task ? task->pool_wait : NULL;
+    if (!pool) return;
+
+    for (int i = 0; i < pool->wait_count; i++) {
+        if (pool->wait_queue[i] == task) {
+            pool_wait_queue_remove_at(pool, i);
+            break;
+        }
+    }
+    task->pool_wait  = NULL;
+    task->pool_block = NULL;
+    if (timed_out) {
+        pool->timeouts++;
+        pool->failures++;
+    }
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+void mempool_print_report(const MemPool *pool)
+{
+    if (!pool) return;
+
+    printf("  Pool %-10s %3u x %3zu B (stride %zu): in use %u, high "
+           "water %u\n", pool->name, pool->block_count, pool->block_size,
+           pool->stride, mempool_used(pool), pool->high_water);
+    printf("    allocs %" PRIu64 ", frees %" PRIu64 ", waits %" PRIu64
+           " (%" PRIu64 " handed over, longest %" PRIu64 " ticks), "
+           "timeouts %" PRIu64 ", failures %" PRIu64 "\n", pool->allocs,
+           pool->frees, pool->waits, pool->handoffs, pool->wait_max,
+           pool->timeouts, pool->failures);
+}
@@ -0,0 +1,104 @@
+/*
+ * mempool.h - Fixed-Block Memory Pool
+ *
+ * A pool carves one allocation, made at creation, into equal blocks.
+ * Free blocks are chained through their own first bytes (an intrusive
+ * free list), so allocation and release are O(1) and never touch the
+ * heap. A task may wait for a block with a timeout: waiters queue by
+ * priority, a released block is handed straight to the highest-priority
+ * one, and a waiter whose timeout expires resumes empty-handed.
+ *
+ * Occupancy high-water mark, failures and waiting times are recorded so
+ * pools can be sized from a simulation run.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef MEMPOOL_H
+#define MEMPOOL_H
+
+#include "task.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* ── Forward declarations ─────────────────────────────────────────── */
+typedef struct Scheduler Scheduler;
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define MEMPOOL_NAME_MAX        32
+#define MEMPOOL_WAIT_QUEUE_CAP  16
+#define MEMPOOL_NO_WAIT         0
+#define MEMPOOL_WAIT_FOREVER    UINT64_MAX
+
+/* ── Pool structure ───────────────────────────────────────────────── */
+typedef struct MemPool {
+    char              name[MEMPOOL_NAME_MAX];
+    Scheduler        *scheduler;
+
+    uint8_t          *memory;
+    uint8_t          *in_use;       /* Per block, catches bad frees    */
+    size_t            block_size;   /* As requested                    */
+    size_t            stride;       /* Rounded up for alignment        */
+    uint32_t          block_count;
+    void             *free_list;
+    uint32_t          free_count;
+
+    TaskControlBlock *wait_queue[MEMPOOL_WAIT_QUEUE_CAP];
+    uint64_t          wait_since[MEMPOOL_WAIT_QUEUE_CAP];
+    int               wait_count;
+
+    /* Statistics */
+    uint32_t          high_water;   /* Most blocks in use at once      */
+    uint64_t          allocs;
+    uint64_t          frees;
+    uint64_t          failures;     /* Empty with no wait, or timed out */
+    uint64_t          waits;        /* Allocations that blocked        */
+    uint64_t          timeouts;
+    uint64_t          handoffs;     /* Freed straight to a waiter      */
+    uint64_t          wait_max;     /* Longest wait that got a block   */
+    uint64_t          bad_frees;
+} MemPool;
+
+/* ── Public API ───────────────────────────────────────────────────── */
+
+/** Create a pool of `block_count` blocks of `block_size` bytes. */
+MemPool *mempool_create(Scheduler *sched, const char *name,
+                        size_t block_size, uint32_t block_count);
+
+/** Destroy a pool. Tasks still waiting on it resume without a block. */
+void mempool_destroy(MemPool *pool);
+
+/**
+ * Allocate a block for `task`. If the pool is empty and `timeout` is
+ * nonzero, the task blocks (for at most `timeout` ticks, or forever with
+ * MEMPOOL_WAIT_FOREVER) and NULL is returned; once it runs again,
+ * mempool_received() tells whether a block was handed to it.
+ */
+void *mempool_alloc(MemPool *pool, TaskControlBlock *task,
+                    uint64_t timeout);
+
+/** The block handed to `task` while it waited (NULL after a timeout). */
+void *mempool_received(TaskControlBlock *task);
+
+/**
+ * Return a block: it goes to the highest-priority waiter, if any, or
+ * back on the free list. Foreign and double frees are rejected.
+ */
+bool mempool_free(MemPool *pool, void *block);
+
+/** Blocks currently allocated. */
+uint32_t mempool_used(const MemPool *pool);
+
+/**
+ * Stop `task` waiting on its pool (called by task_set_state when a
+ * waiter is made ready by its timeout or suspended). Only a wait that
+ * `timed_out` counts as a timeout and a failure.
+ */
+void mempool_cancel_wait(TaskControlBlock *task, bool timed_out);
+
+/** Print occupancy, high-water mark, failures and waits. */
+void mempool_print_report(const MemPool *pool);
+
+#endif /* MEMPOOL_H */
@@ -0,0 +1,427 @@
+/*
+ * mixcrit.c - Mixed-Criticality Scheduling (Adaptive Mixed Criticality)
+ *
+ * Runtime: budgets are monitored from tick_handler. LO jobs are stopped
+ * at their LO budget (AMC assumes budget enforcement); a HI job that
+ * uses its LO budget without completing triggers the switch to HI mode.
+ *
+ * Analysis (Baruah, Burns, Davis, RTSS 2011), fixed priorities, D <= T:
+ *   LO mode:  R(LO) = C(LO) + sum_{hp}  ceil(R/Tj) Cj(LO)
+ *   AMC-rtb:  R' = C(HI) + sum_{hpH} ceil(R'/Tj) Cj(HI)
+ *                        + sum_{hpL} ceil(R(LO)/Tk) Ck(LO)
+ *   AMC-max:  max over switch instants s < R(LO) of
+ *             C(HI) + sum_{hpL} (floor(s/Tk)+1) Ck(LO)
+ *                   + sum_{hpH} [M Cj(HI) + (ceil(R/Tj) - M) Cj(LO)]
+ *             M = min(ceil((R - s - (Tj - Dj))/Tj) + 1, ceil(R/Tj))
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "mixcrit.h"
+#include "timeline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+void mixcrit_enable(Scheduler *sched, McLoPolicy policy,
+                    uint32_t degrade_factor)
+{
+    if (!sched) return;
+
+    if (!sched->mixcrit) {
+        sched->mixcrit = calloc(1, sizeof(MixedCrit));
+        if (!sched->mixcrit) {
+            fprintf(stderr, "mixcrit_enable: out of memory\n");
+            return;
+        }
+    }
+
+    MixedCrit *mc = sched->mixcrit;
+    mc->mode           = MC_MODE_LO;
+    mc->lo_policy      = policy;
+    mc->degrade_factor = (degrade_factor >= 2) ? degrade_factor : 2;
+}
+
+void mixcrit_disable(Scheduler *sched)
+{
+    if (!sched) return;
+    free(sched->mixcrit);
+    sched->mixcrit = NULL;
+}
+
+void mixcrit_set_task(TaskControlBlock *task, CritLevel level,
+                      uint64_t wcet_lo, uint64_t wcet_hi)
+{
+    if (!task) return;
+
+    task->criticality = level;
+    task->wcet        = wcet_lo;
+    task->wcet_hi     = (level == CRIT_HI && wcet_hi > wcet_lo) ? wcet_hi
+                                                                : wcet_lo;
+
+    /* The first job was released by task_create() with the old wcet */
+    if (task->exec_time == 0) {
+        task->remaining_work = wcet_lo;
+    }
+}
+
+bool mixcrit_inject_overrun(Scheduler *sched, TaskControlBlock *task,
+                            uint32_t job, uint64_t demand)
+{
+    MixedCrit *mc = sched ? sched->mixcrit : NULL;
+    if (!mc || !task) return false;
+
+    if (mc->overrun_count >= MIXCRIT_MAX_OVERRUNS) {
+        fprintf(stderr, "mixcrit_inject_overrun: table full\n");
+        return false;
+    }
+    mc->overrun[mc->overrun_count++] = (McOverrun){ task, job, demand };
+
+    /* Job already released but not started */
+    if (task->invocations == job && task->exec_time == 0) {
+        task->remaining_work = demand;
+    }
+    return true;
+}
+
+/* ── Mode switches ────────────────────────────────────────────────── */
+
+static void record(Scheduler *sched, TaskControlBlock *task,
+                   const char *msg)
+{
+    if (sched->timeline) {
+        timeline_record(sched->timeline, sched->system_ticks, task,
+                        VIS_NONE, msg);
+    }
+}
+
+static void drop_job(TaskControlBlock *t)
+{
+    t->remaining_work = 0;
+    t->jobs_dropped++;
+    task_set_state(t, TASK_SUSPENDED);
+}
+
+static void switch_to_hi(Scheduler *sched, TaskControlBlock *trigger)
+{
+    MixedCrit *mc = sched->mixcrit;
+    char buf[ANNOTATION_MAX];
+
+    mc->mode = MC_MODE_HI;
+    mc->switches_to_hi++;
+    mc->last_switch_tick = sched->system_ticks;
+
+    snprintf(buf, sizeof(buf),
+             "MODE LO->HI: %s exceeded LO budget %" PRIu64,
+             trigger->name, trigger->wcet);
+    record(sched, trigger, buf);
+
+    if (mc->lo_policy != MC_LO_DROP) return;
+
+    for (int i = 0; i < sched->task_count; i++) {
+        TaskControlBlock *t = sched->all_tasks[i];
+        if (!t || t == sched->idle_task || t->criticality != CRIT_LO) {
+            continue;
+        }
+        if ((t->state == TASK_READY || t->state == TASK_RUNNING) &&
+            t->remaining_work > 0) {
+            drop_job(t);
+            mc->lo_jobs_dropped++;
+        }
+    }
+}
+
+static void switch_to_lo(Scheduler *sched)
+{
+    MixedCrit *mc = sched->mixcrit;
+    char buf[ANNOTATION_MAX];
+
+    mc->mode = MC_MODE_LO;
+    mc->switches_to_lo++;
+
+    snprintf(buf, sizeof(buf),
+             "MODE HI->LO: idle instant after %" PRIu64 " ticks in HI",
+             sched->system_ticks - mc->last_switch_tick);
+    record(sched, NULL, buf);
+    mc->last_switch_tick = sched->system_ticks;
+}
+
+/* ── Runtime hooks ────────────────────────────────────────────────── */
+
+bool mixcrit_admit_release(Scheduler *sched, TaskControlBlock *task)
+{
+    MixedCrit *mc = sched ? sched->mixcrit : NULL;
+    if (!mc || mc->mode == MC_MODE_LO || task->criticality == CRIT_HI) {
+        return true;
+    }
+
+    if (mc->lo_policy == MC_LO_DEGRADE &&
+        (task->invocations + task->jobs_dropped) % mc->degrade_factor == 0) {
+        return true;
+    }
+
+    task->jobs_dropped++;
+    mc->lo_jobs_dropped++;
+    return false;
+}
+
+void mixcrit_job_released(Scheduler *sched, TaskControlBlock *task)
+{
+    MixedCrit *mc = sched ? sched->mixcrit : NULL;
+    if (!mc) return;
+
+    for (int i = 0; i < mc->overrun_count; i++) {
+        if (mc->overrun[i].task == task &&
+            mc->overrun[i].job == task->invocations) {
+            task->remaining_work = mc->overrun[i].demand;
+            return;
+        }
+    }
+}
+
+void mixcrit_tick(Scheduler *sched, TaskControlBlock *curr)
+{
+    MixedCrit *mc = sched ? sched->mixcrit : NULL;
+    if (!mc) return;
+
+    if (mc->mode == MC_MODE_HI) {
+        mc->hi_mode_ticks++;
+        if ((!curr || curr == sched->idle_task) && sched->ready_count == 0) {
+            switch_to_lo(sched);
+            return;
+        }
+    }
+
+    if (!curr || curr == sched->idle_task ||
+        curr->state != TASK_RUNNING || curr->remaining_work == 0) {
+        return;
+    }
+
+    if (curr->criticality == CRIT_HI) {
+        if (mc->mode == MC_MODE_LO && curr->exec_time >= curr->wcet) {
+            switch_to_hi(sched, curr);
+        } else if (curr->exec_time >= curr->wcet_hi) {
+            /* Beyond its HI WCET: the analysis no longer holds */
+            fprintf(stderr, "mixcrit: %s exceeded HI WCET %" PRIu64 "\n",
+                    curr->name, curr->wcet_hi);
+            drop_job(curr);
+            mc->hi_overruns++;
+        }
+    } else if (curr->exec_time >= curr->wcet) {
+        mc->budget_aborts++;
+        mc->lo_jobs_dropped++;
+        drop_job(curr);
+        record(sched, curr, "LO job stopped at its budget");
+    }
+}
+
+/* ── Analysis ─────────────────────────────────────────────────────── */
+
+static bool analyzed(const Scheduler *sched, const TaskControlBlock *t)
+{
+    return t && t != sched->idle_task && t->period > 0;
+}
+
+/* Interference set: equal priorities are treated as higher */
+static bool interferes(const TaskControlBlock *j, const TaskControlBlock *i)
+{
+    return j != i && j->original_priority <= i->original_priority;
+}
+
+static uint64_t c_lo(const TaskControlBlock *t) { return t->wcet; }
+
+static uint64_t c_hi(const TaskControlBlock *t)
+{
+    return (t->criticality == CRIT_HI && t->wcet_hi > t->wcet) ? t->wcet_hi
+                                                               : t->wcet;
+}
+
+static uint64_t ceil_div(uint64_t a, uint64_t b)
+{
+    return (a + b - 1) / b;
+}
+
+static int64_t ceil_div_signed(int64_t a, int64_t b)
+{
+    return (a >= 0) ? (a + b - 1) / b : -((-a) / b);
+}
+
+static uint64_t rta_lo(const Scheduler *sched, const TaskControlBlock *ti)
+{
+    uint64_t r = c_lo(ti);
+    for (;;) {
+        uint64_t next = c_lo(ti);
+        for (int k = 0; k < sched->task_count; k++) {
+            const TaskControlBlock *tj = sched->all_tasks[k];
+            if (!analyzed(sched, tj) || !interferes(tj, ti)) continue;
+            next += ceil_div(r, tj->period) * c_lo(tj);
+        }
+        if (next == r || next > ti->relative_deadline) return next;
+        r = next;
+    }
+}
+
+static uint64_t amc_rtb(const Scheduler *sched, const TaskControlBlock *ti,
+                        uint64_t r_lo)
+{
+    uint64_t lo_term = 0;
+    for (int k = 0; k < sched->task_count; k++) {
+        const TaskControlBlock *tk = sched->all_tasks[k];
+        if (!analyzed(sched, tk) || !interferes(tk, ti) ||
+            tk->criticality != CRIT_LO) continue;
+        lo_term += ceil_div(r_lo, tk->period) * c_lo(tk);
+    }
+
+    uint64_t r = c_hi(ti) + lo_term;
+    for (;;) {
+        uint64_t next = c_hi(ti) + lo_term;
+        for (int k = 0; k < sched->task_count; k++) {
+            const TaskControlBlock *tj = sched->all_tasks[k];
+            if (!analyzed(sched, tj) || !interferes(tj, ti) ||
+                tj->criticality != CRIT_HI) continue;
+            next += ceil_div(r, tj->period) * c_hi(tj);
+        }
+        if (next == r || next > ti->relative_deadline) return next;
+        r = next;
+    }
+}
+
+/* AMC-max bound for a mode switch at instant s */
+static uint64_t amc_max_at(const Scheduler *sched,
+                           const TaskControlBlock *ti, uint64_t s)
+{
+    uint64_t lo_term = 0;
+    for (int k = 0; k < sched->task_count; k++) {
+        const TaskControlBlock *tk = sched->all_tasks[k];
+        if (!analyzed(sched, tk) || !interferes(tk, ti) ||
+            tk->criticality != CRIT_LO) continue;
+        lo_term += (s / tk->period + 1) * c_lo(tk);
+    }
+
+    uint64_t r = c_hi(ti) + lo_term;
+    for (;;) {
+        uint64_t next = c_hi(ti) + lo_term;
+        for (int k = 0; k < sched->task_count; k++) {
+            const TaskControlBlock *tj = sched->all_tasks[k];
+            if (!analyzed(sched, tj) || !interferes(tj, ti) ||
+                tj->criticality != CRIT_HI) continue;
+
+            int64_t jobs = (int64_t)ceil_div(r, tj->period);
+            int64_t m = ceil_div_signed((int64_t)r - (int64_t)s -
+                                        (int64_t)(tj->period -
+                                                  tj->relative_deadline),
+                                        (int64_t)tj->period) + 1;
+            if (m < 0)    m = 0;
+            if (m > jobs) m = jobs;
+            next += (uint64_t)m * c_hi(tj) + (uint64_t)(jobs - m) * c_lo(tj);
+        }
+        if (next == r || next > ti->relative_deadline) return next;
+        r = next;
+    }
+}
+
+static uint64_t amc_max(const Scheduler *sched, const TaskControlBlock *ti,
+                        uint64_t r_lo)
+{
+    /* Only LO releases change the bound: test s = 0 and each release
+       of a higher-priority LO task before R(LO) */
+    uint64_t worst = amc_max_at(sched, ti, 0);
+    for (int k = 0; k < sched->task_count; k++) {
+        const TaskControlBlock *tk = sched->all_tasks[k];
+        if (!analyzed(sched, tk) || !interferes(tk, ti) ||
+            tk->criticality != CRIT_LO) continue;
+        for (uint64_t s = tk->period; s < r_lo; s += tk->period) {
+            uint64_t r = amc_max_at(sched, ti, s);
+            if (r > worst) worst = r;
+        }
+    }
+    return worst;
+}
+
+bool mixcrit_response_times(const Scheduler *sched, McTest test,
+                            uint64_t *r_lo, uint64_t *r_hi)
+{
+    if (!sched) return false;
+
+    bool ok = true;
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *ti = sched->all_tasks[i];
+        uint64_t lo = 0, hi = 0;
+
+        if (analyzed(sched, ti)) {
+            lo = rta_lo(sched, ti);
+            if (lo > ti->relative_deadline) ok = false;
+
+            if (ti->criticality == CRIT_HI) {
+                hi = (test == MC_TEST_AMC_MAX) ? amc_max(sched, ti, lo)
+                                               : amc_rtb(sched, ti, lo);
+                if (hi > ti->relative_deadline) ok = false;
+            }
+        }
+        if (r_lo) r_lo[i] = lo;
+        if (r_hi) r_hi[i] = hi;
+    }
+    return ok;
+}
+
+bool mixcrit_schedulable(const Scheduler *sched, McTest test)
+{
+    return mixcrit_response_times(sched, test, NULL, NULL);
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+void mixcrit_print_report(const Scheduler *sched)
+{
+    if (!sched) return;
+
+    uint64_t r_lo[MAX_ALL_TASKS], r_rtb[MAX_ALL_TASKS], r_max[MAX_ALL_TASKS];
+    bool rtb_ok = mixcrit_response_times(sched, MC_TEST_AMC_RTB,
+                                         r_lo, r_rtb);
+    bool max_ok = mixcrit_response_times(sched, MC_TEST_AMC_MAX,
+                                         NULL, r_max);
+
+    printf("\n  %-10s %4s %4s %5s %5s %5s %5s %6s %6s %6s %6s %7s\n",
+           "Task", "Crit", "Prio", "T", "D", "C(LO)", "C(HI)",
+           "R(LO)", "R(rtb)", "R(max)", "Misses", "Dropped");
+    printf("  %-10s %4s %4s %5s %5s %5s %5s %6s %6s %6s %6s %7s\n",
+           "----", "----", "----", "-", "-", "-----", "-----",
+           "-----", "------", "------", "------", "-------");
+
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *t = sched->all_tasks[i];
+        if (!analyzed(sched, t)) continue;
+        bool hi = (t->criticality == CRIT_HI);
+
+        printf("  %-10s %4s %4d %5" PRIu64 " %5" PRIu64 " %5" PRIu64,
+               t->name, hi ? "HI" : "LO", t->original_priority,
+               t->period, t->relative_deadline, c_lo(t));
+        if (hi) {
+            printf(" %5" PRIu64 " %6" PRIu64 " %6" PRIu64 " %6" PRIu64,
+                   c_hi(t), r_lo[i], r_rtb[i], r_max[i]);
+        } else {
+            printf(" %5s %6" PRIu64 " %6s %6s", "-", r_lo[i], "-", "-");
+        }
+        printf(" %6u %7u\n", t->deadline_misses, t->jobs_dropped);
+    }
+
+    printf("\n  AMC-rtb: %s   AMC-max: %s\n",
+           rtb_ok ? "SCHEDULABLE" : "NOT schedulable",
+           max_ok ? "SCHEDULABLE" : "NOT schedulable");
+
+    const MixedCrit *mc = sched->mixcrit;
+    if (mc) {
+        printf("  Mode now %s; %u switches to HI, %u back to LO, "
+               "%" PRIu64 " ticks in HI mode\n",
+               mc->mode == MC_MODE_HI ? "HI" : "LO",
+               mc->switches_to_hi, mc->switches_to_lo, mc->hi_mode_ticks);
+        printf("  LO jobs dropped/skipped: %u (policy: %s); HI overruns "
+               "stopped: %u\n", mc->lo_jobs_dropped,
+               mc->lo_policy == MC_LO_DROP ? "drop" : "degrade",
+               mc->hi_overruns);
+    }
+}
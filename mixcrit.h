@@ -0,0 +1,127 @@
+/*
+ * mixcrit.h - Mixed-Criticality Scheduling (Adaptive Mixed Criticality)
+ *
+ * Dual-criticality fixed-priority scheduling after Baruah, Burns and
+ * Davis. Every task has a LO-level budget (its wcet) and HI tasks also
+ * a larger HI-level WCET. The core starts in LO mode; when a HI job
+ * executes for its LO budget without completing, the core switches to
+ * HI mode and LO tasks are dropped or degraded. The core returns to LO
+ * mode at the next idle instant. AMC-rtb and AMC-max response-time
+ * analyses are provided.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef MIXCRIT_H
+#define MIXCRIT_H
+
+#include "scheduler.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define MIXCRIT_MAX_OVERRUNS  16
+
+/* ── Criticality levels and modes ─────────────────────────────────── */
+typedef enum {
+    CRIT_LO = 0,
+    CRIT_HI = 1
+} CritLevel;
+
+typedef enum {
+    MC_MODE_LO,
+    MC_MODE_HI
+} McMode;
+
+/* What happens to LO tasks in HI mode */
+typedef enum {
+    MC_LO_DROP,         /* Abandon active LO jobs, no LO releases       */
+    MC_LO_DEGRADE       /* Release LO tasks only every k-th period      */
+} McLoPolicy;
+
+/* Response-time test for HI tasks across the mode switch */
+typedef enum {
+    MC_TEST_AMC_RTB,
+    MC_TEST_AMC_MAX
+} McTest;
+
+/* Scripted execution demand for one job (fault injection) */
+typedef struct {
+    TaskControlBlock *task;
+    uint32_t          job;          /* Value of task->invocations      */
+    uint64_t          demand;       /* Ticks this job actually needs   */
+} McOverrun;
+
+/* ── Per-core mode state ──────────────────────────────────────────── */
+struct MixedCrit {
+    McMode       mode;
+    McLoPolicy   lo_policy;
+    uint32_t     degrade_factor;    /* k for MC_LO_DEGRADE             */
+
+    McOverrun    overrun[MIXCRIT_MAX_OVERRUNS];
+    int          overrun_count;
+
+    /* Statistics */
+    uint32_t     switches_to_hi;
+    uint32_t     switches_to_lo;
+    uint64_t     last_switch_tick;
+    uint64_t     hi_mode_ticks;
+    uint32_t     lo_jobs_dropped;
+    uint32_t     budget_aborts;     /* LO jobs stopped at their budget */
+    uint32_t     hi_overruns;       /* HI jobs stopped past wcet_hi    */
+};
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+/** Enable AMC on a core (starts in LO mode). `degrade_factor` >= 2. */
+void mixcrit_enable(Scheduler *sched, McLoPolicy policy,
+                    uint32_t degrade_factor);
+
+/** Disable AMC and free the mode state. */
+void mixcrit_disable(Scheduler *sched);
+
+/**
+ * Set a task's criticality and per-level WCETs. The LO budget becomes
+ * the task's wcet; `wcet_hi` is ignored for LO tasks.
+ */
+void mixcrit_set_task(TaskControlBlock *task, CritLevel level,
+                      uint64_t wcet_lo, uint64_t wcet_hi);
+
+/** Make job number `job` of `task` need `demand` ticks of execution. */
+bool mixcrit_inject_overrun(Scheduler *sched, TaskControlBlock *task,
+                            uint32_t job, uint64_t demand);
+
+/* ── Runtime hooks (called from rtos_time.c) ──────────────────────── */
+
+/** False if a LO task's release must be skipped in HI mode. */
+bool mixcrit_admit_release(Scheduler *sched, TaskControlBlock *task);
+
+/** Apply any scripted demand to a freshly released job. */
+void mixcrit_job_released(Scheduler *sched, TaskControlBlock *task);
+
+/**
+ * Budget monitoring for the tick just executed: triggers the LO->HI
+ * switch on a HI overrun, enforces LO budgets, and returns to LO mode
+ * when the core is idle.
+ */
+void mixcrit_tick(Scheduler *sched, TaskControlBlock *curr);
+
+/* ── Analysis ─────────────────────────────────────────────────────── */
+
+/**
+ * Response times of every task (indexed like sched->all_tasks).
+ * `r_lo` gets the LO-mode bound; `r_hi` the bound across the switch
+ * for HI tasks under `test` (0 for LO tasks). Returns true if every
+ * bound meets its deadline.
+ */
+bool mixcrit_response_times(const Scheduler *sched, McTest test,
+                            uint64_t *r_lo, uint64_t *r_hi);
+
+/** True if the task set passes `test`. */
+bool mixcrit_schedulable(const Scheduler *sched, McTest test);
+
+/** Print per-task criticality, budgets, AMC bounds and runtime stats. */
+void mixcrit_print_report(const Scheduler *sched);
+
+#endif /* MIXCRIT_H */
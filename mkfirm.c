@@ -0,0 +1,255 @@
+/*
+ * mkfirm.c - (m,k)-Firm Deadline Scheduling
+ *
+ * Each task keeps the outcomes of its last k jobs as a bit history.
+ * DBP priority = distance * MK_PRIO_STRIDE + base priority, where the
+ * distance is the number of consecutive misses that still leave m met
+ * jobs in the window; tasks at distance 0 outrank everything else.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "mkfirm.h"
+#include "timeline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+/* ── Helpers ──────────────────────────────────────────────────────── */
+
+static bool has_mk(const TaskControlBlock *t)
+{
+    return t && t->mk_k > 0;
+}
+
+static uint32_t window_mask(uint8_t k)
+{
+    return (k >= 32) ? 0xFFFFFFFFu : ((1u << k) - 1u);
+}
+
+static int bit_count(uint32_t v)
+{
+    int n = 0;
+    while (v) {
+        v &= v - 1;
+        n++;
+    }
+    return n;
+}
+
+int mkfirm_distance(const TaskControlBlock *task)
+{
+    if (!has_mk(task)) return MK_MAX_DISTANCE;
+
+    uint32_t mask = window_mask(task->mk_k);
+    for (int l = 1; l <= task->mk_k; l++) {
+        uint32_t h = (task->mk_history << l) & mask;
+        if (bit_count(h) < task->mk_m) return l - 1;
+    }
+    return task->mk_k;
+}
+
+static int dbp_priority(const TaskControlBlock *t)
+{
+    int dist = mkfirm_distance(t);
+    int base = t->original_priority;
+    if (dist > MK_MAX_DISTANCE)    dist = MK_MAX_DISTANCE;
+    if (base >= MK_PRIO_STRIDE)    base = MK_PRIO_STRIDE - 1;
+    return dist * MK_PRIO_STRIDE + base;
+}
+
+static void update_priority(Scheduler *sched, TaskControlBlock *t)
+{
+    if (sched->mkfirm->policy == MK_PRIO_DBP) {
+        task_set_priority(t, dbp_priority(t));
+    }
+}
+
+/* Shift one job outcome into the history and check the constraint */
+static void record_outcome(Scheduler *sched, TaskControlBlock *t, bool met)
+{
+    MkFirmState *mk = sched->mkfirm;
+
+    t->mk_last_job = t->invocations;
+    t->mk_history  = ((t->mk_history << 1) | (met ? 1u : 0u)) &
+                     window_mask(t->mk_k);
+
+    if (bit_count(t->mk_history) < t->mk_m) {
+        t->mk_violations++;
+        mk->violations++;
+        if (sched->timeline) {
+            char buf[ANNOTATION_MAX];
+            snprintf(buf, sizeof(buf),
+                     "(m,k) VIOLATION: %s has fewer than %u of %u met",
+                     t->name, t->mk_m, t->mk_k);
+            timeline_record(sched->timeline, sched->system_ticks, t,
+                            VIS_NONE, buf);
+        }
+    }
+    update_priority(sched, t);
+}
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+void mkfirm_enable(Scheduler *sched, MkPolicy policy, bool skip)
+{
+    if (!sched) return;
+
+    if (!sched->mkfirm) {
+        sched->mkfirm = calloc(1, sizeof(MkFirmState));
+        if (!sched->mkfirm) {
+            fprintf(stderr, "mkfirm_enable: out of memory\n");
+            return;
+        }
+    }
+    sched->mkfirm->policy = policy;
+    sched->mkfirm->skip   = skip;
+}
+
+void mkfirm_disable(Scheduler *sched)
+{
+    if (!sched || !sched->mkfirm) return;
+
+    for (int i = 0; i < sched->task_count; i++) {
+        TaskControlBlock *t = sched->all_tasks[i];
+        if (has_mk(t)) task_set_priority(t, t->original_priority);
+    }
+    free(sched->mkfirm);
+    sched->mkfirm = NULL;
+}
+
+bool mkfirm_set_constraint(TaskControlBlock *task, uint8_t m, uint8_t k)
+{
+    if (!task || m < 1 || m > k || k > MK_MAX_K) {
+        fprintf(stderr, "mkfirm_set_constraint: invalid (m,k)\n");
+        return false;
+    }
+    if (task->original_priority >= MK_PRIO_STRIDE) {
+        fprintf(stderr, "mkfirm_set_constraint: %s base priority %d "
+                "must be below %d\n", task->name, task->original_priority,
+                MK_PRIO_STRIDE);
+        return false;
+    }
+
+    task->mk_m        = m;
+    task->mk_k        = k;
+    task->mk_history  = window_mask(k);     /* Assume k met jobs */
+    task->mk_last_job = 0;
+
+    Scheduler *sched = task->scheduler;
+    if (sched && sched->mkfirm) update_priority(sched, task);
+    return true;
+}
+
+/* ── Runtime hooks ────────────────────────────────────────────────── */
+
+bool mkfirm_job_released(Scheduler *sched, TaskControlBlock *task)
+{
+    MkFirmState *mk = sched ? sched->mkfirm : NULL;
+    if (!mk || !has_mk(task)) return true;
+
+    update_priority(sched, task);
+    if (!mk->skip || mkfirm_distance(task) == 0) return true;
+
+    /* Work that runs before this job: its own plus every ready job of
+       equal or higher priority */
+    uint64_t demand = task->remaining_work;
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *t = sched->all_tasks[i];
+        if (!t || t == task || t == sched->idle_task) continue;
+        if ((t->state == TASK_READY || t->state == TASK_RUNNING) &&
+            t->priority <= task->priority) {
+            demand += t->remaining_work;
+        }
+    }
+    if (sched->system_ticks + demand <= task->absolute_deadline) {
+        return true;
+    }
+
+    /* Cannot finish in time and the constraint can spare it: skip */
+    task->remaining_work = 0;
+    task->mk_skipped++;
+    mk->jobs_skipped++;
+    if (sched->timeline) {
+        char buf[ANNOTATION_MAX];
+        snprintf(buf, sizeof(buf), "%s job %u skipped (distance %d)",
+                 task->name, task->invocations, mkfirm_distance(task));
+        timeline_record(sched->timeline, sched->system_ticks, task,
+                        VIS_NONE, buf);
+    }
+    record_outcome(sched, task, false);
+    return false;
+}
+
+void mkfirm_tick(Scheduler *sched, TaskControlBlock *curr)
+{
+    MkFirmState *mk = sched ? sched->mkfirm : NULL;
+    if (!mk) return;
+
+    /* A job that completed this tick met its deadline (late jobs are
+       aborted below before they can complete) */
+    if (has_mk(curr) && curr->state == TASK_RUNNING &&
+        curr->remaining_work == 0 && curr->mk_last_job != curr->invocations) {
+        curr->mk_met++;
+        mk->jobs_met++;
+        record_outcome(sched, curr, true);
+    }
+
+    for (int i = 0; i < sched->task_count; i++) {
+        TaskControlBlock *t = sched->all_tasks[i];
+        if (!has_mk(t) || t->mk_last_job == t->invocations) continue;
+        if ((t->state != TASK_READY && t->state != TASK_RUNNING) ||
+            t->remaining_work == 0 ||
+            sched->system_ticks < t->absolute_deadline) {
+            continue;
+        }
+
+        /* Firm deadline reached with work left: the result would be
+           useless, abort the job */
+        t->deadline_misses++;
+        t->mk_missed++;
+        mk->jobs_missed++;
+        if (sched->timeline) {
+            timeline_record_deadline_miss(sched->timeline,
+                                          sched->system_ticks, t,
+                                          t->absolute_deadline,
+                                          sched->system_ticks);
+        }
+        t->remaining_work = 0;
+        task_set_state(t, TASK_SUSPENDED);
+        record_outcome(sched, t, false);
+    }
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+void mkfirm_print_report(const Scheduler *sched)
+{
+    const MkFirmState *mk = sched ? sched->mkfirm : NULL;
+    if (!mk) return;
+
+    printf("\n  %-8s %6s %5s %5s %6s %7s %10s\n",
+           "Task", "(m,k)", "Jobs", "Met", "Missed", "Skipped",
+           "Violations");
+    printf("  %-8s %6s %5s %5s %6s %7s %10s\n",
+           "----", "-----", "----", "---", "------", "-------",
+           "----------");
+
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *t = sched->all_tasks[i];
+        if (!has_mk(t)) continue;
+        char mkbuf[16];
+        snprintf(mkbuf, sizeof(mkbuf), "(%u,%u)", t->mk_m, t->mk_k);
+        printf("  %-8s %6s %5u %5u %6u %7u %10u\n",
+               t->name, mkbuf, t->mk_met + t->mk_missed + t->mk_skipped,
+               t->mk_met, t->mk_missed, t->mk_skipped, t->mk_violations);
+    }
+
+    printf("  Policy %s%s: %u met, %u missed, %u skipped, %u violations\n",
+           mk->policy == MK_PRIO_DBP ? "DBP" : "fixed",
+           mk->skip ? " + skipping" : "",
+           mk->jobs_met, mk->jobs_missed, mk->jobs_skipped,
+           mk->violations);
+}
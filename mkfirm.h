@@ -0,0 +1,82 @@
+/*
+ * mkfirm.h - (m,k)-Firm Deadline Scheduling
+ *
+ * A task with an (m,k) constraint must meet at least m deadlines in
+ * any k consecutive jobs. Deadlines are firm: a job still unfinished
+ * at its deadline is aborted. The Distance-Based Priority policy
+ * (Hamdaoui & Ramanathan) raises tasks that are few misses away from
+ * violating their constraint; optional job skipping drops jobs that
+ * cannot meet their deadline while the constraint can spare them.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef MKFIRM_H
+#define MKFIRM_H
+
+#include "scheduler.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define MK_MAX_K           32      /* History window is one uint32_t  */
+#define MK_PRIO_STRIDE     16      /* Base priorities must be < this  */
+#define MK_MAX_DISTANCE    14      /* Keeps DBP priorities below idle */
+
+/* ── Priority policies ────────────────────────────────────────────── */
+typedef enum {
+    MK_PRIO_FIXED,      /* Keep base priorities, only track (m,k)     */
+    MK_PRIO_DBP         /* Distance-based priority                    */
+} MkPolicy;
+
+/* ── Per-core state ───────────────────────────────────────────────── */
+struct MkFirmState {
+    MkPolicy  policy;
+    bool      skip;             /* Skip jobs that cannot make it       */
+
+    /* Totals over all (m,k) tasks */
+    uint32_t  jobs_met;
+    uint32_t  jobs_missed;
+    uint32_t  jobs_skipped;
+    uint32_t  violations;
+};
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+/** Enable (m,k)-firm handling on a core. */
+void mkfirm_enable(Scheduler *sched, MkPolicy policy, bool skip);
+
+/** Disable and free the state (priorities are restored). */
+void mkfirm_disable(Scheduler *sched);
+
+/**
+ * Give a task an (m,k) constraint (1 <= m <= k <= MK_MAX_K). Its
+ * history starts as k met jobs; its priority becomes the DBP base.
+ */
+bool mkfirm_set_constraint(TaskControlBlock *task, uint8_t m, uint8_t k);
+
+/**
+ * Number of consecutive misses the task can still absorb before it
+ * violates its constraint (0 = the next miss violates).
+ */
+int mkfirm_distance(const TaskControlBlock *task);
+
+/* ── Runtime hooks ────────────────────────────────────────────────── */
+
+/**
+ * Apply the DBP priority to a job being released. Returns false if the
+ * job is skipped instead (it then stays SUSPENDED).
+ */
+bool mkfirm_job_released(Scheduler *sched, TaskControlBlock *task);
+
+/**
+ * Called by tick_handler before the deadline check: records met jobs
+ * and aborts jobs whose firm deadline has passed.
+ */
+void mkfirm_tick(Scheduler *sched, TaskControlBlock *curr);
+
+/** Print per-task (m,k) outcomes and violation counts. */
+void mkfirm_print_report(const Scheduler *sched);
+
+#endif /* MKFIRM_H */
@@ -0,0 +1,307 @@
+/*
+ * modechange.c - Runtime Mode Changes
+ *
+ * Parked tasks are SUSPENDED with next_release = UINT64_MAX, so the
+ * regular periodic release path never picks them up. Activating a task
+ * sets its next release to the switch tick; check_periodic_releases()
+ * then releases every new-mode task in that same tick.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "modechange.h"
+#include "timeline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+/* ── Helpers ──────────────────────────────────────────────────────── */
+
+static bool in_mode(const TaskControlBlock *t, int mode)
+{
+    return t->mode_mask == MODE_ALL || (t->mode_mask >> mode) & 1u;
+}
+
+static bool managed(const Scheduler *sched, const TaskControlBlock *t)
+{
+    return t && t != sched->idle_task && t->state != TASK_TERMINATED;
+}
+
+static uint32_t total_misses(const Scheduler *sched)
+{
+    uint32_t misses = 0;
+    for (int i = 0; i < sched->task_count; i++) {
+        misses += sched->all_tasks[i]->deadline_misses;
+    }
+    return misses;
+}
+
+static const char *mode_name(const ModeManager *mm, int mode)
+{
+    return mm->name[mode][0] ? mm->name[mode] : "?";
+}
+
+static void park(TaskControlBlock *t)
+{
+    t->next_release   = UINT64_MAX;
+    t->remaining_work = 0;
+    task_set_state(t, TASK_SUSPENDED);
+}
+
+static void activate(Scheduler *sched, TaskControlBlock *t)
+{
+    if (t->period > 0) {
+        t->next_release = sched->system_ticks;  /* Released this tick */
+    } else if (t->state == TASK_SUSPENDED) {
+        t->exec_time         = 0;
+        t->remaining_work    = t->wcet;
+        t->absolute_deadline = t->relative_deadline
+                             ? sched->system_ticks + t->relative_deadline
+                             : 0;
+        t->invocations++;
+        task_set_state(t, TASK_READY);
+    }
+}
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+void modechange_enable(Scheduler *sched, int initial_mode)
+{
+    if (!sched || initial_mode < 0 || initial_mode >= MODE_MAX) return;
+
+    if (!sched->modes) {
+        sched->modes = calloc(1, sizeof(ModeManager));
+        if (!sched->modes) {
+            fprintf(stderr, "modechange_enable: out of memory\n");
+            return;
+        }
+    }
+    sched->modes->current = initial_mode;
+
+    for (int i = 0; i < sched->task_count; i++) {
+        TaskControlBlock *t = sched->all_tasks[i];
+        if (managed(sched, t) && !in_mode(t, initial_mode)) park(t);
+    }
+}
+
+void modechange_disable(Scheduler *sched)
+{
+    if (!sched) return;
+    free(sched->modes);
+    sched->modes = NULL;
+}
+
+void modechange_define_mode(Scheduler *sched, int mode, const char *name)
+{
+    if (!sched || !sched->modes || mode < 0 || mode >= MODE_MAX) return;
+    snprintf(sched->modes->name[mode], MODE_NAME_MAX, "%s", name);
+}
+
+void modechange_set_task_modes(TaskControlBlock *task, uint32_t mask)
+{
+    if (!task) return;
+    task->mode_mask = mask;
+
+    Scheduler *sched = task->scheduler;
+    if (sched && sched->modes && managed(sched, task) &&
+        !in_mode(task, sched->modes->current)) {
+        park(task);
+    }
+}
+
+/* ── Requests ─────────────────────────────────────────────────────── */
+
+uint64_t modechange_safe_offset(const Scheduler *sched, int mode)
+{
+    if (!sched || !sched->modes) return 0;
+
+    uint64_t offset = 0;
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *t = sched->all_tasks[i];
+        if (!managed(sched, t)) continue;
+        if (in_mode(t, sched->modes->current) && !in_mode(t, mode) &&
+            t->relative_deadline > offset) {
+            offset = t->relative_deadline;
+        }
+    }
+    return offset;
+}
+
+bool modechange_request(Scheduler *sched, int mode, ModeProtocol protocol,
+                        uint64_t offset)
+{
+    ModeManager *mm = sched ? sched->modes : NULL;
+    if (!mm || mode < 0 || mode >= MODE_MAX) return false;
+    if (mm->pending) {
+        fprintf(stderr, "modechange_request: switch to %s still pending\n",
+                mode_name(mm, mm->target));
+        return false;
+    }
+    if (mm->history_count >= MODE_HISTORY_MAX) {
+        fprintf(stderr, "modechange_request: history full\n");
+        return false;
+    }
+
+    /* Close the settle window of the previous transition early */
+    if (mm->history_count > 0) {
+        ModeTransition *prev = &mm->history[mm->history_count - 1];
+        if (prev->switched && !prev->settled) {
+            prev->misses_settle = total_misses(sched) - mm->misses_mark;
+            prev->settle_tick   = sched->system_ticks;
+            prev->settled       = true;
+        }
+    }
+
+    /* Retire old-mode tasks: the active job completes, no new releases */
+    for (int i = 0; i < sched->task_count; i++) {
+        TaskControlBlock *t = sched->all_tasks[i];
+        if (managed(sched, t) && in_mode(t, mm->current) &&
+            !in_mode(t, mode)) {
+            t->next_release = UINT64_MAX;
+        }
+    }
+
+    mm->pending   = true;
+    mm->target    = mode;
+    mm->protocol  = protocol;
+    mm->switch_at = sched->system_ticks + offset;
+    mm->misses_mark = total_misses(sched);
+
+    ModeTransition *tr = &mm->history[mm->history_count++];
+    *tr = (ModeTransition){ .from = mm->current, .to = mode,
+                            .protocol = protocol,
+                            .request_tick = sched->system_ticks };
+
+    if (sched->timeline) {
+        char buf[ANNOTATION_MAX];
+        snprintf(buf, sizeof(buf), "MODE CHANGE requested: %s -> %s (%s)",
+                 mode_name(mm, mm->current), mode_name(mm, mode),
+                 protocol == MODE_PROTO_IDLE ? "idle-time" : "offset");
+        timeline_record(sched->timeline, sched->system_ticks, NULL,
+                        VIS_NONE, buf);
+    }
+    return true;
+}
+
+bool modechange_pending(const Scheduler *sched)
+{
+    return sched && sched->modes && sched->modes->pending;
+}
+
+/* ── Switching ────────────────────────────────────────────────────── */
+
+static bool retiring_active(const Scheduler *sched)
+{
+    const ModeManager *mm = sched->modes;
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *t = sched->all_tasks[i];
+        if (!managed(sched, t) || in_mode(t, mm->target)) continue;
+        if (t->state != TASK_SUSPENDED && t->remaining_work > 0) return true;
+    }
+    return false;
+}
+
+static void complete_switch(Scheduler *sched)
+{
+    ModeManager    *mm = sched->modes;
+    ModeTransition *tr = &mm->history[mm->history_count - 1];
+    int             from = mm->current;
+    uint64_t        longest = 0;
+
+    for (int i = 0; i < sched->task_count; i++) {
+        TaskControlBlock *t = sched->all_tasks[i];
+        if (!managed(sched, t) || !in_mode(t, mm->target)) continue;
+        if (!in_mode(t, from)) activate(sched, t);
+        if (t->period > longest) longest = t->period;
+    }
+
+    mm->current = mm->target;
+    mm->pending = false;
+
+    uint32_t misses = total_misses(sched);
+    tr->switch_tick   = sched->system_ticks;
+    tr->settle_tick   = sched->system_ticks + longest;
+    tr->misses_during = misses - mm->misses_mark;
+    tr->switched      = true;
+    mm->misses_mark   = misses;
+
+    if (sched->timeline) {
+        char buf[ANNOTATION_MAX];
+        snprintf(buf, sizeof(buf),
+                 "MODE CHANGE %s -> %s (latency %" PRIu64 " ticks)",
+                 mode_name(mm, from), mode_name(mm, mm->current),
+                 tr->switch_tick - tr->request_tick);
+        timeline_record(sched->timeline, sched->system_ticks, NULL,
+                        VIS_NONE, buf);
+    }
+}
+
+void modechange_tick(Scheduler *sched)
+{
+    ModeManager *mm = sched ? sched->modes : NULL;
+    if (!mm) return;
+
+    if (mm->history_count > 0) {
+        ModeTransition *last = &mm->history[mm->history_count - 1];
+        if (last->switched && !last->settled &&
+            sched->system_ticks >= last->settle_tick) {
+            last->misses_settle = total_misses(sched) - mm->misses_mark;
+            last->settled       = true;
+        }
+    }
+
+    if (!mm->pending) return;
+
+    bool safe;
+    if (mm->protocol == MODE_PROTO_IDLE) {
+        /* Idle instant: the core idled through the last tick and no
+           retiring job is left anywhere (ready, running or blocked) */
+        TaskControlBlock *curr = sched->current_task;
+        safe = (!curr || curr == sched->idle_task) &&
+               sched->ready_count == 0 && !retiring_active(sched);
+    } else {
+        safe = sched->system_ticks >= mm->switch_at;
+    }
+
+    if (safe) complete_switch(sched);
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+void modechange_print_report(const Scheduler *sched)
+{
+    const ModeManager *mm = sched ? sched->modes : NULL;
+    if (!mm) return;
+
+    printf("\n  %-22s %-9s %7s %7s %7s %7s %7s\n",
+           "Transition", "Protocol", "Request", "Switch", "Latency",
+           "Misses", "Settle");
+    printf("  %-22s %-9s %7s %7s %7s %7s %7s\n",
+           "----------", "--------", "-------", "------", "-------",
+           "------", "------");
+
+    for (int i = 0; i < mm->history_count; i++) {
+        const ModeTransition *tr = &mm->history[i];
+        char label[48];
+        snprintf(label, sizeof(label), "%s -> %s",
+                 mode_name(mm, tr->from), mode_name(mm, tr->to));
+
+        printf("  %-22s %-9s %7" PRIu64, label,
+               tr->protocol == MODE_PROTO_IDLE ? "idle" : "offset",
+               tr->request_tick);
+        if (tr->switched) {
+            /* Settle misses are provisional until the window closes */
+            uint32_t settle = tr->settled
+                            ? tr->misses_settle
+                            : total_misses(sched) - mm->misses_mark;
+            printf(" %7" PRIu64 " %7" PRIu64 " %7u %7u\n",
+                   tr->switch_tick, tr->switch_tick - tr->request_tick,
+                   tr->misses_during, settle);
+        } else {
+            printf(" %7s %7s %7s %7s\n", "-", "-", "-", "-");
+        }
+    }
+    printf("  Current mode: %s\n", mode_name(mm, mm->current));
+}
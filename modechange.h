@@ -0,0 +1,107 @@
+/*
+ * modechange.h - Runtime Mode Changes
+ *
+ * A core can run one of several operating modes (e.g. cruise, parking).
+ * Each task belongs to a set of modes. A mode-change request retires
+ * the tasks that are not part of the new mode and releases the new
+ * mode's tasks together at a safe instant, without re-initializing the
+ * scheduler. Tasks present in both modes are unaffected.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef MODECHANGE_H
+#define MODECHANGE_H
+
+#include "scheduler.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define MODE_MAX            32      /* One bit per mode in a task mask */
+#define MODE_NAME_MAX       16
+#define MODE_HISTORY_MAX    16
+#define MODE_ALL            0u      /* Task mask: member of every mode */
+
+/* ── Transition protocols ─────────────────────────────────────────── */
+typedef enum {
+    MODE_PROTO_IDLE,        /* Switch at the first idle instant        */
+    MODE_PROTO_OFFSET       /* Switch a fixed offset after the request */
+} ModeProtocol;
+
+/* One completed (or pending) transition */
+typedef struct {
+    int           from;
+    int           to;
+    ModeProtocol  protocol;
+    uint64_t      request_tick;
+    uint64_t      switch_tick;
+    uint64_t      settle_tick;       /* switch + longest new period     */
+    uint32_t      misses_during;     /* Between request and switch      */
+    uint32_t      misses_settle;     /* Between switch and settle       */
+    bool          switched;
+    bool          settled;
+} ModeTransition;
+
+/* ── Per-core mode state ──────────────────────────────────────────── */
+struct ModeManager {
+    int             current;
+    char            name[MODE_MAX][MODE_NAME_MAX];
+
+    /* Pending request */
+    bool            pending;
+    int             target;
+    ModeProtocol    protocol;
+    uint64_t        switch_at;       /* MODE_PROTO_OFFSET only          */
+
+    ModeTransition  history[MODE_HISTORY_MAX];
+    int             history_count;
+    uint32_t        misses_mark;     /* Total misses at last event      */
+};
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+/** Enable mode management; tasks outside `initial_mode` are parked. */
+void modechange_enable(Scheduler *sched, int initial_mode);
+
+/** Free the mode state (all tasks keep their current state). */
+void modechange_disable(Scheduler *sched);
+
+/** Name a mode for reports. */
+void modechange_define_mode(Scheduler *sched, int mode, const char *name);
+
+/**
+ * Set the modes a task belongs to (bit n = mode n, MODE_ALL = every
+ * mode). A task outside the current mode is parked immediately.
+ */
+void modechange_set_task_modes(TaskControlBlock *task, uint32_t mask);
+
+/* ── Mode-change requests ─────────────────────────────────────────── */
+
+/**
+ * Request a switch to `mode`. Retiring tasks are not released again;
+ * their active jobs run to completion. New-mode tasks are released
+ * together at the first idle instant (MODE_PROTO_IDLE) or `offset`
+ * ticks after the request (MODE_PROTO_OFFSET). Returns false if a
+ * request is already pending.
+ */
+bool modechange_request(Scheduler *sched, int mode, ModeProtocol protocol,
+                        uint64_t offset);
+
+/**
+ * Smallest offset that guarantees all retiring jobs have finished:
+ * the longest deadline among tasks leaving the current mode.
+ */
+uint64_t modechange_safe_offset(const Scheduler *sched, int mode);
+
+/** Called by tick_handler before releases: completes pending switches. */
+void modechange_tick(Scheduler *sched);
+
+/** True if a request is waiting for its switch instant. */
+bool modechange_pending(const Scheduler *sched);
+
+/** Print the transition history with latencies and deadline misses. */
+void modechange_print_report(const Scheduler *sched);
+
+#endif /* MODECHANGE_H */
@@ -11,6 +11,7 @@
 #include "mutex.h"
 #include "scheduler.h"
 #include "timeline.h"
+#include "waitany.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -18,11 +19,11 @@
 
 /* ── Wait-queue helpers (priority-ordered) ────────────────────────── */
 
-static void wait_queue_insert(Mutex *mtx, TaskControlBlock *task)
+static bool wait_queue_insert(Mutex *mtx, TaskControlBlock *task)
 {
     if (mtx->wait_count >= MUTEX_WAIT_QUEUE_CAP) {
         fprintf(stderr, "mutex wait queue full for %s\n", mtx->name);
-        return;
+        return false;
     }
 
     /* Insert in priority order (lowest number = highest priority first) */
@@ -38,6 +39,7 @@ static void wait_queue_insert(Mutex *mtx, TaskControlBlock *task)
     }
     mtx->wait_queue[pos] = task;
     mtx->wait_count++;
+    return true;
 }
 
 static TaskControlBlock *wait_queue_pop(Mutex *mtx)
@@ -250,7 +252,8 @@ void mutex_unlock(Mutex *mtx, TaskControlBlock *task)
         mtx->owner = waiter;
         task_add_held_mutex(waiter, mtx);
 
-        /* Waiter becomes READY */
+        /* Waiter becomes READY (leaving any other objects it waited on) */
+        if (waiter->wait_set) wait_any_wake(waiter, mtx);
         task_set_state(waiter, TASK_READY);
 
         if (sched && sched->timeline) {
@@ -269,3 +272,49 @@ void mutex_unlock(Mutex *mtx, TaskControlBlock *task)
     /* Reschedule — newly woken task may preempt */
     scheduler_schedule(sched);
 }
+
+/* ── Multi-object waits ───────────────────────────────────────────── */
+
+bool mutex_try_lock(Mutex *mtx, TaskControlBlock *task)
+{
+    if (!mtx || !task || mtx->locked) return false;
+    mutex_lock(mtx, task);
+    return true;
+}
+
+bool mutex_add_waiter(Mutex *mtx, TaskControlBlock *task)
+{
+    if (!mtx || !task || !mtx->locked) return false;
+    if (!wait_queue_insert(mtx, task)) return false;
+
+    Scheduler *sched = mtx->scheduler;
+    if (sched && sched->priority_inheritance_enabled &&
+        task->priority < mtx->owner->priority) {
+        if (sched->timeline) {
+            timeline_record_priority_inherit(sched->timeline,
+                                             sched->system_ticks,
+                                             mtx->owner, task, mtx);
+        }
+        priority_inherit(mtx->owner, task->priority);
+    }
+    return true;
+}
+
+void mutex_remove_waiter(Mutex *mtx, TaskControlBlock *task)
+{
+    if (!mtx) return;
+    for (int i = 0; i < mtx->wait_count; i++) {
+        if (mtx->wait_queue[i] != task) continue;
+        for (int j = i; j < mtx->wait_count - 1; j++) {
+            mtx->wait_queue[j] = mtx->wait_queue[j + 1];
+        }
+        mtx->wait_count--;
+
+        /* The owner no longer inherits from this waiter */
+        Scheduler *sched = mtx->scheduler;
+        if (sched && sched->priority_inheritance_enabled && mtx->owner) {
+            priority_restore(mtx->owner);
+        }
+        return;
+    }
+}
@@ -62,4 +62,18 @@ void priority_inherit(TaskControlBlock *task, int new_priority);
  */
 void priority_restore(TaskControlBlock *task);
 
+/* ── Multi-object waits (waitany.c) ───────────────────────────────── */
+
+/** Lock the mutex for `task` if it is free, without blocking. */
+bool mutex_try_lock(Mutex *mtx, TaskControlBlock *task);
+
+/**
+ * Queue `task` as a waiter without blocking it. The owner inherits the
+ * waiter's priority; the boost is not propagated past the owner.
+ */
+bool mutex_add_waiter(Mutex *mtx, TaskControlBlock *task);
+
+/** Take `task` off the wait queue and recompute the owner's priority. */
+void mutex_remove_waiter(Mutex *mtx, TaskControlBlock *task);
+
 #endif /* MUTEX_H */
@@ -0,0 +1,400 @@
+/*
+ * pfair.c - Pfair (PD²) Global Multiprocessor Scheduling
+ *
+ * Each task T with weight wt = C/T is split into unit subtasks T_i,
+ * each confined to the window [r(T_i), d(T_i)):
+ *
+ *   r(T_i) = floor((i-1) * T / C)      d(T_i) = ceil(i * T / C)
+ *
+ * PD² orders eligible subtasks by deadline, then by successor bit
+ * b(T_i) (overlapping windows first), then by group deadline for heavy
+ * tasks. Windows are advanced incrementally with integer arithmetic
+ * only: the running product i*T is kept instead of being recomputed.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "pfair.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+/* ── Per-task simulation state ────────────────────────────────────── */
+
+typedef struct {
+    uint64_t e;              /* WCET (quanta)                         */
+    uint64_t p;              /* Period (quanta)                       */
+
+    /* PD² subtask window of subtask i (1-based) */
+    uint64_t i;
+    uint64_t num_prev;       /* (i-1) * p                             */
+    uint64_t num;            /* i * p                                 */
+    uint64_t release;
+    uint64_t deadline;
+    int      bbit;
+    uint64_t group_dl;
+    bool     missed;
+
+    /* G-EDF job state */
+    uint64_t job_deadline;
+    uint64_t job_remaining;
+    bool     job_started;
+
+    /* Common */
+    int      last_core;
+    bool     ran_prev;
+} MpTaskState;
+
+/* ── PD² windows ──────────────────────────────────────────────────── */
+
+static void pd2_window(MpTaskState *ts)
+{
+    ts->release  = ts->num_prev / ts->e;
+    ts->deadline = (ts->num + ts->e - 1) / ts->e;
+    ts->bbit     = (ts->num % ts->e) != 0;
+
+    if (ts->e == ts->p) {
+        ts->group_dl = UINT64_MAX;           /* Weight 1: never yields */
+    } else if (2 * ts->e >= ts->p) {
+        /* Heavy task: D = ceil(ceil(d * (1-wt)) / (1-wt)) */
+        uint64_t q = ts->p - ts->e;
+        uint64_t x = (ts->deadline * q + ts->p - 1) / ts->p;
+        ts->group_dl = (x * ts->p + q - 1) / q;
+    } else {
+        ts->group_dl = 0;                    /* Light task */
+    }
+}
+
+static void pd2_advance(MpTaskState *ts)
+{
+    ts->i++;
+    ts->num_prev = ts->num;
+    ts->num     += ts->p;
+    ts->missed   = false;
+    pd2_window(ts);
+}
+
+/* True if the subtask just before the current one was mid-job */
+static bool pd2_job_in_progress(const MpTaskState *ts)
+{
+    return ((ts->i - 1) % ts->e) != 0;
+}
+
+/* Returns <0 if task a has higher PD² priority than task b */
+static int pd2_compare(const MpTaskState *st, int a, int b)
+{
+    const MpTaskState *ta = &st[a];
+    const MpTaskState *tb = &st[b];
+    if (ta->deadline != tb->deadline) {
+        return (ta->deadline < tb->deadline) ? -1 : 1;
+    }
+    if (ta->bbit != tb->bbit) {
+        return tb->bbit - ta->bbit;
+    }
+    if (ta->bbit && ta->group_dl != tb->group_dl) {
+        return (ta->group_dl > tb->group_dl) ? -1 : 1;
+    }
+    return a - b;
+}
+
+static int gedf_compare(const MpTaskState *st, int a, int b)
+{
+    if (st[a].job_deadline != st[b].job_deadline) {
+        return (st[a].job_deadline < st[b].job_deadline) ? -1 : 1;
+    }
+    return a - b;
+}
+
+/* ── Slot helpers ─────────────────────────────────────────────────── */
+
+/* Insertion-sort candidates by priority (n <= MAX_ALL_TASKS) */
+static void sort_candidates(int *cand, int n, const MpTaskState *st,
+                            MpSchedAlgo algo)
+{
+    for (int k = 1; k < n; k++) {
+        int v = cand[k];
+        int j = k - 1;
+        while (j >= 0) {
+            int c = (algo == MP_SCHED_PFAIR_PD2)
+                  ? pd2_compare(st, v, cand[j])
+                  : gedf_compare(st, v, cand[j]);
+            if (c >= 0) break;
+            cand[j + 1] = cand[j];
+            j--;
+        }
+        cand[j + 1] = v;
+    }
+}
+
+/* Affinity-aware placement: keep running tasks on their core, then
+   prefer each task's last core, then the lowest free core. */
+static void assign_cores(const int *sel, int nsel, const MpTaskState *st,
+                         int cores, int *out)
+{
+    bool placed[MAX_ALL_TASKS] = { false };
+
+    for (int c = 0; c < cores; c++) out[c] = PFAIR_IDLE;
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (int k = 0; k < nsel; k++) {
+            const MpTaskState *ts = &st[sel[k]];
+            if (placed[k] || ts->last_core < 0) continue;
+            if (pass == 0 && !ts->ran_prev) continue;
+            if (out[ts->last_core] == PFAIR_IDLE) {
+                out[ts->last_core] = sel[k];
+                placed[k] = true;
+            }
+        }
+    }
+    for (int k = 0; k < nsel; k++) {
+        if (placed[k]) continue;
+        for (int c = 0; c < cores; c++) {
+            if (out[c] == PFAIR_IDLE) {
+                out[c] = sel[k];
+                break;
+            }
+        }
+    }
+}
+
+/* ── Feasibility ──────────────────────────────────────────────────── */
+
+bool pfair_feasible(const Scheduler *sched, int cores)
+{
+    uint64_t h = scheduler_hyperperiod(sched);
+    if (h == 0) return true;
+
+    uint64_t demand = 0;
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *t = sched->all_tasks[i];
+        if (!t || t->period == 0 || t == sched->idle_task) continue;
+        demand += t->wcet * (h / t->period);
+    }
+    return demand <= (uint64_t)cores * h;
+}
+
+/* ── Simulation ───────────────────────────────────────────────────── */
+
+void pfair_simulate(const Scheduler *sched, int cores, uint64_t horizon,
+                    MpSchedAlgo algo, MpSchedStats *out)
+{
+    if (!sched || !out) return;
+    if (cores < 1)               cores = 1;
+    if (cores > PFAIR_MAX_CORES) cores = PFAIR_MAX_CORES;
+
+    memset(out, 0, sizeof(*out));
+    out->algo  = algo;
+    out->cores = cores;
+
+    MpTaskState st[MAX_ALL_TASKS];
+    int n = 0;
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *t = sched->all_tasks[i];
+        if (!t || t->period == 0 || t->wcet == 0 ||
+            t == sched->idle_task) continue;
+
+        MpTaskState *ts = &st[n];
+        memset(ts, 0, sizeof(*ts));
+        ts->e             = t->wcet;
+        ts->p             = t->period;
+        ts->i             = 1;
+        ts->num_prev      = 0;
+        ts->num           = ts->p;
+        ts->job_deadline  = ts->p;
+        ts->job_remaining = ts->e;
+        ts->last_core     = -1;
+        pd2_window(ts);
+        out->tasks[n++] = t;
+    }
+    out->task_count = n;
+
+    if (horizon == 0) horizon = scheduler_hyperperiod(sched);
+
+    int prev[PFAIR_MAX_CORES];
+    for (int c = 0; c < cores; c++) prev[c] = PFAIR_IDLE;
+
+    for (uint64_t t = 0; t < horizon; t++) {
+        int cand[MAX_ALL_TASKS];
+        int nc = 0;
+
+        /* Deadline bookkeeping and candidate selection */
+        for (int k = 0; k < n; k++) {
+            MpTaskState *ts = &st[k];
+            if (algo == MP_SCHED_PFAIR_PD2) {
+                if (!ts->missed && ts->deadline <= t) {
+                    ts->missed = true;
+                    out->deadline_misses++;
+                    out->task_misses[k]++;
+                }
+                if (ts->release <= t) cand[nc++] = k;
+            } else {
+                if (t == ts->job_deadline) {
+                    if (ts->job_remaining > 0) {
+                        out->deadline_misses++;
+                        out->task_misses[k]++;
+                    }
+                    ts->job_deadline  = t + ts->p;
+                    ts->job_remaining = ts->e;
+                    ts->job_started   = false;
+                }
+                if (ts->job_remaining > 0) cand[nc++] = k;
+            }
+        }
+
+        sort_candidates(cand, nc, st, algo);
+        int nsel = (nc < cores) ? nc : cores;
+
+        int slot[PFAIR_MAX_CORES];
+        assign_cores(cand, nsel, st, cores, slot);
+
+        bool ran_now[MAX_ALL_TASKS] = { false };
+        for (int c = 0; c < cores; c++) {
+            int k = slot[c];
+            if (k == PFAIR_IDLE) continue;
+            MpTaskState *ts = &st[k];
+            bool mid_job = (algo == MP_SCHED_PFAIR_PD2)
+                         ? pd2_job_in_progress(ts) : ts->job_started;
+
+            if (mid_job && ts->last_core >= 0 && ts->last_core != c) {
+                out->migrations++;
+                out->task_migrations[k]++;
+            }
+            if (prev[c] != k) out->context_switches++;
+
+            if (algo == MP_SCHED_PFAIR_PD2) {
+                pd2_advance(ts);
+            } else {
+                ts->job_remaining--;
+                ts->job_started = (ts->job_remaining > 0);
+            }
+            ts->last_core = c;
+            ran_now[k] = true;
+            out->busy_slots++;
+        }
+
+        /* A job descheduled with work left is a preemption */
+        for (int k = 0; k < n; k++) {
+            MpTaskState *ts = &st[k];
+            if (ts->ran_prev && !ran_now[k]) {
+                bool mid_job = (algo == MP_SCHED_PFAIR_PD2)
+                             ? pd2_job_in_progress(ts)
+                             : ts->job_remaining > 0;
+                if (mid_job) {
+                    out->preemptions++;
+                    out->task_preemptions[k]++;
+                }
+            }
+            ts->ran_prev = ran_now[k];
+        }
+
+        if (out->trace_len < PFAIR_TRACE_MAX) {
+            for (int c = 0; c < cores; c++) {
+                out->trace[out->trace_len][c] = slot[c];
+            }
+            out->trace_len++;
+        }
+        for (int c = 0; c < cores; c++) prev[c] = slot[c];
+        out->slots++;
+    }
+
+    /* Deadlines falling exactly on the horizon */
+    for (int k = 0; k < n; k++) {
+        MpTaskState *ts = &st[k];
+        bool late = (algo == MP_SCHED_PFAIR_PD2)
+                  ? (!ts->missed && ts->deadline <= horizon)
+                  : (ts->job_deadline <= horizon && ts->job_remaining > 0);
+        if (late) {
+            out->deadline_misses++;
+            out->task_misses[k]++;
+        }
+    }
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+static const char *algo_name(MpSchedAlgo algo)
+{
+    return (algo == MP_SCHED_PFAIR_PD2) ? "PD2" : "G-EDF";
+}
+
+void pfair_render(const MpSchedStats *stats)
+{
+    if (!stats || stats->trace_len == 0) return;
+
+    printf("\n  %s schedule (first %d quanta):\n", algo_name(stats->algo),
+           stats->trace_len);
+    for (int c = 0; c < stats->cores; c++) {
+        printf("    C%-2d |", c);
+        for (int s = 0; s < stats->trace_len; s++) {
+            int k = stats->trace[s][c];
+            putchar(k == PFAIR_IDLE ? '.' : (char)('A' + k % 26));
+        }
+        printf("|\n");
+    }
+    printf("    Legend:");
+    for (int k = 0; k < stats->task_count; k++) {
+        printf(" %c=%s", 'A' + k % 26, stats->tasks[k]->name);
+    }
+    printf("  .=idle\n");
+}
+
+void pfair_print_comparison(const Scheduler *sched, int cores,
+                            uint64_t horizon)
+{
+    if (!sched) return;
+
+    MpSchedStats *pd2  = malloc(sizeof(MpSchedStats));
+    MpSchedStats *gedf = malloc(sizeof(MpSchedStats));
+    if (!pd2 || !gedf) {
+        free(pd2);
+        free(gedf);
+        return;
+    }
+
+    pfair_simulate(sched, cores, horizon, MP_SCHED_PFAIR_PD2, pd2);
+    pfair_simulate(sched, cores, horizon, MP_SCHED_GEDF, gedf);
+
+    printf("\n");
+    printf("================================================================\n");
+    printf("         PFAIR (PD2) vs GLOBAL EDF  —  %d cores\n", cores);
+    printf("================================================================\n\n");
+
+    printf("  Feasible (U <= m)  : %s\n",
+           pfair_feasible(sched, cores) ? "yes" : "no");
+    printf("  Simulated quanta   : %" PRIu64 "\n\n", pd2->slots);
+
+    printf("  %-12s %5s %5s | %5s %5s %5s | %5s %5s %5s\n",
+           "Task", "C", "T", "Pre", "Mig", "Miss", "Pre", "Mig", "Miss");
+    printf("  %-12s %5s %5s | %17s | %17s\n",
+           "", "", "", "------ PD2 ------", "----- G-EDF -----");
+    for (int k = 0; k < pd2->task_count; k++) {
+        const TaskControlBlock *t = pd2->tasks[k];
+        printf("  %-12s %5" PRIu64 " %5" PRIu64
+               " | %5u %5u %5u | %5u %5u %5u\n",
+               t->name, t->wcet, t->period,
+               pd2->task_preemptions[k], pd2->task_migrations[k],
+               pd2->task_misses[k],
+               gedf->task_preemptions[k], gedf->task_migrations[k],
+               gedf->task_misses[k]);
+    }
+
+    printf("\n  %-18s %10s %10s\n", "", "PD2", "G-EDF");
+    printf("  %-18s %10" PRIu64 " %10" PRIu64 "\n", "Preemptions",
+           pd2->preemptions, gedf->preemptions);
+    printf("  %-18s %10" PRIu64 " %10" PRIu64 "\n", "Migrations",
+           pd2->migrations, gedf->migrations);
+    printf("  %-18s %10" PRIu64 " %10" PRIu64 "\n", "Context switches",
+           pd2->context_switches, gedf->context_switches);
+    printf("  %-18s %10" PRIu64 " %10" PRIu64 "\n", "Deadline misses",
+           pd2->deadline_misses, gedf->deadline_misses);
+
+    pfair_render(pd2);
+    pfair_render(gedf);
+    printf("\n");
+
+    free(pd2);
+    free(gedf);
+}
@@ -0,0 +1,76 @@
+/*
+ * pfair.h - Pfair (PD²) Global Multiprocessor Scheduling
+ *
+ * Quantum-based simulation of the PD² Pfair algorithm over m cores,
+ * with a global EDF (G-EDF) simulation of the same task set for
+ * comparison of preemption and migration overhead.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef PFAIR_H
+#define PFAIR_H
+
+#include "scheduler.h"
+#include "smp.h"
+#include <stdint.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define PFAIR_MAX_CORES   SMP_MAX_CORES
+#define PFAIR_TRACE_MAX   128    /* Slots kept for the Gantt rendering */
+#define PFAIR_IDLE        (-1)
+
+/* ── Algorithms ───────────────────────────────────────────────────── */
+typedef enum {
+    MP_SCHED_PFAIR_PD2,
+    MP_SCHED_GEDF
+} MpSchedAlgo;
+
+/* ── Simulation results ───────────────────────────────────────────── */
+typedef struct {
+    MpSchedAlgo             algo;
+    int                     cores;
+    uint64_t                slots;
+    uint64_t                busy_slots;
+    uint64_t                preemptions;
+    uint64_t                migrations;
+    uint64_t                context_switches;
+    uint64_t                deadline_misses;
+
+    /* Per-task breakdown (index into `tasks`) */
+    int                     task_count;
+    const TaskControlBlock *tasks[MAX_ALL_TASKS];
+    uint32_t                task_preemptions[MAX_ALL_TASKS];
+    uint32_t                task_migrations[MAX_ALL_TASKS];
+    uint32_t                task_misses[MAX_ALL_TASKS];
+
+    /* First PFAIR_TRACE_MAX slots: task index per core or PFAIR_IDLE */
+    int                     trace[PFAIR_TRACE_MAX][PFAIR_MAX_CORES];
+    int                     trace_len;
+} MpSchedStats;
+
+/* ── Public API ───────────────────────────────────────────────────── */
+
+/**
+ * True if Σ(Ci/Ti) <= cores, evaluated exactly with integer
+ * arithmetic over the hyperperiod (the Pfair feasibility condition).
+ */
+bool pfair_feasible(const Scheduler *sched, int cores);
+
+/**
+ * Simulate the periodic tasks of `sched` (implicit deadlines, all
+ * released at t=0) for `horizon` quanta on `cores` processors.
+ * A horizon of 0 means one hyperperiod.
+ */
+void pfair_simulate(const Scheduler *sched, int cores, uint64_t horizon,
+                    MpSchedAlgo algo, MpSchedStats *out);
+
+/** Print a per-core Gantt chart of the traced slots. */
+void pfair_render(const MpSchedStats *stats);
+
+/** Run PD² and G-EDF on the same task set and print the overheads. */
+void pfair_print_comparison(const Scheduler *sched, int cores,
+                            uint64_t horizon);
+
+#endif /* PFAIR_H */
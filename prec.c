@@ -0,0 +1,478 @@
+/*
+ * prec.c - Precedence-Constrained Task Graphs on One Core
+ *
+ * Graph tasks are taken out of the periodic release path at
+ * prec_start() (next_release is pushed to infinity) and released by
+ * release_job() from here instead: sources at each instance release,
+ * successors from prec_tick() at the tick their last predecessor
+ * completed. A node's absolute deadline is the instance release plus
+ * its (possibly transformed) deadline, so check_deadlines() reports
+ * node misses as usual.
+ *
+ * Successor release times are set by completions, so Chetto's r*_i is
+ * only reported: the earliest release it describes is what the
+ * event-driven release achieves when predecessors run without
+ * interference.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "prec.h"
+#include "rtos_time.h"
+#include "timeline.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+/* ── Helpers ──────────────────────────────────────────────────────── */
+
+static bool job_pending(const TaskControlBlock *t)
+{
+    return (t->state == TASK_READY || t->state == TASK_RUNNING ||
+            t->state == TASK_BLOCKED) && t->remaining_work > 0;
+}
+
+static int node_index(const PrecGraph *g, const TaskControlBlock *t)
+{
+    for (int i = 0; i < g->node_count; i++) {
+        if (g->node[i] == t) return i;
+    }
+    return -1;
+}
+
+/* Transitive predecessors of node `n` */
+static uint32_t ancestors(const PrecGraph *g, int n)
+{
+    uint32_t seen = 0, frontier = g->preds[n];
+    while (frontier & ~seen) {
+        seen |= frontier;
+        uint32_t next = 0;
+        for (int i = 0; i < g->node_count; i++) {
+            if (seen & (1u << i)) next |= g->preds[i];
+        }
+        frontier = next;
+    }
+    return seen;
+}
+
+static uint32_t all_nodes(const PrecGraph *g)
+{
+    return (g->node_count == 32) ? UINT32_MAX
+                                 : (1u << g->node_count) - 1;
+}
+
+/* EDF on the priority dispatcher: rank pending jobs by deadline */
+static void edf_rerank(Scheduler *sched)
+{
+    TaskControlBlock *order[MAX_ALL_TASKS];
+    int n = 0;
+
+    for (int i = 0; i < sched->task_count; i++) {
+        TaskControlBlock *t = sched->all_tasks[i];
+        if (!t || t == sched->idle_task || !job_pending(t)) continue;
+
+        /* Insertion sort by (deadline, base priority) */
+        int j = n++;
+        while (j > 0 &&
+               (order[j - 1]->absolute_deadline > t->absolute_deadline ||
+                (order[j - 1]->absolute_deadline == t->absolute_deadline &&
+                 order[j - 1]->original_priority > t->original_priority))) {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = t;
+    }
+
+    for (int r = 0; r < n; r++) {
+        if (order[r]->priority != r + 1) task_set_priority(order[r], r + 1);
+    }
+}
+
+/* ── Instance execution ───────────────────────────────────────────── */
+
+static void node_done(Scheduler *sched, PrecGraph *g, int n);
+
+static void release_node(Scheduler *sched, PrecGraph *g, int n)
+{
+    TaskControlBlock *t = g->node[n];
+    g->released_mask |= 1u << n;
+
+    if (release_job(sched, t)) {
+        t->absolute_deadline = g->release + g->eff_deadline[n];
+    } else {
+        node_done(sched, g, n);     /* Withheld job: successors proceed */
+    }
+}
+
+static void node_done(Scheduler *sched, PrecGraph *g, int n)
+{
+    g->done_mask |= 1u << n;
+
+    for (int k = 0; k < g->node_count; k++) {
+        int j = g->topo[k];
+        if ((g->released_mask & (1u << j)) ||
+            (g->preds[j] & ~g->done_mask)) {
+            continue;
+        }
+        sched->prec->successor_releases++;
+        release_node(sched, g, j);
+    }
+
+    if (g->active && g->done_mask == all_nodes(g)) {
+        uint64_t lat = sched->system_ticks - g->release;
+        g->active = false;
+        if (g->completed == 0 || lat < g->latency_min) g->latency_min = lat;
+        if (lat > g->latency_max) g->latency_max = lat;
+        g->latency_sum += lat;
+        g->completed++;
+        if (lat > g->deadline) {
+            g->late++;
+            if (sched->timeline) {
+                char buf[ANNOTATION_MAX];
+                snprintf(buf, sizeof(buf), "PREC: %s instance took %"
+                         PRIu64 " > %" PRIu64, g->name, lat, g->deadline);
+                timeline_record(sched->timeline, sched->system_ticks,
+                                NULL, VIS_NONE, buf);
+            }
+        }
+    }
+}
+
+static void release_instance(Scheduler *sched, PrecGraph *g)
+{
+    g->active        = true;
+    g->release       = sched->system_ticks;
+    g->next_release  = g->release + g->period;
+    g->released_mask = 0;
+    g->done_mask     = 0;
+    g->instances++;
+
+    for (int k = 0; k < g->node_count; k++) {
+        int n = g->topo[k];
+        if (g->preds[n] == 0 && !(g->released_mask & (1u << n))) {
+            release_node(sched, g, n);
+        }
+    }
+}
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+bool prec_enable(Scheduler *sched, PrecDispatch dispatch)
+{
+    if (!sched) return false;
+    if (!sched->prec) {
+        sched->prec = calloc(1, sizeof(PrecState));
+        if (!sched->prec) {
+            fprintf(stderr, "prec_enable: out of memory\n");
+            return false;
+        }
+    }
+    sched->prec->dispatch = dispatch;
+    return true;
+}
+
+void prec_disable(Scheduler *sched)
+{
+    if (!sched) return;
+    free(sched->prec);
+    sched->prec = NULL;
+}
+
+PrecGraph *prec_graph_create(Scheduler *sched, const char *name,
+                             uint64_t period, uint64_t deadline)
+{
+    PrecState *ps = sched ? sched->prec : NULL;
+    if (!ps || !name || period == 0 || deadline == 0) return NULL;
+    if (ps->started) {
+        fprintf(stderr, "prec_graph_create: graphs already started\n");
+        return NULL;
+    }
+    if (ps->graph_count >= PREC_MAX_GRAPHS) {
+        fprintf(stderr, "prec_graph_create: more than %d graphs\n",
+                PREC_MAX_GRAPHS);
+        return NULL;
+    }
+
+    PrecGraph *g = &ps->graph[ps->graph_count++];
+    memset(g, 0, sizeof(*g));
+    snprintf(g->name, PREC_NAME_MAX, "%s", name);
+    g->period   = period;
+    g->deadline = deadline;
+    return g;
+}
+
+int prec_add_node(PrecGraph *graph, TaskControlBlock *task,
+                  uint64_t deadline)
+{
+    if (!graph || !task) return -1;
+    if (graph->node_count >= PREC_MAX_NODES) {
+        fprintf(stderr, "prec_add_node: %s is full\n", graph->name);
+        return -1;
+    }
+    if (task->period != graph->period) {
+        fprintf(stderr, "prec_add_node: %s has period %" PRIu64 ", graph "
+                "%s has %" PRIu64 "\n", task->name, task->period,
+                graph->name, graph->period);
+        return -1;
+    }
+    PrecState *ps = task->scheduler ? task->scheduler->prec : NULL;
+    for (int g = 0; ps && g < ps->graph_count; g++) {
+        if (node_index(&ps->graph[g], task) >= 0) {
+            fprintf(stderr, "prec_add_node: %s is already in graph %s\n",
+                    task->name, ps->graph[g].name);
+            return -1;
+        }
+    }
+
+    int n = graph->node_count++;
+    graph->node[n]          = task;
+    graph->node_deadline[n] = deadline ? deadline : graph->deadline;
+    graph->eff_deadline[n]  = graph->node_deadline[n];
+    graph->eff_release[n]   = 0;
+    graph->preds[n]         = 0;
+    graph->topo[n]          = n;
+    return n;
+}
+
+bool prec_add_edge(PrecGraph *graph, TaskControlBlock *from,
+                   TaskControlBlock *to)
+{
+    if (!graph) return false;
+    int f = node_index(graph, from);
+    int t = node_index(graph, to);
+    if (f < 0 || t < 0) {
+        fprintf(stderr, "prec_add_edge: both tasks must be nodes of %s\n",
+                graph->name);
+        return false;
+    }
+    /* A cycle would form if `to` already precedes `from` */
+    if (f == t || (ancestors(graph, f) & (1u << t))) {
+        fprintf(stderr, "prec_add_edge: %s -> %s would create a cycle in "
+                "%s\n", from->name, to->name, graph->name);
+        return false;
+    }
+    graph->preds[t] |= 1u << f;
+    return true;
+}
+
+bool prec_validate(PrecGraph *graph)
+{
+    if (!graph) return false;
+
+    /* Kahn's algorithm, lowest index first among ready nodes */
+    uint32_t placed = 0;
+    for (int k = 0; k < graph->node_count; k++) {
+        int next = -1;
+        for (int i = 0; i < graph->node_count && next < 0; i++) {
+            if (!(placed & (1u << i)) && (graph->preds[i] & ~placed) == 0) {
+                next = i;
+            }
+        }
+        if (next < 0) {
+            fprintf(stderr, "prec_validate: cycle in %s through", graph->name);
+            for (int i = 0; i < graph->node_count; i++) {
+                if (!(placed & (1u << i))) {
+                    fprintf(stderr, " %s", graph->node[i]->name);
+                }
+            }
+            fprintf(stderr, "\n");
+            return false;
+        }
+        graph->topo[k] = next;
+        placed |= 1u << next;
+    }
+    return true;
+}
+
+bool prec_transform(Scheduler *sched)
+{
+    PrecState *ps = sched ? sched->prec : NULL;
+    if (!ps) return false;
+
+    bool ok = true;
+    for (int gi = 0; gi < ps->graph_count; gi++) {
+        PrecGraph *g = &ps->graph[gi];
+        if (!prec_validate(g)) return false;
+
+        /* Deadlines backwards, releases forwards in topological order */
+        for (int k = g->node_count - 1; k >= 0; k--) {
+            int      i = g->topo[k];
+            uint64_t d = g->node_deadline[i];
+            for (int j = 0; j < g->node_count; j++) {
+                if (!(g->preds[j] & (1u << i))) continue;
+                uint64_t cj = g->node[j]->wcet;
+                uint64_t dj = g->eff_deadline[j];
+                if (dj < cj) {
+                    fprintf(stderr, "prec_transform: %s cannot meet its "
+                            "deadline in %s\n", g->node[j]->name, g->name);
+                    ok = false;
+                    dj = cj;
+                }
+                if (dj - cj < d) d = dj - cj;
+            }
+            g->eff_deadline[i] = d;
+        }
+        for (int k = 0; k < g->node_count; k++) {
+            int      i = g->topo[k];
+            uint64_t r = 0;
+            for (int j = 0; j < g->node_count; j++) {
+                if (!(g->preds[i] & (1u << j))) continue;
+                uint64_t rj = g->eff_release[j] + g->node[j]->wcet;
+                if (rj > r) r = rj;
+            }
+            g->eff_release[i] = r;
+        }
+        g->transformed = true;
+    }
+
+    if (ps->dispatch != PREC_DISPATCH_FIXED) return ok;
+
+    /* Deadline-monotonic priorities over the whole core; graph nodes
+       use d* and tie-break in topological order */
+    TaskControlBlock *order[MAX_ALL_TASKS];
+    uint64_t          key[MAX_ALL_TASKS];
+    int               tie[MAX_ALL_TASKS];
+    int n = 0;
+    for (int i = 0; i < sched->task_count; i++) {
+        TaskControlBlock *t = sched->all_tasks[i];
+        if (!t || t == sched->idle_task) continue;
+
+        uint64_t d = t->relative_deadline;
+        int      rank = 0;
+        for (int gi = 0; gi < ps->graph_count; gi++) {
+            const PrecGraph *g = &ps->graph[gi];
+            for (int k = 0; k < g->node_count; k++) {
+                if (g->node[g->topo[k]] == t) {
+                    d    = g->eff_deadline[g->topo[k]];
+                    rank = k;
+                }
+            }
+        }
+
+        int j = n++;
+        while (j > 0 && (key[j - 1] > d ||
+                         (key[j - 1] == d && tie[j - 1] > rank))) {
+            order[j] = order[j - 1];
+            key[j]   = key[j - 1];
+            tie[j]   = tie[j - 1];
+            j--;
+        }
+        order[j] = t;
+        key[j]   = d;
+        tie[j]   = rank;
+    }
+    for (int r = 0; r < n; r++) {
+        order[r]->original_priority = r + 1;
+        task_set_priority(order[r], r + 1);
+    }
+    return ok;
+}
+
+bool prec_start(Scheduler *sched)
+{
+    PrecState *ps = sched ? sched->prec : NULL;
+    if (!ps) {
+        fprintf(stderr, "prec_start: not enabled\n");
+        return false;
+    }
+    for (int gi = 0; gi < ps->graph_count; gi++) {
+        if (!prec_validate(&ps->graph[gi])) return false;
+    }
+
+    /* Graph tasks leave the periodic release path */
+    for (int gi = 0; gi < ps->graph_count; gi++) {
+        PrecGraph *g = &ps->graph[gi];
+        for (int i = 0; i < g->node_count; i++) {
+            TaskControlBlock *t = g->node[i];
+            t->next_release   = UINT64_MAX;
+            t->remaining_work = 0;
+            t->invocations    = 0;
+            task_set_state(t, TASK_SUSPENDED);
+        }
+    }
+
+    ps->started = true;
+    for (int gi = 0; gi < ps->graph_count; gi++) {
+        release_instance(sched, &ps->graph[gi]);
+    }
+    if (ps->dispatch == PREC_DISPATCH_EDF) edf_rerank(sched);
+    return true;
+}
+
+/* ── Hooks ────────────────────────────────────────────────────────── */
+
+void prec_tick(Scheduler *sched, TaskControlBlock *curr)
+{
+    PrecState *ps = sched ? sched->prec : NULL;
+    if (!ps || !ps->started) return;
+
+    /* A node that just finished releases its ready successors */
+    if (curr && curr->state == TASK_RUNNING && curr->remaining_work == 0) {
+        for (int gi = 0; gi < ps->graph_count; gi++) {
+            PrecGraph *g = &ps->graph[gi];
+            int n = node_index(g, curr);
+            if (n >= 0 && (g->released_mask & ~g->done_mask & (1u << n))) {
+                node_done(sched, g, n);
+            }
+        }
+    }
+
+    for (int gi = 0; gi < ps->graph_count; gi++) {
+        PrecGraph *g = &ps->graph[gi];
+        if (sched->system_ticks < g->next_release) continue;
+        if (g->active) {
+            g->overruns++;          /* Skip this period */
+            g->next_release += g->period;
+        } else {
+            release_instance(sched, g);
+        }
+    }
+
+    if (ps->dispatch == PREC_DISPATCH_EDF) edf_rerank(sched);
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+void prec_print_report(const Scheduler *sched)
+{
+    const PrecState *ps = sched ? sched->prec : NULL;
+    if (!ps) return;
+
+    for (int gi = 0; gi < ps->graph_count; gi++) {
+        const PrecGraph *g = &ps->graph[gi];
+        printf("\n  Graph %s: T=%" PRIu64 " D=%" PRIu64 ", %s dispatch%s\n",
+               g->name, g->period, g->deadline,
+               ps->dispatch == PREC_DISPATCH_EDF ? "EDF" : "fixed-priority",
+               g->transformed ? ", transformed" : "");
+        printf("  %-10s %4s %-16s %5s %5s %5s %5s %7s\n", "Node", "C",
+               "Preds", "d", "d*", "r*", "Prio", "Misses");
+        for (int k = 0; k < g->node_count; k++) {
+            int i = g->topo[k];
+            const TaskControlBlock *t = g->node[i];
+            char preds[64] = "-";
+            size_t len = 0;
+            for (int j = 0; j < g->node_count && len < sizeof(preds); j++) {
+                if (!(g->preds[i] & (1u << j))) continue;
+                len += (size_t)snprintf(preds + len, sizeof(preds) - len,
+                                        "%s%s", len ? "," : "",
+                                        g->node[j]->name);
+            }
+            printf("  %-10s %4" PRIu64 " %-16s %5" PRIu64 " %5" PRIu64
+                   " %5" PRIu64 " %5d %7u\n", t->name, t->wcet, preds,
+                   g->node_deadline[i], g->eff_deadline[i],
+                   g->eff_release[i], t->original_priority,
+                   t->deadline_misses);
+        }
+        double avg = g->completed
+                   ? (double)g->latency_sum / g->completed : 0.0;
+        printf("  Instances %u, completed %u, late %u, overruns %u; "
+               "end-to-end latency %" PRIu64 " / %.1f / %" PRIu64 "\n",
+               g->instances, g->completed, g->late, g->overruns,
+               g->latency_min, avg, g->latency_max);
+    }
+    printf("  Successor releases by completion: %" PRIu64 "\n",
+           ps->successor_releases);
+}
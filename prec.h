@@ -0,0 +1,142 @@
+/*
+ * prec.h - Precedence-Constrained Task Graphs on One Core
+ *
+ * A precedence graph groups tasks of one core into a periodic instance:
+ * at each period its source tasks are released, and every other task is
+ * released at the tick its last predecessor completes, without a
+ * semaphore or any other synchronization object between them.
+ *
+ * Each node may carry its own deadline relative to the instance release
+ * (the graph's end-to-end deadline by default). Chetto, Silly & Bouchentouf
+ * turn the constrained set into an independent one that EDF schedules
+ * iff the original is feasible:
+ *
+ *   d*_i = min(d_i, min over successors j of (d*_j - C_j))
+ *   r*_i = max(r_i, max over predecessors j of (r*_j + C_j))
+ *
+ * Under fixed priorities the same deadlines give a deadline-monotonic
+ * order in which no task outranks its predecessors.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef PREC_H
+#define PREC_H
+
+#include "scheduler.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define PREC_MAX_GRAPHS     8
+#define PREC_MAX_NODES      32      /* Predecessor sets are 32-bit masks */
+#define PREC_NAME_MAX       32
+
+typedef enum {
+    PREC_DISPATCH_FIXED,    /* Task priorities as assigned             */
+    PREC_DISPATCH_EDF       /* Pending jobs ranked by absolute deadline */
+} PrecDispatch;
+
+/* ── Precedence graph ─────────────────────────────────────────────── */
+typedef struct {
+    char              name[PREC_NAME_MAX];
+    uint64_t          period;
+    uint64_t          deadline;     /* End-to-end, from instance release */
+
+    /* Graph */
+    int               node_count;
+    TaskControlBlock *node[PREC_MAX_NODES];
+    uint64_t          node_deadline[PREC_MAX_NODES];   /* Declared      */
+    uint32_t          preds[PREC_MAX_NODES];   /* Bit j: edge j -> i    */
+    int               topo[PREC_MAX_NODES];    /* Topological order     */
+
+    /* Chetto's transformation (declared values until transformed) */
+    bool              transformed;
+    uint64_t          eff_deadline[PREC_MAX_NODES];
+    uint64_t          eff_release[PREC_MAX_NODES];
+
+    /* Current instance */
+    bool              active;
+    uint64_t          release;
+    uint64_t          next_release;
+    uint32_t          released_mask;
+    uint32_t          done_mask;
+
+    /* Statistics */
+    uint32_t          instances;
+    uint32_t          completed;
+    uint32_t          overruns;     /* Instance still active at next period */
+    uint32_t          late;         /* Completed after the deadline    */
+    uint64_t          latency_min;
+    uint64_t          latency_max;
+    uint64_t          latency_sum;
+} PrecGraph;
+
+/* ── Per-core state ───────────────────────────────────────────────── */
+struct PrecState {
+    PrecDispatch  dispatch;
+    bool          started;
+    PrecGraph     graph[PREC_MAX_GRAPHS];
+    int           graph_count;
+    uint64_t      successor_releases;   /* Released by a completion     */
+};
+
+/* ── Configuration ────────────────────────────────────────────────── */
+
+/** Enable precedence graphs on a core with the given dispatching. */
+bool prec_enable(Scheduler *sched, PrecDispatch dispatch);
+
+/** Remove all graphs; their tasks keep their current state. */
+void prec_disable(Scheduler *sched);
+
+/** Create an empty graph with a period and end-to-end deadline. */
+PrecGraph *prec_graph_create(Scheduler *sched, const char *name,
+                             uint64_t period, uint64_t deadline);
+
+/**
+ * Add a task as a node. `deadline` is relative to the instance release
+ * (0 = the graph's deadline). The task's period must equal the graph's.
+ * Returns the node index, or -1 on error.
+ */
+int prec_add_node(PrecGraph *graph, TaskControlBlock *task,
+                  uint64_t deadline);
+
+/** `to` may start only after `from` completes. Rejects cycles. */
+bool prec_add_edge(PrecGraph *graph, TaskControlBlock *from,
+                   TaskControlBlock *to);
+
+/**
+ * Compute a topological order. Returns false (and prints the nodes
+ * involved) if the graph has a cycle.
+ */
+bool prec_validate(PrecGraph *graph);
+
+/**
+ * Apply Chetto's transformation to every graph. Under fixed-priority
+ * dispatch also reassign all task priorities deadline-monotonically,
+ * using the adjusted deadlines for graph nodes.
+ */
+bool prec_transform(Scheduler *sched);
+
+/**
+ * Validate every graph and start its first instance at the current
+ * tick. Graph tasks are released only by the graphs from then on.
+ */
+bool prec_start(Scheduler *sched);
+
+/* ── Hooks ────────────────────────────────────────────────────────── */
+
+/**
+ * Per-tick processing (called by tick_handler after the periodic
+ * releases): completion of the running node, successor releases,
+ * instance releases, and EDF ranking.
+ */
+void prec_tick(Scheduler *sched, TaskControlBlock *curr);
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+/** Print each graph's nodes, deadlines and end-to-end latency. */
+void prec_print_report(const Scheduler *sched);
+
+#endif /* PREC_H */
@@ -10,12 +10,87 @@
 
 #include "rtos_time.h"
 #include "timeline.h"
+#include "memguard.h"
+#include "mixcrit.h"
+#include "modechange.h"
+#include "elastic.h"
+#include "mkfirm.h"
+#include "dvfs.h"
+#include "dpm.h"
+#include "cyclic.h"
+#include "let.h"
+#include "prec.h"
+#include "isr.h"
+#include "swtimer.h"
+#include "iodev.h"
+#include "inject.h"
+#include "evstream.h"
 
 #include <stdio.h>
 #include <inttypes.h>
 
 /* ── Periodic Task Release ────────────────────────────────────────── */
 
+bool release_job(Scheduler *sched, TaskControlBlock *t)
+{
+    if (!sched || !t) return false;
+
+    if (sched->mixcrit && !mixcrit_admit_release(sched, t)) {
+        return false;               /* LO task shed in HI mode */
+    }
+    t->absolute_deadline = sched->system_ticks + t->relative_deadline;
+    t->exec_time        = 0;
+    t->remaining_work   = t->wcet;
+    t->invocations++;
+    if (sched->mixcrit) mixcrit_job_released(sched, t);
+    if (sched->mkfirm && !mkfirm_job_released(sched, t)) {
+        return false;               /* Job skipped under (m,k) */
+    }
+    if (sched->dvfs) dvfs_job_released(sched, t);
+    if (sched->let) let_job_released(sched, t);
+
+    task_set_state(t, TASK_READY);
+
+    if (sched->timeline) {
+        char buf[256];
+        snprintf(buf, sizeof(buf),
+                 "%s released (period=%" PRIu64 ", deadline=%" PRIu64 ")",
+                 t->name, t->period, t->absolute_deadline);
+        timeline_record(sched->timeline, sched->system_ticks,
+                        t, VIS_NONE, buf);
+    }
+    return true;
+}
+
+void wake_delayed_tasks(Scheduler *sched)
+{
+    if (!sched) return;
+
+    TaskControlBlock *t;
+    while ((t = sched->sleep_head) && t->wake_tick <= sched->system_ticks) {
+        task_set_state(t, TASK_READY);      /* Leaves the sleep queue */
+    }
+}
+
+uint64_t next_event_tick(const Scheduler *sched)
+{
+    uint64_t next = UINT64_MAX;
+    if (!sched) return next;
+
+    for (int i = 0; i < sched->task_count; i++) {
+        const TaskControlBlock *t = sched->all_tasks[i];
+        if (!t || t == sched->idle_task || t->period == 0 ||
+            t->state == TASK_TERMINATED) {
+            continue;
+        }
+        if (t->next_release < next) next = t->next_release;
+    }
+    if (sched->sleep_head && sched->sleep_head->wake_tick < next) {
+        next = sched->sleep_head->wake_tick;
+    }
+    return next;
+}
+
 void check_periodic_releases(Scheduler *sched)
 {
     if (!sched) return;
@@ -26,26 +101,14 @@ void check_periodic_releases(Scheduler *sched)
         if (t->period == 0) continue;   /* Aperiodic */
 
         if (t->state == TASK_SUSPENDED &&
-            sched->system_ticks >= t->next_release &&
-            (sched->system_ticks - t->next_release) % t->period == 0 &&
-            sched->system_ticks == t->next_release)
+            sched->system_ticks >= t->next_release)
         {
-            /* Release this periodic task */
-            t->next_release     = sched->system_ticks + t->period;
-            t->absolute_deadline = sched->system_ticks + t->relative_deadline;
-            t->exec_time        = 0;
-            t->invocations++;
-
-            task_set_state(t, TASK_READY);
-
-            if (sched->timeline) {
-                char buf[256];
-                snprintf(buf, sizeof(buf),
-                         "%s released (period=%" PRIu64 ", deadline=%" PRIu64 ")",
-                         t->name, t->period, t->absolute_deadline);
-                timeline_record(sched->timeline, sched->system_ticks,
-                                t, VIS_NONE, buf);
+            /* Release this periodic task. A job that overran its period
+               is released late; later releases stay on the period grid. */
+            while (t->next_release <= sched->system_ticks) {
+                t->next_release += t->period;
             }
+            release_job(sched, t);
         }
     }
 }
@@ -87,12 +150,22 @@ void tick_handler(Scheduler *sched)
 
     sched->system_ticks++;
 
-    /* Update current task's execution counters */
+    /* The schedule table cursor follows the clock */
+    if (sched->cyclic) cyclic_tick(sched);
+
+    /* Update current task's execution counters (unless an interrupt
+       handler took the tick or the core is throttled by its memory
+       bandwidth regulator) */
     TaskControlBlock *curr = sched->current_task;
-    if (curr && curr->state == TASK_RUNNING) {
+    bool in_isr    = sched->isr && isr_tick(sched, curr);
+    bool throttled = in_isr ||
+                     (sched->memguard && memguard_tick(sched, curr));
+    if (curr && curr->state == TASK_RUNNING && !throttled) {
         curr->exec_time++;
         curr->total_exec_time++;
-        if (curr->remaining_work > 0) {
+        if (sched->dvfs) {
+            dvfs_execute(sched, curr);  /* Work scaled by frequency */
+        } else if (curr->remaining_work > 0) {
             curr->remaining_work--;
         }
         if (curr->exec_time > curr->wcet_observed) {
@@ -100,11 +173,58 @@ void tick_handler(Scheduler *sched)
         }
     }
 
-    /* Check for periodic releases */
+    if (sched->dvfs) {
+        dvfs_tick(sched, curr, curr && curr->state == TASK_RUNNING &&
+                               !throttled);
+    }
+
+    /* Criticality budget monitoring and mode switches */
+    if (sched->mixcrit) mixcrit_tick(sched, curr);
+
+    /* Elastic load monitoring may stretch periods before releases */
+    if (sched->elastic) elastic_tick(sched, curr);
+
+    /* Pending mode change: new-mode tasks are released below */
+    if (sched->modes) modechange_tick(sched);
+
+    /* Firm deadlines: record outcomes, abort expired jobs */
+    if (sched->mkfirm) mkfirm_tick(sched, curr);
+
+    /* Completed outputs and LET publications precede this tick's
+       releases, which read them */
+    if (sched->let) {
+        let_tick(sched, curr, curr && curr->state == TASK_RUNNING &&
+                              !throttled);
+    }
+
+    /* Device operations ending now raise their completion interrupts */
+    if (sched->io) io_tick(sched);
+
+    /* Timer callbacks the daemon just ran, then expiries due now */
+    if (sched->timers) {
+        timer_service_tick(sched, curr, curr &&
+                                        curr->state == TASK_RUNNING &&
+                                        !throttled);
+    }
+
+    /* Events other host threads posted before this tick boundary and
+       replayed commands whose timestamp has come: applied after the
+       elapsed tick is accounted, so they take effect from this tick */
+    if (sched->inject) inject_tick(sched);
+    if (sched->stream) evstream_tick(sched);
+
+    /* Delays ending now, then periodic releases */
+    wake_delayed_tasks(sched);
     check_periodic_releases(sched);
 
+    /* Graph instances and successors of a node that just completed */
+    if (sched->prec) prec_tick(sched, curr);
+
     /* Check for deadline violations */
     check_deadlines(sched);
+
+    /* Idle accounting and sleep decisions see this tick's releases */
+    if (sched->dpm) dpm_tick(sched, curr);
 }
 
 /* ── Time Advancement ─────────────────────────────────────────────── */
@@ -12,6 +12,7 @@
 #define RTOS_TIME_H
 
 #include "scheduler.h"
+#include <stdbool.h>
 #include <stdint.h>
 
 /* ── Public API ───────────────────────────────────────────────────── */
@@ -19,6 +20,26 @@
 /** Process one system tick: update counters, releases, deadlines. */
 void tick_handler(Scheduler *sched);
 
+/**
+ * Release a new job of `task` at the current tick: set its deadline and
+ * work, run the per-job hooks and make it READY. Returns false if an
+ * extension withheld the job (shed or skipped).
+ */
+bool release_job(Scheduler *sched, TaskControlBlock *task);
+
+/**
+ * Make READY the delayed tasks whose wake tick has come. Only the head
+ * of the sleep queue is examined when no delay ends.
+ */
+void wake_delayed_tasks(Scheduler *sched);
+
+/**
+ * Earliest future tick at which a task becomes ready by time alone: the
+ * next periodic release or the first wake of the sleep queue
+ * (UINT64_MAX if none). Used to program a tickless wake-up.
+ */
+uint64_t next_event_tick(const Scheduler *sched);
+
 /** Check and release periodic tasks whose period boundary is reached. */
 void check_periodic_releases(Scheduler *sched);
 
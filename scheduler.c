@@ -10,6 +10,9 @@
 
 #include "scheduler.h"
 #include "timeline.h"
+#include "dpm.h"
+#include "cyclic.h"
+#include "iodev.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -72,6 +75,39 @@ void scheduler_destroy(Scheduler *sched)
         timeline_destroy(sched->timeline);
         sched->timeline = NULL;
     }
+
+    free(sched->memguard);
+    sched->memguard = NULL;
+    free(sched->mixcrit);
+    sched->mixcrit = NULL;
+    free(sched->modes);
+    sched->modes = NULL;
+    free(sched->elastic);
+    sched->elastic = NULL;
+    free(sched->mkfirm);
+    sched->mkfirm = NULL;
+    free(sched->dvfs);
+    sched->dvfs = NULL;
+    free(sched->dpm);
+    sched->dpm = NULL;
+    free(sched->cyclic);
+    sched->cyclic = NULL;
+    free(sched->let);
+    sched->let = NULL;
+    free(sched->prec);
+    sched->prec = NULL;
+    free(sched->isr);
+    sched->isr = NULL;
+    free(sched->timers);
+    sched->timers = NULL;
+    /* Devices the caller did not destroy go with the core */
+    for (int i = 0; sched->io && i < sched->io->count; i++) {
+        free(sched->io->dev[i]);
+    }
+    free(sched->io);
+    sched->io = NULL;
+    free(sched->inject);
+    sched->inject = NULL;
 }
 
 /* ── Ready Queue (priority-sorted array) ──────────────────────────── */
@@ -141,10 +177,53 @@ bool ready_queue_empty(const Scheduler *sched)
     return (!sched || sched->ready_count == 0);
 }
 
+/* ── Sleep Queue ──────────────────────────────────────────────────── */
+
+void sleep_queue_insert(Scheduler *sched, TaskControlBlock *task)
+{
+    if (!sched || !task || task->delayed) return;
+
+    TaskControlBlock *prev = NULL, *pos = sched->sleep_head;
+    while (pos && pos->wake_tick <= task->wake_tick) {
+        prev = pos;
+        pos  = pos->next;
+    }
+    task->prev = prev;
+    task->next = pos;
+    if (prev) prev->next = task;
+    else      sched->sleep_head = task;
+    if (pos) pos->prev = task;
+
+    task->delayed = true;
+    sched->sleep_count++;
+}
+
+bool sleep_queue_remove(Scheduler *sched, TaskControlBlock *task)
+{
+    if (!sched || !task || !task->delayed) return false;
+
+    if (task->prev) task->prev->next = task->next;
+    else            sched->sleep_head = task->next;
+    if (task->next) task->next->prev = task->prev;
+    task->next = task->prev = NULL;
+
+    task->delayed = false;
+    sched->sleep_count--;
+    return true;
+}
+
+TaskControlBlock *sleep_queue_peek(const Scheduler *sched)
+{
+    return sched ? sched->sleep_head : NULL;
+}
+
 /* ── Core Scheduling ──────────────────────────────────────────────── */
 
 TaskControlBlock *scheduler_get_next_task(Scheduler *sched)
 {
+    /* A sleeping or transitioning core dispatches nothing */
+    if (dpm_core_asleep(sched)) return sched->idle_task;
+
     TaskControlBlock *next = ready_queue_peek(sched);
     return next ? next : sched->idle_task;
 }
@@ -154,7 +233,7 @@ void scheduler_context_switch(Scheduler *sched,
                               TaskControlBlock *to)
 {
     if (!sched || !to) return;
-    if (from == to) return;
+    if (from == to && to->state == TASK_RUNNING) return;
 
     /* Transition outgoing task */
     if (from && from->state == TASK_RUNNING) {
@@ -187,10 +266,18 @@ void scheduler_schedule(Scheduler *sched)
 {
     if (!sched) return;
 
+    /* Table-driven dispatch: no online priority decision */
+    if (sched->cyclic && sched->cyclic->active) {
+        cyclic_dispatch(sched);
+        return;
+    }
+
     TaskControlBlock *next = scheduler_get_next_task(sched);
     TaskControlBlock *curr = sched->current_task;
 
-    if (next == curr) return;
+    /* A current task that left RUNNING and was made ready again in the
+       same tick (e.g. aborted and re-released) must be re-dispatched */
+    if (next == curr && curr->state == TASK_RUNNING) return;
 
     /* Only preempt if next has strictly higher priority */
     if (curr && curr->state == TASK_RUNNING) {
@@ -284,7 +371,7 @@ double rms_utilization(const Scheduler *sched)
     for (int i = 0; i < sched->task_count; i++) {
         TaskControlBlock *t = sched->all_tasks[i];
         if (t && t->period > 0 && t != sched->idle_task) {
-            u += (double)t->remaining_work / (double)t->period;
+            u += (double)t->wcet / (double)t->period;
         }
     }
     return u;
@@ -340,9 +427,9 @@ void rms_print_report(const Scheduler *sched)
     for (int i = 0; i < sched->task_count; i++) {
         TaskControlBlock *t = sched->all_tasks[i];
         if (t && t->period > 0 && t != sched->idle_task) {
-            double util = (double)t->remaining_work / (double)t->period;
+            double util = (double)t->wcet / (double)t->period;
             printf("  %-15s %8" PRIu64 " %8" PRIu64 " %8d %9.3f\n",
-                   t->name, t->period, t->remaining_work,
+                   t->name, t->period, t->wcet,
                    t->priority, util);
         }
     }
@@ -351,3 +438,27 @@ void rms_print_report(const Scheduler *sched)
     rms_schedulability_test(sched);
     printf("\n");
 }
+
+/* ── Hyperperiod ──────────────────────────────────────────────────── */
+
+static uint64_t gcd_u64(uint64_t a, uint64_t b)
+{
+    while (b != 0) {
+        uint64_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+uint64_t scheduler_hyperperiod(const Scheduler *sched)
+{
+    if (!sched) return 0;
+    uint64_t h = 0;
+    for (int i = 0; i < sched->task_count; i++) {
+        TaskControlBlock *t = sched->all_tasks[i];
+        if (!t || t->period == 0 || t == sched->idle_task) continue;
+        h = (h == 0) ? t->period : h / gcd_u64(h, t->period) * t->period;
+    }
+    return h;
+}
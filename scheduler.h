@@ -16,6 +16,21 @@
 
 /* ── Forward declarations ─────────────────────────────────────────── */
 typedef struct Timeline Timeline;
+typedef struct MemGuard MemGuard;
+typedef struct MixedCrit MixedCrit;
+typedef struct ModeManager ModeManager;
+typedef struct ElasticState ElasticState;
+typedef struct MkFirmState MkFirmState;
+typedef struct DvfsState DvfsState;
+typedef struct DpmState DpmState;
+typedef struct CyclicExec CyclicExec;
+typedef struct LetState LetState;
+typedef struct PrecState PrecState;
+typedef struct IsrState IsrState;
+typedef struct TimerState TimerState;
+typedef struct IoState IoState;
+typedef struct InjectState InjectState;
+typedef struct EventStream EventStream;
 
 /* ── Constants ────────────────────────────────────────────────────── */
 #define MAX_READY_TASKS   64
@@ -39,6 +54,10 @@ struct Scheduler {
     TaskControlBlock    *ready_queue[MAX_READY_TASKS];
     int                  ready_count;
 
+    /* Delayed tasks (sorted by wake tick, linked through next/prev) */
+    TaskControlBlock    *sleep_head;
+    int                  sleep_count;
+
     /* All tasks in the system */
     TaskControlBlock    *all_tasks[MAX_ALL_TASKS];
     int                  task_count;
@@ -52,6 +71,54 @@ struct Scheduler {
 
     /* Unique ID counter */
     int                  next_id;
+
+    /* SMP core index (0 on a uniprocessor) */
+    int                  core_id;
+
+    /* Memory bandwidth regulator (NULL = unregulated) */
+    MemGuard            *memguard;
+
+    /* Mixed-criticality mode state (NULL = single criticality) */
+    MixedCrit           *mixcrit;
+
+    /* Operating-mode manager (NULL = single mode) */
+    ModeManager         *modes;
+
+    /* Elastic period adaptation (NULL = fixed periods) */
+    ElasticState        *elastic;
+
+    /* (m,k)-firm deadline handling (NULL = hard deadlines) */
+    MkFirmState         *mkfirm;
+
+    /* Voltage/frequency scaling (NULL = fixed maximum frequency) */
+    DvfsState           *dvfs;
+
+    /* Idle power management (NULL = always awake) */
+    DpmState            *dpm;
+
+    /* Static schedule table (NULL = online priority dispatch) */
+    CyclicExec          *cyclic;
+
+    /* Task communication channels (NULL = none) */
+    LetState            *let;
+
+    /* Precedence graphs (NULL = independent tasks) */
+    PrecState           *prec;
+
+    /* Interrupt sources (NULL = no interrupts) */
+    IsrState            *isr;
+
+    /* Software timer wheel and daemon (NULL = no timers) */
+    TimerState          *timers;
+
+    /* Simulated I/O devices (NULL = none) */
+    IoState             *io;
+
+    /* Events posted by other host threads (NULL = not accepted) */
+    InjectState         *inject;
+
+    /* Replayed event input (NULL = none; closed by its owner) */
+    EventStream         *stream;
 };
 
 /* ── Public API ───────────────────────────────────────────────────── */
@@ -80,6 +147,17 @@ TaskControlBlock *ready_queue_pop(Scheduler *sched);
 /** Check if the ready queue is empty. */
 bool ready_queue_empty(const Scheduler *sched);
 
+/* ── Sleep Queue ──────────────────────────────────────────────────── */
+
+/** Insert a delayed task in wake-tick order (FIFO among equal ticks). */
+void sleep_queue_insert(Scheduler *sched, TaskControlBlock *task);
+
+/** Remove a task from the sleep queue. Returns true if it was on it. */
+bool sleep_queue_remove(Scheduler *sched, TaskControlBlock *task);
+
+/** The delayed task that wakes first (NULL if none). */
+TaskControlBlock *sleep_queue_peek(const Scheduler *sched);
+
 /* ── Core Scheduling ──────────────────────────────────────────────── */
 
 /** Run the scheduling algorithm: pick highest-priority task, switch. */
@@ -115,4 +193,7 @@ void rms_schedulability_test(const Scheduler *sched);
 /** Print a detailed RMS analysis report. */
 void rms_print_report(const Scheduler *sched);
 
+/** LCM of all periodic task periods (0 if there are none). */
+uint64_t scheduler_hyperperiod(const Scheduler *sched);
+
 #endif /* SCHEDULER_H */
@@ -9,6 +9,7 @@
 
 #include "semaphore.h"
 #include "scheduler.h"
+#include "waitany.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -16,11 +17,11 @@
 
 /* ── Wait-queue helpers ───────────────────────────────────────────── */
 
-static void sem_wait_queue_insert(Semaphore *sem, TaskControlBlock *task)
+static bool sem_wait_queue_insert(Semaphore *sem, TaskControlBlock *task)
 {
     if (sem->wait_count >= SEM_WAIT_QUEUE_CAP) {
         fprintf(stderr, "semaphore wait queue full for %s\n", sem->name);
-        return;
+        return false;
     }
     /* Priority-ordered insertion */
     int pos = sem->wait_count;
@@ -35,6 +36,7 @@ static void sem_wait_queue_insert(Semaphore *sem, TaskControlBlock *task)
     }
     sem->wait_queue[pos] = task;
     sem->wait_count++;
+    return true;
 }
 
 static TaskControlBlock *sem_wait_queue_pop(Semaphore *sem)
@@ -94,9 +96,37 @@ void semaphore_signal(Semaphore *sem, TaskControlBlock *task)
 
     if (sem->wait_count > 0) {
         TaskControlBlock *waiter = sem_wait_queue_pop(sem);
+        if (waiter->wait_set) wait_any_wake(waiter, sem);
         task_set_state(waiter, TASK_READY);
         scheduler_schedule(sem->scheduler);
     } else if (sem->count < sem->max_count) {
         sem->count++;
     }
 }
+
+/* ── Multi-object waits ───────────────────────────────────────────── */
+
+bool semaphore_try_wait(Semaphore *sem)
+{
+    if (!sem || sem->count == 0) return false;
+    sem->count--;
+    return true;
+}
+
+bool semaphore_add_waiter(Semaphore *sem, TaskControlBlock *task)
+{
+    return sem && task && sem_wait_queue_insert(sem, task);
+}
+
+void semaphore_remove_waiter(Semaphore *sem, TaskControlBlock *task)
+{
+    if (!sem) return;
+    for (int i = 0; i < sem->wait_count; i++) {
+        if (sem->wait_queue[i] != task) continue;
+        for (int j = i; j < sem->wait_count - 1; j++) {
+            sem->wait_queue[j] = sem->wait_queue[j + 1];
+        }
+        sem->wait_count--;
+        return;
+    }
+}
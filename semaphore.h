@@ -12,6 +12,7 @@
 #define SEMAPHORE_H
 
 #include "task.h"
+#include <stdbool.h>
 
 /* ── Forward declarations ─────────────────────────────────────────── */
 typedef struct Scheduler Scheduler;
@@ -47,4 +48,15 @@ void semaphore_wait(Semaphore *sem, TaskControlBlock *task);
 /** Signal (V operation). Wakes one waiter or increments count. */
 void semaphore_signal(Semaphore *sem, TaskControlBlock *task);
 
+/* ── Multi-object waits (waitany.c) ───────────────────────────────── */
+
+/** Take a unit if one is available, without blocking. */
+bool semaphore_try_wait(Semaphore *sem);
+
+/** Queue `task` as a waiter without blocking it. */
+bool semaphore_add_waiter(Semaphore *sem, TaskControlBlock *task);
+
+/** Take `task` off the wait queue, if it is on it. */
+void semaphore_remove_waiter(Semaphore *sem, TaskControlBlock *task);
+
 #endif /* SEMAPHORE_H */
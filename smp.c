@@ -0,0 +1,605 @@
+/*
+ * smp.c - Partitioned Multicore Simulation
+ *
+ * Conservative parallel discrete-event stepping of per-core schedulers.
+ * Every cross-core interaction has a latency of `lookahead` ticks, so
+ * within one lookahead window the cores are fully independent and can
+ * run on separate host threads. At each window boundary the per-core
+ * message buffers are merged by (tick, core, sequence) and applied on
+ * the coordinating thread, which keeps results deterministic.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "smp.h"
+#include "rtos_time.h"
+#include "timeline.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+
+/* ── Helpers ──────────────────────────────────────────────────────── */
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static int core_of(const TaskControlBlock *task)
+{
+    return task->scheduler ? task->scheduler->core_id : 0;
+}
+
+/* ── Initialization ───────────────────────────────────────────────── */
+
+void smp_init(SmpSystem *sys, int core_count, SchedPolicy policy,
+              bool priority_inheritance_enabled, uint64_t lookahead)
+{
+    if (!sys) return;
+    memset(sys, 0, sizeof(SmpSystem));
+
+    if (core_count < 1)             core_count = 1;
+    if (core_count > SMP_MAX_CORES) core_count = SMP_MAX_CORES;
+
+    sys->core_count = core_count;
+    sys->mode       = SMP_RUN_SEQUENTIAL;
+    sys->lookahead  = (lookahead > 0) ? lookahead : 1;
+
+    for (int c = 0; c < core_count; c++) {
+        scheduler_init(&sys->cores[c], policy, priority_inheritance_enabled);
+        sys->cores[c].core_id = c;
+        atomic_init(&sys->outbox[c].head, 0);
+        atomic_init(&sys->outbox[c].tail, 0);
+    }
+}
+
+void smp_destroy(SmpSystem *sys)
+{
+    if (!sys) return;
+    for (int c = 0; c < sys->core_count; c++) {
+        scheduler_destroy(&sys->cores[c]);
+    }
+    workpool_destroy(sys->pool);
+    sys->pool       = NULL;
+    sys->core_count = 0;
+}
+
+Scheduler *smp_core(SmpSystem *sys, int core)
+{
+    if (!sys || core < 0 || core >= sys->core_count) return NULL;
+    return &sys->cores[core];
+}
+
+void smp_set_run_mode(SmpSystem *sys, SmpRunMode mode)
+{
+    if (sys) sys->mode = mode;
+}
+
+void smp_set_tick_hook(SmpSystem *sys, SmpTickHook hook, void *ctx)
+{
+    if (!sys) return;
+    sys->hook     = hook;
+    sys->hook_ctx = ctx;
+}
+
+void smp_set_body_exec(SmpSystem *sys, SmpBodyMode mode, int workers)
+{
+    if (!sys) return;
+
+    workpool_destroy(sys->pool);
+    sys->pool = NULL;
+
+    if (mode == SMP_BODIES_POOL) {
+        sys->pool = workpool_create(workers);
+        if (!sys->pool) {
+            fprintf(stderr, "smp_set_body_exec: cannot create pool\n");
+            mode = SMP_BODIES_INLINE;
+        }
+    }
+    sys->body_mode = mode;
+}
+
+/* ── Per-core message buffers (lock-free SPSC ring) ───────────────── */
+
+static bool outbox_push(SmpSystem *sys, int core, SmpMessage msg)
+{
+    SmpMsgBuffer *box = &sys->outbox[core];
+    uint32_t tail = atomic_load_explicit(&box->tail, memory_order_relaxed);
+    uint32_t head = atomic_load_explicit(&box->head, memory_order_acquire);
+
+    if (tail - head >= SMP_MSG_BUF_CAP) {
+        box->dropped++;
+        fprintf(stderr, "smp: core %d message buffer full\n", core);
+        return false;
+    }
+
+    msg.src_core = core;
+    msg.tick     = sys->cores[core].system_ticks;
+    msg.seq      = box->next_seq++;
+    box->slots[tail % SMP_MSG_BUF_CAP] = msg;
+    atomic_store_explicit(&box->tail, tail + 1, memory_order_release);
+    return true;
+}
+
+static int outbox_drain(SmpSystem *sys, int core, SmpMessage *out, int max)
+{
+    SmpMsgBuffer *box = &sys->outbox[core];
+    uint32_t head = atomic_load_explicit(&box->head, memory_order_relaxed);
+    uint32_t tail = atomic_load_explicit(&box->tail, memory_order_acquire);
+    int n = 0;
+
+    while (head != tail && n < max) {
+        out[n++] = box->slots[head % SMP_MSG_BUF_CAP];
+        head++;
+    }
+    atomic_store_explicit(&box->head, head, memory_order_release);
+    return n;
+}
+
+/* ── Global mutex ─────────────────────────────────────────────────── */
+
+SmpGlobalMutex *smp_global_mutex_create(const char *name)
+{
+    SmpGlobalMutex *gm = calloc(1, sizeof(SmpGlobalMutex));
+    if (!gm) return NULL;
+    snprintf(gm->name, SMP_GMUTEX_NAME_MAX, "%s", name);
+    return gm;
+}
+
+void smp_global_mutex_destroy(SmpGlobalMutex *gm)
+{
+    free(gm);
+}
+
+bool smp_global_lock(SmpSystem *sys, int core, SmpGlobalMutex *gm,
+                     TaskControlBlock *task)
+{
+    if (!sys || !gm || !task) return false;
+
+    /* Post first: a request that never reaches the coordinator must
+       not leave the task blocked */
+    SmpMessage msg = { .type = SMP_MSG_GLOBAL_LOCK, .task = task,
+                       .gmtx = gm };
+    if (!outbox_push(sys, core, msg)) return false;
+
+    /* Block locally until the coordinator grants the request */
+    task_set_state(task, TASK_BLOCKED);
+    return true;
+}
+
+bool smp_global_unlock(SmpSystem *sys, int core, SmpGlobalMutex *gm,
+                       TaskControlBlock *task)
+{
+    if (!sys || !gm || !task) return false;
+    SmpMessage msg = { .type = SMP_MSG_GLOBAL_UNLOCK, .task = task,
+                       .gmtx = gm };
+    return outbox_push(sys, core, msg);
+}
+
+bool smp_post_wakeup(SmpSystem *sys, int src_core,
+                     TaskControlBlock *target)
+{
+    if (!sys || !target) return false;
+    SmpMessage msg = { .type = SMP_MSG_WAKEUP, .task = target };
+    return outbox_push(sys, src_core, msg);
+}
+
+/* ── Synchronization point ────────────────────────────────────────── */
+
+static int cmp_message(const void *a, const void *b)
+{
+    const SmpMessage *ma = a;
+    const SmpMessage *mb = b;
+    if (ma->tick != mb->tick)         return (ma->tick < mb->tick) ? -1 : 1;
+    if (ma->src_core != mb->src_core) return ma->src_core - mb->src_core;
+    if (ma->seq != mb->seq)           return (ma->seq < mb->seq) ? -1 : 1;
+    return 0;
+}
+
+static void gm_grant(SmpGlobalMutex *gm, TaskControlBlock *task)
+{
+    Scheduler *sched = task->scheduler;
+    gm->owner = task;
+    gm->acquisitions++;
+    task_set_state(task, TASK_READY);
+
+    if (sched->timeline) {
+        char buf[ANNOTATION_MAX];
+        snprintf(buf, sizeof(buf), "%s acquires global %s (core %d)",
+                 task->name, gm->name, core_of(task));
+        timeline_record(sched->timeline, sched->system_ticks,
+                        task, VIS_NONE, buf);
+    }
+}
+
+static void gm_enqueue(SmpGlobalMutex *gm, TaskControlBlock *task)
+{
+    if (gm->wait_count >= SMP_GMUTEX_WAIT_CAP) {
+        fprintf(stderr, "global mutex wait queue full for %s\n", gm->name);
+        return;
+    }
+    int pos = gm->wait_count;
+    for (int i = 0; i < gm->wait_count; i++) {
+        if (task->priority < gm->wait_queue[i]->priority) {
+            pos = i;
+            break;
+        }
+    }
+    for (int i = gm->wait_count; i > pos; i--) {
+        gm->wait_queue[i] = gm->wait_queue[i - 1];
+    }
+    gm->wait_queue[pos] = task;
+    gm->wait_count++;
+}
+
+static void apply_message(const SmpMessage *msg)
+{
+    TaskControlBlock *task = msg->task;
+    SmpGlobalMutex   *gm   = msg->gmtx;
+    Scheduler        *sched = task->scheduler;
+
+    switch (msg->type) {
+    case SMP_MSG_WAKEUP:
+        if (task->state == TASK_SUSPENDED) {
+            task_resume(task);
+            if (sched->timeline) {
+                char buf[ANNOTATION_MAX];
+                snprintf(buf, sizeof(buf),
+                         "%s woken by core %d (posted t=%" PRIu64 ")",
+                         task->name, msg->src_core, msg->tick);
+                timeline_record(sched->timeline, sched->system_ticks,
+                                task, VIS_NONE, buf);
+            }
+        }
+        break;
+
+    case SMP_MSG_GLOBAL_LOCK:
+        if (!gm->owner) {
+            gm_grant(gm, task);
+        } else {
+            gm->contentions++;
+            gm_enqueue(gm, task);
+        }
+        break;
+
+    case SMP_MSG_GLOBAL_UNLOCK:
+        if (gm->owner != task) {
+            fprintf(stderr, "smp_global_unlock: %s is not owner of %s\n",
+                    task->name, gm->name);
+            break;
+        }
+        gm->owner = NULL;
+        if (sched->timeline) {
+            char buf[ANNOTATION_MAX];
+            snprintf(buf, sizeof(buf), "%s releases global %s",
+                     task->name, gm->name);
+            timeline_record(sched->timeline, sched->system_ticks,
+                            task, VIS_NONE, buf);
+        }
+        if (gm->wait_count > 0) {
+            TaskControlBlock *next = gm->wait_queue[0];
+            for (int i = 0; i < gm->wait_count - 1; i++) {
+                gm->wait_queue[i] = gm->wait_queue[i + 1];
+            }
+            gm->wait_count--;
+            gm_grant(gm, next);
+        }
+        break;
+    }
+}
+
+static void smp_sync(SmpSystem *sys)
+{
+    SmpMessage batch[SMP_MAX_CORES * SMP_MSG_BUF_CAP];
+    int n = 0;
+
+    for (int c = 0; c < sys->core_count; c++) {
+        n += outbox_drain(sys, c, batch + n, SMP_MSG_BUF_CAP);
+    }
+
+    /* Deterministic merge: post tick, then core, then post order */
+    qsort(batch, (size_t)n, sizeof(SmpMessage), cmp_message);
+    for (int i = 0; i < n; i++) {
+        apply_message(&batch[i]);
+    }
+
+    for (int c = 0; c < sys->core_count; c++) {
+        scheduler_schedule(&sys->cores[c]);
+    }
+
+    sys->sync_points++;
+    sys->messages_applied += (uint64_t)n;
+}
+
+/* ── Core stepping ────────────────────────────────────────────────── */
+
+static void smp_core_tick(SmpSystem *sys, int core)
+{
+    Scheduler *sched = &sys->cores[core];
+
+    tick_handler(sched);
+
+    /* Job completion: periodic tasks wait for their next release */
+    TaskControlBlock *curr = sched->current_task;
+    if (curr && curr != sched->idle_task &&
+        curr->state == TASK_RUNNING && curr->remaining_work == 0)
+    {
+        task_set_state(curr, curr->period > 0 ? TASK_SUSPENDED
+                                              : TASK_TERMINATED);
+    }
+
+    if (sys->hook) sys->hook(sys, core, sys->hook_ctx);
+
+    scheduler_schedule(sched);
+}
+
+/* Task whose body executes on `core` during the upcoming tick */
+static TaskControlBlock *body_due(SmpSystem *sys, int core)
+{
+    Scheduler        *sched = &sys->cores[core];
+    TaskControlBlock *curr  = sched->current_task;
+    if (!curr || curr == sched->idle_task ||
+        curr->state != TASK_RUNNING || !curr->func) {
+        return NULL;
+    }
+    sys->bodies_run[core]++;
+    return curr;
+}
+
+static void smp_core_window(SmpSystem *sys, int core, uint64_t ticks)
+{
+    for (uint64_t i = 0; i < ticks; i++) {
+        if (sys->body_mode != SMP_BODIES_OFF) {
+            TaskControlBlock *t = body_due(sys, core);
+            if (t) t->func(t->arg);
+        }
+        smp_core_tick(sys, core);
+    }
+}
+
+/* Tick-major stepping: the bodies of every core for one tick form a
+   pool batch, joined before any core accounts that tick */
+static void smp_pool_window(SmpSystem *sys, uint64_t ticks)
+{
+    for (uint64_t i = 0; i < ticks; i++) {
+        for (int c = 0; c < sys->core_count; c++) {
+            TaskControlBlock *t = body_due(sys, c);
+            if (t) workpool_submit(sys->pool, t->func, t->arg);
+        }
+        workpool_run(sys->pool);
+        for (int c = 0; c < sys->core_count; c++) {
+            smp_core_tick(sys, c);
+        }
+    }
+}
+
+/* ── Parallel execution ───────────────────────────────────────────── */
+
+typedef struct {
+    SmpSystem          *sys;
+    pthread_barrier_t   start;
+    pthread_barrier_t   done;
+    uint64_t            window;
+    bool                stop;
+} SmpParallelCtx;
+
+typedef struct {
+    SmpParallelCtx *ctx;
+    int             core;
+} SmpWorkerArg;
+
+static void *smp_core_thread(void *p)
+{
+    SmpWorkerArg   *arg = p;
+    SmpParallelCtx *ctx = arg->ctx;
+
+    for (;;) {
+        pthread_barrier_wait(&ctx->start);
+        if (ctx->stop) break;
+        smp_core_window(ctx->sys, arg->core, ctx->window);
+        pthread_barrier_wait(&ctx->done);
+    }
+    return NULL;
+}
+
+static uint64_t next_window(const SmpSystem *sys, uint64_t end)
+{
+    uint64_t boundary = (sys->system_ticks / sys->lookahead + 1) *
+                        sys->lookahead;
+    return ((boundary < end) ? boundary : end) - sys->system_ticks;
+}
+
+static void smp_run_parallel(SmpSystem *sys, uint64_t end)
+{
+    SmpParallelCtx ctx;
+    SmpWorkerArg   args[SMP_MAX_CORES];
+    pthread_t      threads[SMP_MAX_CORES];
+    unsigned       parties = (unsigned)sys->core_count + 1;
+
+    ctx.sys    = sys;
+    ctx.window = 0;
+    ctx.stop   = false;
+    pthread_barrier_init(&ctx.start, NULL, parties);
+    pthread_barrier_init(&ctx.done,  NULL, parties);
+
+    for (int c = 0; c < sys->core_count; c++) {
+        args[c].ctx  = &ctx;
+        args[c].core = c;
+        pthread_create(&threads[c], NULL, smp_core_thread, &args[c]);
+    }
+
+    while (sys->system_ticks < end) {
+        ctx.window = next_window(sys, end);
+        pthread_barrier_wait(&ctx.start);
+        pthread_barrier_wait(&ctx.done);
+        sys->system_ticks += ctx.window;
+        smp_sync(sys);
+    }
+
+    ctx.stop = true;
+    pthread_barrier_wait(&ctx.start);
+    for (int c = 0; c < sys->core_count; c++) {
+        pthread_join(threads[c], NULL);
+    }
+    pthread_barrier_destroy(&ctx.start);
+    pthread_barrier_destroy(&ctx.done);
+}
+
+void smp_run(SmpSystem *sys, uint64_t ticks)
+{
+    if (!sys || ticks == 0) return;
+
+    uint64_t end = sys->system_ticks + ticks;
+    uint64_t t0  = now_ns();
+
+    if (sys->mode == SMP_RUN_PARALLEL && sys->core_count > 1) {
+        smp_run_parallel(sys, end);
+    } else {
+        while (sys->system_ticks < end) {
+            uint64_t window = next_window(sys, end);
+            if (sys->body_mode == SMP_BODIES_POOL) {
+                smp_pool_window(sys, window);
+            } else {
+                for (int c = 0; c < sys->core_count; c++) {
+                    smp_core_window(sys, c, window);
+                }
+            }
+            sys->system_ticks += window;
+            smp_sync(sys);
+        }
+    }
+
+    sys->last_run_ns = now_ns() - t0;
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+static uint64_t fnv1a(uint64_t h, const void *data, size_t len)
+{
+    const uint8_t *p = data;
+    for (size_t i = 0; i < len; i++) {
+        h ^= p[i];
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+uint64_t smp_fingerprint(const SmpSystem *sys)
+{
+    uint64_t h = 1469598103934665603ull;
+    if (!sys) return h;
+
+    for (int c = 0; c < sys->core_count; c++) {
+        const Scheduler *sched = &sys->cores[c];
+        const Timeline  *tl    = sched->timeline;
+
+        for (int e = 0; tl && e < tl->count; e++) {
+            const TimelineEntry *ent = &tl->entries[e];
+            int id = ent->task ? ent->task->id : -1;
+            h = fnv1a(h, &ent->tick,  sizeof(ent->tick));
+            h = fnv1a(h, &id,         sizeof(id));
+            h = fnv1a(h, &ent->state, sizeof(ent->state));
+            h = fnv1a(h, ent->annotation, strlen(ent->annotation));
+        }
+        for (int i = 0; i < sched->task_count; i++) {
+            const TaskControlBlock *t = sched->all_tasks[i];
+            h = fnv1a(h, &t->total_exec_time, sizeof(t->total_exec_time));
+            h = fnv1a(h, &t->invocations,     sizeof(t->invocations));
+            h = fnv1a(h, &t->deadline_misses, sizeof(t->deadline_misses));
+            h = fnv1a(h, &t->preemptions,     sizeof(t->preemptions));
+        }
+        h = fnv1a(h, &sched->context_switches,
+                  sizeof(sched->context_switches));
+    }
+    return h;
+}
+
+void smp_print_events(const SmpSystem *sys, int max_events)
+{
+    if (!sys) return;
+
+    int pos[SMP_MAX_CORES] = { 0 };
+    int printed = 0;
+
+    printf("\nMerged Events Log (%d cores):\n", sys->core_count);
+    for (;;) {
+        /* Pick the earliest pending entry; lower core wins ties */
+        int best = -1;
+        for (int c = 0; c < sys->core_count; c++) {
+            const Timeline *tl = sys->cores[c].timeline;
+            if (!tl || pos[c] >= tl->count) continue;
+            if (best < 0 ||
+                tl->entries[pos[c]].tick <
+                sys->cores[best].timeline->entries[pos[best]].tick) {
+                best = c;
+            }
+        }
+        if (best < 0) break;
+
+        const TimelineEntry *ent =
+            &sys->cores[best].timeline->entries[pos[best]++];
+        if (ent->annotation[0] == '\0') continue;
+        if (max_events > 0 && printed >= max_events) {
+            printf("  ...\n");
+            break;
+        }
+        printf("  [t=%-4" PRIu64 "] C%-2d %s\n",
+               ent->tick, best, ent->annotation);
+        printed++;
+    }
+}
+
+void smp_print_report(const SmpSystem *sys)
+{
+    if (!sys) return;
+
+    printf("\n  %-6s %6s %10s %8s %10s %8s\n",
+           "Core", "Tasks", "Busy", "Util", "CtxSw", "Misses");
+    printf("  %-6s %6s %10s %8s %10s %8s\n",
+           "----", "-----", "----", "----", "-----", "------");
+
+    for (int c = 0; c < sys->core_count; c++) {
+        const Scheduler *sched = &sys->cores[c];
+        uint64_t busy   = 0;
+        uint32_t misses = 0;
+        for (int i = 0; i < sched->task_count; i++) {
+            const TaskControlBlock *t = sched->all_tasks[i];
+            if (t == sched->idle_task) continue;
+            busy   += t->total_exec_time;
+            misses += t->deadline_misses;
+        }
+        double util = sched->system_ticks
+                    ? 100.0 * (double)busy / (double)sched->system_ticks
+                    : 0.0;
+        printf("  C%-5d %6d %10" PRIu64 " %7.1f%% %10" PRIu64 " %8u\n",
+               c, sched->task_count - 1, busy, util,
+               sched->context_switches, misses);
+    }
+
+    printf("\n  Lookahead        : %" PRIu64 " ticks\n", sys->lookahead);
+    printf("  Sync points      : %" PRIu64 "\n", sys->sync_points);
+    printf("  Messages applied : %" PRIu64 "\n", sys->messages_applied);
+    printf("  Run mode         : %s\n",
+           sys->mode == SMP_RUN_PARALLEL ? "parallel" : "sequential");
+    printf("  Wall time        : %.3f ms\n",
+           (double)sys->last_run_ns / 1e6);
+
+    if (sys->body_mode != SMP_BODIES_OFF) {
+        uint64_t bodies = 0;
+        for (int c = 0; c < sys->core_count; c++) {
+            bodies += sys->bodies_run[c];
+        }
+        printf("  Task bodies run  : %" PRIu64 " (%s)\n", bodies,
+               sys->body_mode == SMP_BODIES_POOL ? "worker pool" : "inline");
+        workpool_print_stats(sys->pool);
+    }
+}
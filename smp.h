@@ -0,0 +1,184 @@
+/*
+ * smp.h - Partitioned Multicore Simulation
+ *
+ * Models an SMP system as one Scheduler per simulated core. Cores are
+ * stepped in lookahead windows, either sequentially on the calling
+ * thread or in parallel on one host thread per core. Cross-core
+ * interactions (global mutexes, wakeups) are posted into lock-free
+ * per-core buffers and applied at window boundaries in a fixed order,
+ * so both run modes produce bit-identical results.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef SMP_H
+#define SMP_H
+
+#include "scheduler.h"
+#include "workpool.h"
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define SMP_MAX_CORES         16
+#define SMP_MSG_BUF_CAP       256   /* Per-core messages per window   */
+#define SMP_GMUTEX_NAME_MAX   32
+#define SMP_GMUTEX_WAIT_CAP   (SMP_MAX_CORES * 4)
+
+/* ── Run mode ─────────────────────────────────────────────────────── */
+typedef enum {
+    SMP_RUN_SEQUENTIAL,     /* All cores stepped on the calling thread */
+    SMP_RUN_PARALLEL        /* One host thread per simulated core      */
+} SmpRunMode;
+
+/* ── Task body execution ──────────────────────────────────────────── */
+typedef enum {
+    SMP_BODIES_OFF,         /* Only the simulated work counters advance */
+    SMP_BODIES_INLINE,      /* Bodies run on the core-stepping thread   */
+    SMP_BODIES_POOL         /* Bodies of all cores dispatched per tick
+                               to a work-stealing host worker pool      */
+} SmpBodyMode;
+
+/* ── Global (cross-core) mutex ────────────────────────────────────── */
+typedef struct SmpGlobalMutex {
+    char              name[SMP_GMUTEX_NAME_MAX];
+    TaskControlBlock *owner;
+
+    /* Priority-ordered waiters (ties broken by request order) */
+    TaskControlBlock *wait_queue[SMP_GMUTEX_WAIT_CAP];
+    int               wait_count;
+
+    uint32_t          acquisitions;
+    uint32_t          contentions;
+} SmpGlobalMutex;
+
+/* ── Cross-core message ───────────────────────────────────────────── */
+typedef enum {
+    SMP_MSG_WAKEUP,
+    SMP_MSG_GLOBAL_LOCK,
+    SMP_MSG_GLOBAL_UNLOCK
+} SmpMsgType;
+
+typedef struct {
+    SmpMsgType        type;
+    uint64_t          tick;        /* Core-local tick when posted     */
+    uint32_t          seq;         /* Per-core post order             */
+    int               src_core;
+    TaskControlBlock *task;
+    SmpGlobalMutex   *gmtx;
+} SmpMessage;
+
+/* Single-producer (owning core) / single-consumer (coordinator) ring */
+typedef struct {
+    SmpMessage        slots[SMP_MSG_BUF_CAP];
+    _Atomic uint32_t  head;        /* Next slot to consume            */
+    _Atomic uint32_t  tail;        /* Next slot to fill               */
+    uint32_t          next_seq;
+    uint32_t          dropped;     /* Pushes refused: buffer full     */
+} SmpMsgBuffer;
+
+typedef struct SmpSystem SmpSystem;
+
+/* Called on the core's own thread after every simulated tick. May only
+   touch that core's Scheduler and post cross-core messages. */
+typedef void (*SmpTickHook)(SmpSystem *sys, int core, void *ctx);
+
+/* ── System state ─────────────────────────────────────────────────── */
+struct SmpSystem {
+    int                 core_count;
+    Scheduler           cores[SMP_MAX_CORES];
+    SmpMsgBuffer        outbox[SMP_MAX_CORES];
+
+    SmpRunMode          mode;
+    uint64_t            lookahead;     /* Cross-core latency in ticks  */
+    uint64_t            system_ticks;  /* Last synchronized tick       */
+
+    SmpTickHook         hook;
+    void               *hook_ctx;
+
+    SmpBodyMode         body_mode;
+    WorkPool           *pool;          /* Owned; SMP_BODIES_POOL only  */
+
+    /* Statistics */
+    uint64_t            sync_points;
+    uint64_t            messages_applied;
+    uint64_t            bodies_run[SMP_MAX_CORES];
+    uint64_t            last_run_ns;   /* Wall time of last smp_run   */
+};
+
+/* ── Public API ───────────────────────────────────────────────────── */
+
+/**
+ * Initialize `core_count` cores, each with its own Scheduler.
+ * `lookahead` is the minimum latency of any cross-core interaction;
+ * cores run independently for that many ticks between sync points.
+ */
+void smp_init(SmpSystem *sys, int core_count, SchedPolicy policy,
+              bool priority_inheritance_enabled, uint64_t lookahead);
+
+/** Destroy all per-core schedulers. */
+void smp_destroy(SmpSystem *sys);
+
+/** Get the Scheduler of a core (NULL if out of range). */
+Scheduler *smp_core(SmpSystem *sys, int core);
+
+/** Select sequential or host-parallel stepping. */
+void smp_set_run_mode(SmpSystem *sys, SmpRunMode mode);
+
+/** Install the per-core tick hook (scenario / task-body logic). */
+void smp_set_tick_hook(SmpSystem *sys, SmpTickHook hook, void *ctx);
+
+/**
+ * Execute the TaskFunc of the task dispatched on each core once per
+ * simulated tick. In SMP_BODIES_POOL mode with sequential stepping the
+ * bodies of all cores for a tick are run on a pool of `workers` host
+ * threads and joined before the tick is accounted; with parallel
+ * stepping each core thread runs its own bodies inline.
+ */
+void smp_set_body_exec(SmpSystem *sys, SmpBodyMode mode, int workers);
+
+/** Advance every core by `ticks`, synchronizing at window boundaries. */
+void smp_run(SmpSystem *sys, uint64_t ticks);
+
+/* ── Cross-core objects ───────────────────────────────────────────── */
+
+SmpGlobalMutex *smp_global_mutex_create(const char *name);
+void            smp_global_mutex_destroy(SmpGlobalMutex *gm);
+
+/**
+ * Request `gm` for `task` running on `core`. The task blocks locally
+ * and is granted the mutex (and made READY) at the next sync point.
+ * Returns false, leaving the task running, if the core's message
+ * buffer is full for this window; the caller may retry later.
+ */
+bool smp_global_lock(SmpSystem *sys, int core, SmpGlobalMutex *gm,
+                     TaskControlBlock *task);
+
+/**
+ * Release `gm`; the hand-off happens at the next sync point. Returns
+ * false if the message buffer is full: the task still owns `gm`.
+ */
+bool smp_global_unlock(SmpSystem *sys, int core, SmpGlobalMutex *gm,
+                       TaskControlBlock *task);
+
+/**
+ * Resume a suspended task on another core at the next sync point.
+ * Returns false if the message buffer is full.
+ */
+bool smp_post_wakeup(SmpSystem *sys, int src_core,
+                     TaskControlBlock *target);
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+/** Hash of every core's timeline and task statistics. */
+uint64_t smp_fingerprint(const SmpSystem *sys);
+
+/** Print all cores' events merged by (tick, core, record order). */
+void smp_print_events(const SmpSystem *sys, int max_events);
+
+/** Print per-core utilization and synchronization statistics. */
+void smp_print_report(const SmpSystem *sys);
+
+#endif /* SMP_H */
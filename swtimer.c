@@ -0,0 +1,336 @@
+/*
+ * swtimer.c - Software Timers on a Hierarchical Timing Wheel
+ *
+ * Slot lists are doubly linked and each timer remembers the head of the
+ * list it is on, so unlinking needs no search. The wheel is advanced one
+ * tick at a time up to the current tick; processing tick T first
+ * cascades every level whose lower level wrapped at T, then fires the
+ * level-0 slot of T. An auto-reload timer is re-armed from its previous
+ * expiry, not from the tick its callback ran, so it does not drift.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "swtimer.h"
+#include "rtos_time.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+#define WHEEL_SPAN  (1ull << (SWTIMER_SLOT_BITS * SWTIMER_LEVELS))
+
+/* ── Helpers ──────────────────────────────────────────────────────── */
+
+static void timer_daemon_func(void *arg)
+{
+    (void)arg;  /* Callbacks are run by timer_service_tick() */
+}
+
+static void wheel_insert(TimerState *ts, SwTimer *t)
+{
+    uint64_t delta = (t->expires > ts->now) ? t->expires - ts->now : 0;
+    uint64_t at    = t->expires;
+    int level = 0;
+
+    while (level < SWTIMER_LEVELS - 1 &&
+           delta >= (1ull << (SWTIMER_SLOT_BITS * (level + 1)))) {
+        level++;
+    }
+    /* Beyond the wheel: park in the farthest slot and re-insert there */
+    if (delta >= WHEEL_SPAN) at = ts->now + WHEEL_SPAN - 1;
+
+    int idx = (int)((at >> (SWTIMER_SLOT_BITS * level)) &
+                    (SWTIMER_SLOTS - 1));
+    SwTimer **head = &ts->wheel[level][idx];
+    t->slot = head;
+    t->prev = NULL;
+    t->next = *head;
+    if (*head) (*head)->prev = t;
+    *head = t;
+}
+
+static void wheel_unlink(SwTimer *t)
+{
+    if (t->prev) t->prev->next = t->next;
+    else         *t->slot = t->next;
+    if (t->next) t->next->prev = t->prev;
+    t->slot = NULL;
+    t->prev = t->next = NULL;
+}
+
+static void arm(TimerState *ts, SwTimer *t, uint64_t expires)
+{
+    t->expires = expires;
+    t->active  = true;
+    wheel_insert(ts, t);
+    if (++ts->active > ts->active_max) ts->active_max = ts->active;
+}
+
+static void disarm(TimerState *ts, SwTimer *t)
+{
+    if (!t->active) return;
+    wheel_unlink(t);
+    t->active = false;
+    ts->active--;
+}
+
+static void queue_push(TimerState *ts, SwTimer *t, uint64_t at)
+{
+    t->queued    = true;
+    t->queued_at = at;
+    t->q_next    = NULL;
+    t->q_prev    = ts->q_tail;
+    if (ts->q_tail) ts->q_tail->q_next = t;
+    else            ts->q_head = t;
+    ts->q_tail = t;
+    ts->q_length++;
+}
+
+static void queue_unlink(TimerState *ts, SwTimer *t)
+{
+    if (!t->queued) return;
+    if (t->q_prev) t->q_prev->q_next = t->q_next;
+    else           ts->q_head = t->q_next;
+    if (t->q_next) t->q_next->q_prev = t->q_prev;
+    else           ts->q_tail = t->q_prev;
+    t->q_prev = t->q_next = NULL;
+    t->queued = false;
+    ts->q_length--;
+}
+
+static void fire(TimerState *ts, SwTimer *t, uint64_t now)
+{
+    t->active = false;
+    ts->active--;
+    t->expirations++;
+    ts->expirations++;
+    if (t->expires < now) ts->late_expiries++;
+
+    if (t->auto_reload) arm(ts, t, t->expires + t->period);
+
+    if (t->queued) {
+        t->overruns++;
+        ts->overruns++;
+    } else {
+        queue_push(ts, t, now);
+    }
+}
+
+static void wheel_advance(TimerState *ts, uint64_t to)
+{
+    while (ts->now < to) {
+        uint64_t now = ++ts->now;
+
+        /* Cascade each level whose lower level wrapped at this tick */
+        for (int level = 1; level < SWTIMER_LEVELS; level++) {
+            uint64_t shift = SWTIMER_SLOT_BITS * (uint64_t)level;
+            if (now & ((1ull << shift) - 1)) break;
+
+            int idx = (int)((now >> shift) & (SWTIMER_SLOTS - 1));
+            SwTimer *t = ts->wheel[level][idx];
+            ts->wheel[level][idx] = NULL;
+            while (t) {
+                SwTimer *next = t->next;
+                wheel_insert(ts, t);
+                ts->cascaded++;
+                t = next;
+            }
+        }
+
+        int idx = (int)(now & (SWTIMER_SLOTS - 1));
+        SwTimer *t = ts->wheel[0][idx];
+        ts->wheel[0][idx] = NULL;
+        while (t) {
+            SwTimer *next = t->next;
+            t->slot = NULL;
+            t->prev = t->next = NULL;
+            if (t->expires > now) wheel_insert(ts, t);
+            else                  fire(ts, t, now);
+            t = next;
+        }
+    }
+}
+
+/* ── Service ──────────────────────────────────────────────────────── */
+
+bool timer_service_enable(Scheduler *sched, uint8_t daemon_priority)
+{
+    if (!sched) return false;
+    if (sched->timers) return true;
+
+    TimerState *ts = calloc(1, sizeof(TimerState));
+    if (!ts) {
+        fprintf(stderr, "timer_service_enable: out of memory\n");
+        return false;
+    }
+    ts->now = sched->system_ticks;
+    ts->daemon = task_create(sched, "TmrSvc", timer_daemon_func, NULL,
+                             daemon_priority, 0, 0, 1);
+    if (!ts->daemon) {
+        free(ts);
+        return false;
+    }
+
+    /* The daemon runs only when callbacks are due */
+    ts->daemon->remaining_work = 0;
+    ts->daemon->invocations    = 0;
+    task_set_state(ts->daemon, TASK_SUSPENDED);
+    sched->timers = ts;
+    return true;
+}
+
+void timer_service_disable(Scheduler *sched)
+{
+    TimerState *ts = sched ? sched->timers : NULL;
+    if (!ts) return;
+
+    for (int l = 0; l < SWTIMER_LEVELS; l++) {
+        for (int s = 0; s < SWTIMER_SLOTS; s++) {
+            while (ts->wheel[l][s]) disarm(ts, ts->wheel[l][s]);
+        }
+    }
+    while (ts->q_head) queue_unlink(ts, ts->q_head);
+    task_terminate(ts->daemon);
+
+    free(ts);
+    sched->timers = NULL;
+}
+
+/* ── Timers ───────────────────────────────────────────────────────── */
+
+SwTimer *swtimer_create(Scheduler *sched, const char *name, uint64_t period,
+                        bool auto_reload, SwTimerCallback callback,
+                        void *ctx)
+{
+    if (!sched || !sched->timers || !callback) return NULL;
+    if (period == 0) {
+        fprintf(stderr, "swtimer_create: %s needs a nonzero period\n",
+                name ? name : "(null)");
+        return NULL;
+    }
+
+    SwTimer *t = calloc(1, sizeof(SwTimer));
+    if (!t) return NULL;
+    snprintf(t->name, SWTIMER_NAME_MAX, "%s", name ? name : "timer");
+    t->sched       = sched;
+    t->period      = period;
+    t->auto_reload = auto_reload;
+    t->callback    = callback;
+    t->ctx         = ctx;
+    return t;
+}
+
+void swtimer_delete(SwTimer *timer)
+{
+    if (!timer) return;
+    swtimer_stop(timer);
+    free(timer);
+}
+
+bool swtimer_start(SwTimer *timer)
+{
+    TimerState *ts = timer ? timer->sched->timers : NULL;
+    if (!ts) return false;
+    if (!timer->active) {
+        arm(ts, timer, timer->sched->system_ticks + timer->period);
+    }
+    return true;
+}
+
+bool swtimer_stop(SwTimer *timer)
+{
+    TimerState *ts = timer ? timer->sched->timers : NULL;
+    if (!ts) return false;
+    disarm(ts, timer);
+    queue_unlink(ts, timer);
+    return true;
+}
+
+bool swtimer_reset(SwTimer *timer)
+{
+    TimerState *ts = timer ? timer->sched->timers : NULL;
+    if (!ts) return false;
+    disarm(ts, timer);
+    arm(ts, timer, timer->sched->system_ticks + timer->period);
+    return true;
+}
+
+bool swtimer_change_period(SwTimer *timer, uint64_t period)
+{
+    if (!timer || period == 0) return false;
+    timer->period = period;
+    return timer->active ? swtimer_reset(timer) : true;
+}
+
+bool swtimer_is_active(const SwTimer *timer)
+{
+    return timer && timer->active;
+}
+
+/* ── Hooks ────────────────────────────────────────────────────────── */
+
+void timer_service_tick(Scheduler *sched, TaskControlBlock *curr, bool ran)
+{
+    TimerState *ts = sched ? sched->timers : NULL;
+    if (!ts) return;
+
+    /* The daemon ran the tick just elapsed: call everything queued
+       before it started (a callback may start, stop or delete timers) */
+    if (ran && curr == ts->daemon) {
+        uint64_t start = sched->system_ticks - 1;
+        while (ts->q_head && ts->q_head->queued_at <= start) {
+            SwTimer *t = ts->q_head;
+            uint64_t lat = start - t->queued_at;
+            queue_unlink(ts, t);
+            t->callbacks++;
+            ts->callbacks++;
+            ts->latency_sum += lat;
+            if (lat > ts->latency_max) ts->latency_max = lat;
+            t->callback(t, t->ctx);
+        }
+    }
+
+    wheel_advance(ts, sched->system_ticks);
+
+    /* Wake the daemon, or give a job finishing this tick one more */
+    TaskControlBlock *d = ts->daemon;
+    if (ts->q_length > 0 && d->remaining_work == 0) {
+        if (d->state == TASK_SUSPENDED) release_job(sched, d);
+        else                            d->remaining_work = 1;
+    }
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+void timer_service_print_report(const Scheduler *sched)
+{
+    const TimerState *ts = sched ? sched->timers : NULL;
+    if (!ts) return;
+
+    printf("\n  Timer wheel at tick %" PRIu64 ": %u active (max %u), "
+           "daemon %s priority %d\n", ts->now, ts->active, ts->active_max,
+           ts->daemon->name, ts->daemon->priority);
+    printf("  Timers per level:");
+    for (int l = 0; l < SWTIMER_LEVELS; l++) {
+        uint32_t n = 0;
+        for (int s = 0; s < SWTIMER_SLOTS; s++) {
+            for (const SwTimer *t = ts->wheel[l][s]; t; t = t->next) n++;
+        }
+        printf(" L%d=%u", l, n);
+    }
+    printf("\n");
+
+    double per = ts->expirations ?
+                 (double)ts->cascaded / ts->expirations : 0.0;
+    double avg = ts->callbacks ?
+                 (double)ts->latency_sum / ts->callbacks : 0.0;
+    printf("  Expirations %" PRIu64 " (late %" PRIu64 "), cascades %"
+           PRIu64 " (%.2f per expiry)\n", ts->expirations,
+           ts->late_expiries, ts->cascaded, per);
+    printf("  Callbacks %" PRIu64 ", queued %u, overruns %u, latency "
+           "avg %.2f max %" PRIu64 " ticks\n", ts->callbacks, ts->q_length,
+           ts->overruns, avg, ts->latency_max);
+}
@@ -0,0 +1,148 @@
+/*
+ * swtimer.h - Software Timers on a Hierarchical Timing Wheel
+ *
+ * One-shot and auto-reload timers call a function at a future tick. They
+ * are kept on a hierarchical timing wheel of SWTIMER_LEVELS levels with
+ * SWTIMER_SLOTS slots each (Varghese & Lauck):
+ *
+ *   level 0 slot  = expiry tick               (due within 64 ticks)
+ *   level L slot  = expiry >> (6 * L)         (due within 64^(L+1) ticks)
+ *
+ * Starting and stopping a timer link or unlink it from one slot list in
+ * O(1). When level L-1 wraps, the next slot of level L is cascaded: its
+ * timers are re-inserted one level lower, each timer moving at most
+ * SWTIMER_LEVELS - 1 times before it expires.
+ *
+ * Expiry only queues the callback. Callbacks run in a timer daemon task
+ * at a configurable priority, so they are dispatched, delayed and
+ * preempted like any other job: each tick the daemon runs, it calls
+ * every callback queued before that tick.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef SWTIMER_H
+#define SWTIMER_H
+
+#include "scheduler.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define SWTIMER_LEVELS      4
+#define SWTIMER_SLOT_BITS   6
+#define SWTIMER_SLOTS       (1 << SWTIMER_SLOT_BITS)
+#define SWTIMER_NAME_MAX    16
+
+typedef struct SwTimer SwTimer;
+
+/** Expiry callback, run by the timer daemon task. */
+typedef void (*SwTimerCallback)(SwTimer *timer, void *ctx);
+
+/* ── Timer ────────────────────────────────────────────────────────── */
+struct SwTimer {
+    char             name[SWTIMER_NAME_MAX];
+    Scheduler       *sched;
+    uint64_t         period;        /* Delay, and reload interval      */
+    bool             auto_reload;
+    SwTimerCallback  callback;
+    void            *ctx;
+
+    /* Wheel membership */
+    bool             active;
+    uint64_t         expires;
+    SwTimer        **slot;          /* Head of the slot list           */
+    SwTimer         *prev;
+    SwTimer         *next;
+
+    /* Callback queue membership */
+    bool             queued;
+    uint64_t         queued_at;     /* Expiry tick of the queued call  */
+    SwTimer         *q_prev;
+    SwTimer         *q_next;
+
+    /* Statistics */
+    uint32_t         expirations;
+    uint32_t         callbacks;
+    uint32_t         overruns;      /* Expired with its call still queued */
+};
+
+/* ── Per-core state ───────────────────────────────────────────────── */
+struct TimerState {
+    SwTimer          *wheel[SWTIMER_LEVELS][SWTIMER_SLOTS];
+    uint64_t          now;          /* Last tick processed by the wheel */
+    TaskControlBlock *daemon;
+
+    /* Callbacks awaiting the daemon, in expiry order */
+    SwTimer          *q_head;
+    SwTimer          *q_tail;
+    uint32_t          q_length;
+
+    /* Statistics */
+    uint32_t          active;
+    uint32_t          active_max;
+    uint64_t          expirations;
+    uint64_t          cascaded;     /* Timers moved down a level       */
+    uint64_t          callbacks;
+    uint32_t          overruns;
+    uint64_t          late_expiries;    /* Wheel fired after `expires` */
+    uint64_t          latency_max;  /* Expiry to callback, ticks       */
+    uint64_t          latency_sum;
+};
+
+/* ── Service ──────────────────────────────────────────────────────── */
+
+/**
+ * Enable software timers on a core and create the daemon task at
+ * `daemon_priority`. The daemon stays suspended until a callback is due.
+ */
+bool timer_service_enable(Scheduler *sched, uint8_t daemon_priority);
+
+/** Detach all timers and terminate the daemon. */
+void timer_service_disable(Scheduler *sched);
+
+/* ── Timers ───────────────────────────────────────────────────────── */
+
+/**
+ * Create a dormant timer that expires `period` ticks after it is
+ * started, and every `period` ticks after that if `auto_reload`.
+ */
+SwTimer *swtimer_create(Scheduler *sched, const char *name, uint64_t period,
+                        bool auto_reload, SwTimerCallback callback,
+                        void *ctx);
+
+/** Stop and free a timer. */
+void swtimer_delete(SwTimer *timer);
+
+/** Arm a dormant timer to expire `period` ticks from now (O(1)). */
+bool swtimer_start(SwTimer *timer);
+
+/** Disarm a timer and drop its queued callback, if any (O(1)). */
+bool swtimer_stop(SwTimer *timer);
+
+/** Re-arm a timer, active or not, to expire `period` ticks from now. */
+bool swtimer_reset(SwTimer *timer);
+
+/** Change the period; an active timer is re-armed from now. */
+bool swtimer_change_period(SwTimer *timer, uint64_t period);
+
+/** Whether the timer is armed. */
+bool swtimer_is_active(const SwTimer *timer);
+
+/* ── Hooks ────────────────────────────────────────────────────────── */
+
+/**
+ * Per-tick processing (called by tick_handler before releases): run the
+ * queued callbacks if the daemon executed the tick just elapsed, then
+ * advance the wheel to the current tick and wake the daemon for any new
+ * expiries.
+ */
+void timer_service_tick(Scheduler *sched, TaskControlBlock *curr, bool ran);
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+/** Print wheel occupancy, expiries, cascades and callback latency. */
+void timer_service_print_report(const Scheduler *sched);
+
+#endif /* SWTIMER_H */
@@ -12,6 +12,8 @@
 #include "scheduler.h"
 #include "timeline.h"
 #include "mutex.h"
+#include "mempool.h"
+#include "waitany.h"
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -78,6 +80,7 @@ TaskControlBlock *task_create(Scheduler *sched,
     task->exec_time         = 0;
     task->wcet_observed     = 0;
     task->total_exec_time   = 0;
+    task->wcet              = wcet;
     task->remaining_work    = wcet;
 
     /* Statistics */
@@ -133,7 +136,18 @@ void task_set_state(TaskControlBlock *task, TaskState new_state)
     Scheduler *sched = task->scheduler;
     task->state = new_state;
 
-    /* Queue bookkeeping */
+    /* Queue bookkeeping (a timeout is the sleep queue waking it) */
+    bool timed_out = new_state == TASK_READY && task->delayed &&
+                     task->wake_tick <= sched->system_ticks;
+    if (task->delayed && new_state != TASK_BLOCKED) {
+        sleep_queue_remove(sched, task);    /* Woken or aborted */
+    }
+    if (task->pool_wait && new_state != TASK_BLOCKED) {
+        mempool_cancel_wait(task, timed_out);   /* Empty-handed */
+    }
+    if (task->wait_set && new_state != TASK_BLOCKED) {
+        wait_any_cancel(task);              /* Leaves all its objects */
+    }
     if (old == TASK_READY && new_state != TASK_READY) {
         ready_queue_remove(sched, task);
     }
@@ -168,6 +182,38 @@ void task_terminate(TaskControlBlock *task)
     task_set_state(task, TASK_TERMINATED);
 }
 
+/* ── Delays ───────────────────────────────────────────────────────── */
+
+static void delay_to(TaskControlBlock *task, uint64_t wake_tick)
+{
+    Scheduler *sched = task->scheduler;
+    task_set_state(task, TASK_BLOCKED);
+    task->wake_tick = wake_tick;
+    sleep_queue_insert(sched, task);
+    scheduler_schedule(sched);
+}
+
+bool task_delay(TaskControlBlock *task, uint64_t ticks)
+{
+    if (!task || ticks == 0 || task->state == TASK_TERMINATED) return false;
+    delay_to(task, task->scheduler->system_ticks + ticks);
+    return true;
+}
+
+bool task_delay_until(TaskControlBlock *task, uint64_t *last_wake,
+                      uint64_t period)
+{
+    if (!task || !last_wake || task->state == TASK_TERMINATED) return false;
+
+    /* Advance the grid even if this wake tick was missed */
+    uint64_t wake = *last_wake + period;
+    *last_wake = wake;
+    if (wake <= task->scheduler->system_ticks) return false;
+
+    delay_to(task, wake);
+    return true;
+}
+
 /* ── Priority ─────────────────────────────────────────────────────── */
 
 void task_set_priority(TaskControlBlock *task, int new_priority)
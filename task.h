@@ -17,6 +17,8 @@
 
 /* ── Forward declarations ─────────────────────────────────────────── */
 typedef struct Mutex    Mutex;
+typedef struct MemPool  MemPool;
+typedef struct WaitObject WaitObject;
 typedef struct Scheduler Scheduler;
 typedef struct Timeline  Timeline;
 
@@ -61,6 +63,7 @@ typedef struct TaskControlBlock {
     uint64_t         relative_deadline;
     uint64_t         next_release;
     uint64_t         absolute_deadline;
+    uint64_t         wcet;               /* Declared work per job      */
     uint64_t         exec_time;          /* Accumulated this period    */
     uint64_t         wcet_observed;      /* Worst-case observed        */
     uint64_t         total_exec_time;    /* Across all invocations     */
@@ -77,9 +80,20 @@ typedef struct TaskControlBlock {
     int              held_mutex_cap;
     Mutex           *blocked_on;         /* Mutex we're waiting for    */
 
-    /* Queue linkage */
+    /* Queue linkage (sleep queue while delayed) */
     struct TaskControlBlock *next;
     struct TaskControlBlock *prev;
+    bool             delayed;            /* On the sleep queue         */
+    uint64_t         wake_tick;          /* Tick the delay ends        */
+
+    /* Memory pool wait (pool_wait == NULL: not waiting) */
+    MemPool         *pool_wait;
+    void            *pool_block;         /* Block handed over          */
+
+    /* Multi-object wait (wait_set == NULL: not waiting) */
+    WaitObject      *wait_set;           /* Caller's array             */
+    int              wait_set_count;
+    int              wait_index;         /* Object that woke the task  */
 
     /* Back-pointer to owning scheduler */
     Scheduler       *scheduler;
@@ -87,6 +101,40 @@ typedef struct TaskControlBlock {
     /* Simulation bookkeeping */
     uint64_t         remaining_work;     /* Ticks of work left         */
     uint64_t         ready_since;        /* Tick when last became READY*/
+
+    /* Memory bandwidth regulation */
+    uint32_t         mem_rate;           /* Accesses per executed tick */
+    uint64_t         throttled_ticks;    /* Stalled by MemGuard        */
+
+    /* Mixed criticality (wcet is the LO-level budget) */
+    int              criticality;        /* CRIT_LO / CRIT_HI          */
+    uint64_t         wcet_hi;            /* HI-level WCET              */
+    uint32_t         jobs_dropped;       /* Abandoned or skipped jobs  */
+
+    /* Operating modes (bit n = member of mode n, 0 = all modes) */
+    uint32_t         mode_mask;
+
+    /* Elastic period range (period_max == 0: not elastic) */
+    uint64_t         period_min;         /* Nominal period             */
+    uint64_t         period_max;
+    double           elastic_coeff;      /* 0 = rigid                  */
+    uint64_t         elastic_wcet;       /* WCET estimate in the sums  */
+
+    /* (m,k)-firm constraint (mk_k == 0: none) */
+    uint8_t          mk_m;
+    uint8_t          mk_k;
+    uint32_t         mk_history;         /* Bit 0 = latest job, 1 = met*/
+    uint32_t         mk_last_job;        /* Job whose outcome is known */
+    uint32_t         mk_met;
+    uint32_t         mk_missed;
+    uint32_t         mk_skipped;
+    uint32_t         mk_violations;
+
+    /* DVFS (work counted in cycles at the maximum frequency) */
+    uint64_t         dvfs_cycles;        /* Cycles retired this job    */
+    uint64_t         dvfs_cycles_total;
+    uint32_t         dvfs_credit;        /* Partial cycle, per mille   */
+    uint32_t         dvfs_jobs_done;
 } TaskControlBlock;
 
 /* ── Public API ───────────────────────────────────────────────────── */
@@ -116,6 +164,21 @@ void task_resume(TaskControlBlock *task);
 /** Terminate a task permanently. */
 void task_terminate(TaskControlBlock *task);
 
+/**
+ * Block `task` for `ticks` (> 0) ticks from now. The tick handler makes
+ * it READY again when the delay ends.
+ */
+bool task_delay(TaskControlBlock *task, uint64_t ticks);
+
+/**
+ * Block `task` until `*last_wake + period` and advance `*last_wake` to
+ * that tick, so a loop of work and task_delay_until() wakes on a fixed
+ * grid regardless of how long the work took. Returns false without
+ * blocking if the wake tick has already passed.
+ */
+bool task_delay_until(TaskControlBlock *task, uint64_t *last_wake,
+                      uint64_t period);
+
 /** Set a task's effective priority and re-sort queues. */
 void task_set_priority(TaskControlBlock *task, int new_priority);
 
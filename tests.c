@@ -1,25 +1,55 @@
 /*
  * tests.c - Comprehensive Test Scenarios
  *
- * Eight self-contained tests that exercise every feature of the RTOS
+ * Self-contained tests that exercise every feature of the RTOS
  * scheduler, from basic priority scheduling to transitive priority
- * inheritance and deadline miss detection.
+ * inheritance, deadline miss detection and multicore simulation.
  *
  * Author: RTOS Project
  * Date:   2026-02-13
  */
 
+#define _POSIX_C_SOURCE 200809L   /* clock_gettime for benchmarks */
+
 #include "task.h"
 #include "scheduler.h"
 #include "mutex.h"
 #include "semaphore.h"
 #include "timeline.h"
 #include "rtos_time.h"
+#include "smp.h"
+#include "pfair.h"
+#include "dag.h"
+#include "memguard.h"
+#include "mixcrit.h"
+#include "modechange.h"
+#include "elastic.h"
+#include "mkfirm.h"
+#include "dvfs.h"
+#include "dpm.h"
+#include "cyclic.h"
+#include "ttsynth.h"
+#include "let.h"
+#include "prec.h"
+#include "isr.h"
+#include "swtimer.h"
+#include "mempool.h"
+#include "topic.h"
+#include "iodev.h"
+#include "waitany.h"
+#include "inject.h"
+#include "evstream.h"
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <inttypes.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <time.h>
+#include <unistd.h>
 
 /* ── Utility ──────────────────────────────────────────────────────── */
 
@@ -654,3 +684,2984 @@ void test_deadline_miss(void)
     print_result(pass, "Deadline Miss Detection");
     scheduler_destroy(&sched);
 }
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 9: Parallel Multicore Simulation
+ *  16 cores with a shared global mutex and cross-core wakeups run
+ *  sequentially and on host threads; results must match exactly.
+ * ══════════════════════════════════════════════════════════════════ */
+
+typedef struct {
+    TaskControlBlock *worker[SMP_MAX_CORES];   /* Uses global mutex    */
+    TaskControlBlock *sink[SMP_MAX_CORES];     /* Woken cross-core     */
+    SmpGlobalMutex   *gm;
+    int               phase[SMP_MAX_CORES];    /* 0 idle 1 req 2 held  */
+    uint32_t          locked_job[SMP_MAX_CORES];
+} SmpScenario;
+
+static void smp_scenario_hook(SmpSystem *sys, int core, void *ctx)
+{
+    SmpScenario      *sc = ctx;
+    Scheduler        *sched = smp_core(sys, core);
+    TaskControlBlock *w = sc->worker[core];
+
+    if (sched->current_task != w || w->state != TASK_RUNNING) return;
+
+    if (sc->phase[core] == 0 && w->exec_time == 1 &&
+        sc->locked_job[core] != w->invocations) {
+        sc->locked_job[core] = w->invocations;
+        if (smp_global_lock(sys, core, sc->gm, w)) sc->phase[core] = 1;
+    } else if (sc->phase[core] == 1) {
+        sc->phase[core] = 2;                   /* Running again: granted */
+    } else if (sc->phase[core] == 2 && w->exec_time >= 3 &&
+               smp_global_unlock(sys, core, sc->gm, w)) {
+        sc->phase[core] = 0;                   /* Else retry next tick   */
+        smp_post_wakeup(sys, core, sc->sink[(core + 1) % sys->core_count]);
+    }
+}
+
+static uint64_t run_smp_scenario(SmpRunMode mode, uint64_t ticks,
+                                 SmpSystem *sys, SmpScenario *sc)
+{
+    char name[TASK_NAME_MAX];
+
+    smp_init(sys, SMP_MAX_CORES, SCHED_PRIORITY, false, 50);
+    smp_set_run_mode(sys, mode);
+    memset(sc, 0, sizeof(*sc));
+    sc->gm = smp_global_mutex_create("GBus");
+
+    for (int c = 0; c < sys->core_count; c++) {
+        Scheduler *core = smp_core(sys, c);
+        snprintf(name, sizeof(name), "Ctl%d", c);
+        task_create(core, name, task_func_noop, NULL, 1, 10, 10, 2);
+        snprintf(name, sizeof(name), "Wrk%d", c);
+        sc->worker[c] = task_create(core, name, task_func_noop, NULL,
+                                    2, 400 + 7 * (uint64_t)c, 0, 4);
+        snprintf(name, sizeof(name), "Sink%d", c);
+        sc->sink[c] = task_create(core, name, task_func_noop, NULL,
+                                  3, 1000000, 0, 0);
+        task_suspend(sc->sink[c]);
+        scheduler_schedule(core);
+    }
+
+    smp_set_tick_hook(sys, smp_scenario_hook, sc);
+    smp_run(sys, ticks);
+    return smp_fingerprint(sys);
+}
+
+void test_smp_parallel(void)
+{
+    print_separator("Parallel Multicore Simulation");
+
+    static SmpSystem seq, par;
+    SmpScenario sc_seq, sc_par;
+
+    uint64_t h_seq = run_smp_scenario(SMP_RUN_SEQUENTIAL, 5000,
+                                      &seq, &sc_seq);
+    uint64_t h_par = run_smp_scenario(SMP_RUN_PARALLEL, 5000,
+                                      &par, &sc_par);
+
+    smp_print_events(&par, 24);
+    printf("\n  Sequential run:");
+    smp_print_report(&seq);
+    printf("\n  Parallel run:");
+    smp_print_report(&par);
+
+    printf("\n  Global mutex %s: %u acquisitions, %u contended\n",
+           sc_par.gm->name, sc_par.gm->acquisitions,
+           sc_par.gm->contentions);
+    printf("  Fingerprint sequential: %016" PRIx64 "\n", h_seq);
+    printf("  Fingerprint parallel:   %016" PRIx64 "\n", h_par);
+
+    bool pass = (h_seq == h_par &&
+                 sc_par.gm->acquisitions == sc_seq.gm->acquisitions &&
+                 sc_par.gm->acquisitions > 0 &&
+                 sc_par.gm->contentions > 0 &&
+                 sc_par.sink[0]->total_exec_time > 0);
+    print_result(pass, "Parallel Multicore Simulation");
+
+    smp_global_mutex_destroy(sc_seq.gm);
+    smp_global_mutex_destroy(sc_par.gm);
+    smp_destroy(&seq);
+    smp_destroy(&par);
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 10: Pfair (PD2) Multiprocessor Scheduling
+ *  A fully utilized 2-core set G-EDF cannot schedule, then a mixed
+ *  4-core set to quantify PD2's preemption/migration overhead.
+ * ══════════════════════════════════════════════════════════════════ */
+
+void test_pfair(void)
+{
+    print_separator("Pfair (PD2) Multiprocessor Scheduling");
+
+    /* Three (C=2, T=3) tasks on 2 cores: U = 2.0 = m */
+    Scheduler full;
+    scheduler_init(&full, SCHED_PRIORITY, false);
+    task_create(&full, "Tau1", task_func_noop, NULL, 1, 3, 0, 2);
+    task_create(&full, "Tau2", task_func_noop, NULL, 2, 3, 0, 2);
+    task_create(&full, "Tau3", task_func_noop, NULL, 3, 3, 0, 2);
+    pfair_print_comparison(&full, 2, 0);
+
+    MpSchedStats *pd2  = malloc(sizeof(MpSchedStats));
+    MpSchedStats *gedf = malloc(sizeof(MpSchedStats));
+    pfair_simulate(&full, 2, 30, MP_SCHED_PFAIR_PD2, pd2);
+    pfair_simulate(&full, 2, 30, MP_SCHED_GEDF, gedf);
+    bool optimal = (pfair_feasible(&full, 2) &&
+                    pd2->deadline_misses == 0 &&
+                    gedf->deadline_misses > 0 &&
+                    pd2->busy_slots == 60);
+
+    /* Mixed light/heavy set on 4 cores, U = 3.2 */
+    Scheduler mixed;
+    scheduler_init(&mixed, SCHED_PRIORITY, false);
+    task_create(&mixed, "Nav",    task_func_noop, NULL, 1,  5, 0, 4);
+    task_create(&mixed, "Fusion", task_func_noop, NULL, 2, 10, 0, 7);
+    task_create(&mixed, "Track",  task_func_noop, NULL, 3,  4, 0, 3);
+    task_create(&mixed, "Plan",   task_func_noop, NULL, 4, 20, 0, 9);
+    task_create(&mixed, "Log",    task_func_noop, NULL, 5, 10, 0, 3);
+    task_create(&mixed, "Diag",   task_func_noop, NULL, 6, 20, 0, 4);
+    pfair_print_comparison(&mixed, 4, 0);
+
+    pfair_simulate(&mixed, 4, 0, MP_SCHED_PFAIR_PD2, pd2);
+    pfair_simulate(&mixed, 4, 0, MP_SCHED_GEDF, gedf);
+    printf("  Cost of optimality: %+" PRId64 " preemptions, "
+           "%+" PRId64 " migrations per hyperperiod\n",
+           (int64_t)pd2->preemptions - (int64_t)gedf->preemptions,
+           (int64_t)pd2->migrations  - (int64_t)gedf->migrations);
+
+    bool pass = (optimal &&
+                 pd2->deadline_misses == 0 &&
+                 pd2->preemptions >= gedf->preemptions);
+    print_result(pass, "Pfair (PD2) Multiprocessor Scheduling");
+
+    free(pd2);
+    free(gedf);
+    scheduler_destroy(&full);
+    scheduler_destroy(&mixed);
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 11: Parallel DAG Tasks with Federated Scheduling
+ *  Two heavy fork/join pipelines get dedicated clusters; three light
+ *  DAGs share the remaining cores under EDF.
+ * ══════════════════════════════════════════════════════════════════ */
+
+void test_dag_federated(void)
+{
+    print_separator("Parallel DAG Tasks with Federated Scheduling");
+
+    DagSystem sys;
+    dag_system_init(&sys, 8);
+
+    /* Perception: Capture -> {Detect, Segment, Depth} -> Fuse -> Publish */
+    DagTask *perc = dag_create(&sys, "Percept", 20, 0);
+    int cap = dag_add_node(perc, "Capture", 2);
+    int det = dag_add_node(perc, "Detect",  8);
+    int seg = dag_add_node(perc, "Segment", 9);
+    int dep = dag_add_node(perc, "Depth",   7);
+    int fus = dag_add_node(perc, "Fuse",    3);
+    int pub = dag_add_node(perc, "Publish", 1);
+    dag_add_edge(perc, cap, det);
+    dag_add_edge(perc, cap, seg);
+    dag_add_edge(perc, cap, dep);
+    dag_add_edge(perc, det, fus);
+    dag_add_edge(perc, seg, fus);
+    dag_add_edge(perc, dep, fus);
+    dag_add_edge(perc, fus, pub);
+
+    /* Lidar: Scan -> {Cluster, Ground, Track} -> Merge */
+    DagTask *lidar = dag_create(&sys, "Lidar", 10, 0);
+    int scan = dag_add_node(lidar, "Scan",    1);
+    int clu  = dag_add_node(lidar, "Cluster", 4);
+    int gnd  = dag_add_node(lidar, "Ground",  4);
+    int trk  = dag_add_node(lidar, "Track",   3);
+    int mrg  = dag_add_node(lidar, "Merge",   1);
+    dag_add_edge(lidar, scan, clu);
+    dag_add_edge(lidar, scan, gnd);
+    dag_add_edge(lidar, scan, trk);
+    dag_add_edge(lidar, clu, mrg);
+    dag_add_edge(lidar, gnd, mrg);
+    dag_add_edge(lidar, trk, mrg);
+
+    /* Light DAGs */
+    DagTask *diag = dag_create(&sys, "Diag", 50, 0);
+    int da = dag_add_node(diag, "Read",  3);
+    int db = dag_add_node(diag, "Check", 4);
+    int dc = dag_add_node(diag, "Store", 2);
+    dag_add_edge(diag, da, db);
+    dag_add_edge(diag, db, dc);
+
+    DagTask *logd = dag_create(&sys, "Logger", 25, 0);
+    int la = dag_add_node(logd, "Pack",  5);
+    int lb = dag_add_node(logd, "Flush", 5);
+    dag_add_edge(logd, la, lb);
+
+    DagTask *hlth = dag_create(&sys, "Health", 40, 0);
+    int ha = dag_add_node(hlth, "Temp",  4);
+    int hb = dag_add_node(hlth, "Volt",  4);
+    int hc = dag_add_node(hlth, "Report", 1);
+    dag_add_edge(hlth, ha, hc);
+    dag_add_edge(hlth, hb, hc);
+
+    /* A back edge must be rejected */
+    bool cycle_rejected = !dag_add_edge(perc, pub, cap);
+
+    bool sched_ok = dag_federated_allocate(&sys);
+    dag_simulate(&sys, 400);
+    dag_print_report(&sys);
+
+    uint64_t perc_bound  = dag_span(perc) +
+        (dag_work(perc) - dag_span(perc) + (uint64_t)perc->core_count - 1) /
+        (uint64_t)perc->core_count;
+
+    printf("  Percept: work=%" PRIu64 " span=%" PRIu64 " -> %d cores\n",
+           dag_work(perc), dag_span(perc), perc->core_count);
+    printf("  Lidar:   work=%" PRIu64 " span=%" PRIu64 " -> %d cores\n",
+           dag_work(lidar), dag_span(lidar), lidar->core_count);
+    printf("  Cycle Publish -> Capture rejected: %s\n",
+           cycle_rejected ? "yes" : "no");
+
+    int misses = 0;
+    for (int d = 0; d < sys.dag_count; d++) {
+        misses += (int)sys.dags[d]->deadline_misses;
+    }
+
+    bool pass = (sched_ok && cycle_rejected &&
+                 perc->heavy && perc->core_count == 3 &&
+                 lidar->heavy && lidar->core_count == 2 &&
+                 !diag->heavy && !logd->heavy && !hlth->heavy &&
+                 perc->resp_max <= perc_bound &&
+                 perc->jobs_completed == 20 && misses == 0);
+    print_result(pass, "Parallel DAG Tasks with Federated Scheduling");
+
+    dag_system_destroy(&sys);
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 12: Memory-Bandwidth Regulation (MemGuard)
+ *  Four cores with very different memory intensity share one DRAM
+ *  budget; even and demand-proportional partitions are compared.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static void build_memguard_system(SmpSystem *sys)
+{
+    /* Per core: (name, period, wcet, accesses per tick) */
+    static const struct {
+        const char *name;
+        uint64_t    period;
+        uint64_t    wcet;
+        uint32_t    rate;
+    } load[4] = {
+        { "Vision",  20,  8, 10 },
+        { "Control", 10,  3,  1 },
+        { "Stream",  20,  6, 20 },
+        { "Planner", 20, 10,  5 },
+    };
+
+    smp_init(sys, 4, SCHED_PRIORITY, false, 1);
+    for (int c = 0; c < 4; c++) {
+        Scheduler *core = smp_core(sys, c);
+        TaskControlBlock *t = task_create(core, load[c].name,
+                                          task_func_noop, NULL, 1,
+                                          load[c].period, 0, load[c].wcet);
+        memguard_set_task_rate(t, load[c].rate);
+        scheduler_schedule(core);
+    }
+}
+
+void test_memguard(void)
+{
+    print_separator("Memory-Bandwidth Regulation (MemGuard)");
+
+    static SmpSystem even, demand;
+    uint64_t throttled_even = 0, throttled_demand = 0;
+    uint32_t misses_even = 0, misses_demand = 0;
+
+    build_memguard_system(&even);
+    memguard_partition(&even, 260, 10, MEMGUARD_PART_EVEN);
+    smp_run(&even, 400);
+
+    build_memguard_system(&demand);
+    memguard_partition(&demand, 260, 10, MEMGUARD_PART_DEMAND);
+    smp_run(&demand, 400);
+
+    for (int c = 0; c < 4; c++) {
+        throttled_even   += even.cores[c].memguard->throttled_ticks;
+        throttled_demand += demand.cores[c].memguard->throttled_ticks;
+        misses_even      += even.cores[c].all_tasks[1]->deadline_misses;
+        misses_demand    += demand.cores[c].all_tasks[1]->deadline_misses;
+    }
+
+    printf("\n  Even partition (260 accesses / 10 ticks):");
+    memguard_print_report(&even);
+    printf("\n  Demand-proportional partition:");
+    memguard_print_report(&demand);
+
+    Scheduler *stream = smp_core(&even, 2);
+    printf("\n  Stream task stalled %" PRIu64 " ticks under even split\n",
+           stream->all_tasks[1]->throttled_ticks);
+
+    bool pass = (even.cores[2].memguard->throttle_events > 0 &&
+                 stream->all_tasks[1]->throttled_ticks > 0 &&
+                 throttled_demand < throttled_even &&
+                 misses_demand <= misses_even);
+    print_result(pass, "Memory-Bandwidth Regulation (MemGuard)");
+
+    smp_destroy(&even);
+    smp_destroy(&demand);
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 13: Host-Thread Execution of Task Bodies
+ *  Compute-heavy task bodies on 8 cores run inline and on a
+ *  work-stealing worker pool joined at every tick boundary; both the
+ *  body results and the schedule must be identical.
+ * ══════════════════════════════════════════════════════════════════ */
+
+#define BODY_CORES  8
+
+typedef struct {
+    uint32_t iters;        /* Host work per simulated tick */
+    uint64_t acc;
+    uint64_t calls;
+} BodyLoad;
+
+static void task_func_compute(void *arg)
+{
+    BodyLoad *load = arg;
+    uint64_t x = load->acc + load->calls + 0x9E3779B97F4A7C15ull;
+    for (uint32_t i = 0; i < load->iters; i++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+    }
+    load->acc ^= x;
+    load->calls++;
+}
+
+static uint64_t run_body_scenario(SmpSystem *sys, SmpRunMode run,
+                                  SmpBodyMode bodies,
+                                  BodyLoad load[BODY_CORES][2])
+{
+    char name[TASK_NAME_MAX];
+
+    smp_init(sys, BODY_CORES, SCHED_PRIORITY, false, 10);
+    smp_set_run_mode(sys, run);
+    smp_set_body_exec(sys, bodies, 4);
+
+    for (int c = 0; c < BODY_CORES; c++) {
+        Scheduler *core = smp_core(sys, c);
+        /* Uneven host cost across cores gives idle workers work to steal */
+        load[c][0] = (BodyLoad){ .iters = 1000u * (uint32_t)(c + 1) };
+        load[c][1] = (BodyLoad){ .iters = 500u * (uint32_t)(c + 1) };
+        snprintf(name, sizeof(name), "Fast%d", c);
+        task_create(core, name, task_func_compute, &load[c][0], 1, 10, 0, 3);
+        snprintf(name, sizeof(name), "Slow%d", c);
+        task_create(core, name, task_func_compute, &load[c][1], 2, 25, 0, 8);
+        scheduler_schedule(core);
+    }
+
+    smp_run(sys, 1000);
+    return smp_fingerprint(sys);
+}
+
+void test_task_bodies(void)
+{
+    print_separator("Host-Thread Execution of Task Bodies");
+
+    static SmpSystem inl, pool, par;
+    static BodyLoad  load_inl[BODY_CORES][2], load_pool[BODY_CORES][2],
+                     load_par[BODY_CORES][2];
+
+    uint64_t h_inl  = run_body_scenario(&inl, SMP_RUN_SEQUENTIAL,
+                                        SMP_BODIES_INLINE, load_inl);
+    uint64_t h_pool = run_body_scenario(&pool, SMP_RUN_SEQUENTIAL,
+                                        SMP_BODIES_POOL, load_pool);
+    uint64_t h_par  = run_body_scenario(&par, SMP_RUN_PARALLEL,
+                                        SMP_BODIES_INLINE, load_par);
+
+    printf("\n  Inline (sequential stepping):");
+    smp_print_report(&inl);
+    printf("\n  Worker pool (tick-boundary join):");
+    smp_print_report(&pool);
+
+    bool bodies_match = true;
+    bool calls_match  = true;
+    for (int c = 0; c < BODY_CORES; c++) {
+        for (int k = 0; k < 2; k++) {
+            const TaskControlBlock *t = inl.cores[c].all_tasks[k + 1];
+            if (load_pool[c][k].acc != load_inl[c][k].acc ||
+                load_par[c][k].acc  != load_inl[c][k].acc) {
+                bodies_match = false;
+            }
+            if (load_inl[c][k].calls  != t->total_exec_time ||
+                load_pool[c][k].calls != t->total_exec_time) {
+                calls_match = false;
+            }
+        }
+    }
+
+    printf("\n  Body results identical  : %s\n", bodies_match ? "yes" : "NO");
+    printf("  Body calls == exec ticks: %s\n", calls_match ? "yes" : "NO");
+    printf("  Fingerprint inline:   %016" PRIx64 "\n", h_inl);
+    printf("  Fingerprint pool:     %016" PRIx64 "\n", h_pool);
+    printf("  Fingerprint parallel: %016" PRIx64 "\n", h_par);
+
+    bool pass = (bodies_match && calls_match &&
+                 h_inl == h_pool && h_inl == h_par &&
+                 load_inl[0][0].calls > 0);
+    print_result(pass, "Host-Thread Execution of Task Bodies");
+
+    smp_destroy(&inl);
+    smp_destroy(&pool);
+    smp_destroy(&par);
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 14: Mixed-Criticality Scheduling (AMC)
+ *  Two HI control loops share a core with two LO tasks. The set only
+ *  fits under AMC-max. HI overruns are injected at runtime: without
+ *  AMC a HI task misses, with AMC the LO tasks are shed instead.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static void build_mc_set(Scheduler *sched, TaskControlBlock **brake,
+                         TaskControlBlock **steer)
+{
+    scheduler_init(sched, SCHED_PRIORITY, false);
+
+    /* Deadline-monotonic priorities; LO work interleaved with HI */
+    *brake = task_create(sched, "Brake", task_func_noop, NULL,
+                         1, 10, 0, 2);
+    TaskControlBlock *diag = task_create(sched, "Diag", task_func_noop,
+                                         NULL, 2, 25, 0, 1);
+    TaskControlBlock *tele = task_create(sched, "Telemetry",
+                                         task_func_noop, NULL,
+                                         3, 40, 0, 10);
+    *steer = task_create(sched, "Steering", task_func_noop, NULL,
+                         4, 50, 0, 10);
+
+    mixcrit_set_task(*brake, CRIT_HI, 2, 4);
+    mixcrit_set_task(diag,   CRIT_LO, 1, 0);
+    mixcrit_set_task(tele,   CRIT_LO, 10, 0);
+    mixcrit_set_task(*steer, CRIT_HI, 10, 19);
+}
+
+/* At the synchronous release t=200 Steering and every overlapping
+   Brake job run to C(HI) (task index, job number, demand) */
+#define MC_OVERRUNS 6
+static const struct { int task; uint32_t job; uint64_t demand; }
+mc_overruns[MC_OVERRUNS] = {
+    { 3, 5, 19 },
+    { 0, 21, 4 }, { 0, 22, 4 }, { 0, 23, 4 }, { 0, 24, 4 }, { 0, 25, 4 },
+};
+
+static void run_mc_set(Scheduler *sched, uint64_t ticks)
+{
+    /* Without AMC the same demands are applied by hand at release */
+    if (sched->mixcrit) {
+        for (int k = 0; k < MC_OVERRUNS; k++) {
+            mixcrit_inject_overrun(sched,
+                                   sched->all_tasks[mc_overruns[k].task + 1],
+                                   mc_overruns[k].job, mc_overruns[k].demand);
+        }
+    }
+
+    scheduler_schedule(sched);
+    for (uint64_t t = 0; t < ticks; t++) {
+        tick_handler(sched);
+
+        for (int k = 0; !sched->mixcrit && k < MC_OVERRUNS; k++) {
+            TaskControlBlock *o = sched->all_tasks[mc_overruns[k].task + 1];
+            if (o->invocations == mc_overruns[k].job &&
+                o->exec_time == 0 && o->state == TASK_READY) {
+                o->remaining_work = mc_overruns[k].demand;
+            }
+        }
+
+        TaskControlBlock *curr = sched->current_task;
+        if (curr && curr != sched->idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+        {
+            task_set_state(curr, TASK_SUSPENDED);
+        }
+        scheduler_schedule(sched);
+    }
+}
+
+void test_mixed_criticality(void)
+{
+    print_separator("Mixed-Criticality Scheduling (AMC)");
+
+    Scheduler plain, amc, degrade;
+    TaskControlBlock *brake, *steer, *p_brake, *p_steer, *d_brake, *d_steer;
+
+    /* Without AMC: overruns execute to completion, nothing is shed */
+    build_mc_set(&plain, &p_brake, &p_steer);
+    run_mc_set(&plain, 400);
+
+    build_mc_set(&amc, &brake, &steer);
+    mixcrit_enable(&amc, MC_LO_DROP, 2);
+    run_mc_set(&amc, 400);
+
+    printf("\n  Criticality mode switches:\n");
+    for (int e = 0; e < amc.timeline->count; e++) {
+        const TimelineEntry *ent = &amc.timeline->entries[e];
+        if (strncmp(ent->annotation, "MODE", 4) == 0) {
+            printf("    [t=%-4" PRIu64 "] %s\n", ent->tick, ent->annotation);
+        }
+    }
+
+    build_mc_set(&degrade, &d_brake, &d_steer);
+    mixcrit_enable(&degrade, MC_LO_DEGRADE, 2);
+    run_mc_set(&degrade, 400);
+
+    printf("\n  AMC with LO tasks dropped:");
+    mixcrit_print_report(&amc);
+    printf("\n  AMC with LO tasks degraded (every 2nd period):");
+    mixcrit_print_report(&degrade);
+
+    uint64_t r_lo[MAX_ALL_TASKS], r_rtb[MAX_ALL_TASKS], r_max[MAX_ALL_TASKS];
+    bool rtb_ok = mixcrit_response_times(&amc, MC_TEST_AMC_RTB,
+                                         r_lo, r_rtb);
+    bool max_ok = mixcrit_response_times(&amc, MC_TEST_AMC_MAX,
+                                         NULL, r_max);
+    bool max_tighter = true;
+    for (int i = 0; i < amc.task_count; i++) {
+        if (r_max[i] > r_rtb[i]) max_tighter = false;
+    }
+
+    printf("\n  (Degraded LO releases are not covered by the AMC bounds)\n");
+    printf("\n  Without AMC: Steering misses %u, Brake misses %u\n",
+           p_steer->deadline_misses, p_brake->deadline_misses);
+    printf("  With AMC:    Steering misses %u, Brake misses %u\n",
+           steer->deadline_misses, brake->deadline_misses);
+
+    bool pass = (!rtb_ok && max_ok && max_tighter &&
+                 p_steer->deadline_misses > 0 &&
+                 steer->deadline_misses == 0 &&
+                 brake->deadline_misses == 0 &&
+                 amc.mixcrit->switches_to_hi > 0 &&
+                 amc.mixcrit->switches_to_lo > 0 &&
+                 amc.mixcrit->lo_jobs_dropped > 0 &&
+                 amc.mixcrit->hi_overruns == 0);
+    print_result(pass, "Mixed-Criticality Scheduling (AMC)");
+
+    scheduler_destroy(&plain);
+    scheduler_destroy(&amc);
+    scheduler_destroy(&degrade);
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 15: Runtime Mode Changes
+ *  CRUISE and PARKING task sets share a Brake task. The core switches
+ *  modes three times on the fly: at an idle instant, after the safe
+ *  offset, and with a zero offset that overlaps both task sets.
+ * ══════════════════════════════════════════════════════════════════ */
+
+enum { MODE_CRUISE = 0, MODE_PARKING = 1 };
+
+void test_mode_change(void)
+{
+    print_separator("Runtime Mode Changes");
+
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_PRIORITY, false);
+
+    TaskControlBlock *brake  = task_create(&sched, "Brake", task_func_noop,
+                                           NULL, 1, 10, 0, 2);
+    TaskControlBlock *cruise = task_create(&sched, "Cruise", task_func_noop,
+                                           NULL, 2, 20, 0, 5);
+    TaskControlBlock *radar  = task_create(&sched, "Radar", task_func_noop,
+                                           NULL, 3, 25, 0, 6);
+    TaskControlBlock *sonar  = task_create(&sched, "Sonar", task_func_noop,
+                                           NULL, 2, 15, 0, 3);
+    TaskControlBlock *camera = task_create(&sched, "Camera", task_func_noop,
+                                           NULL, 4, 30, 0, 9);
+
+    modechange_enable(&sched, MODE_CRUISE);
+    modechange_define_mode(&sched, MODE_CRUISE, "CRUISE");
+    modechange_define_mode(&sched, MODE_PARKING, "PARKING");
+    modechange_set_task_modes(brake,  MODE_ALL);
+    modechange_set_task_modes(cruise, 1u << MODE_CRUISE);
+    modechange_set_task_modes(radar,  1u << MODE_CRUISE);
+    modechange_set_task_modes(sonar,  1u << MODE_PARKING);
+    modechange_set_task_modes(camera, 1u << MODE_PARKING);
+    scheduler_schedule(&sched);
+
+    uint64_t safe_offset = 0;
+    for (uint64_t t = 0; t < 400; t++) {
+        if (t == 103) {
+            modechange_request(&sched, MODE_PARKING, MODE_PROTO_IDLE, 0);
+        } else if (t == 200) {
+            safe_offset = modechange_safe_offset(&sched, MODE_CRUISE);
+            modechange_request(&sched, MODE_CRUISE, MODE_PROTO_OFFSET,
+                               safe_offset);
+        } else if (t == 302) {
+            modechange_request(&sched, MODE_PARKING, MODE_PROTO_OFFSET, 0);
+        }
+
+        tick_handler(&sched);
+
+        TaskControlBlock *curr = sched.current_task;
+        if (curr && curr != sched.idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+        {
+            task_set_state(curr, TASK_SUSPENDED);
+        }
+        scheduler_schedule(&sched);
+    }
+
+    printf("\n  Mode-change events:\n");
+    for (int e = 0; e < sched.timeline->count; e++) {
+        const TimelineEntry *ent = &sched.timeline->entries[e];
+        if (strncmp(ent->annotation, "MODE", 4) == 0) {
+            printf("    [t=%-4" PRIu64 "] %s\n", ent->tick, ent->annotation);
+        }
+    }
+
+    modechange_print_report(&sched);
+
+    printf("\n  %-8s %6s %8s %7s\n", "Task", "Jobs", "Exec", "Misses");
+    for (int i = 1; i < sched.task_count; i++) {
+        const TaskControlBlock *t = sched.all_tasks[i];
+        printf("  %-8s %6u %8" PRIu64 " %7u\n", t->name, t->invocations,
+               t->total_exec_time, t->deadline_misses);
+    }
+
+    const ModeTransition *h = sched.modes->history;
+    printf("\n  Safe offset PARKING -> CRUISE: %" PRIu64 " ticks\n",
+           safe_offset);
+
+    bool pass = (sched.modes->history_count == 3 &&
+                 h[0].switched && h[1].switched && h[2].switched &&
+                 h[0].switch_tick > h[0].request_tick &&
+                 h[0].misses_during + h[0].misses_settle == 0 &&
+                 h[1].switch_tick - h[1].request_tick == safe_offset &&
+                 h[1].misses_during + h[1].misses_settle == 0 &&
+                 sched.modes->current == MODE_PARKING &&
+                 brake->invocations == 41 && brake->deadline_misses == 0);
+    print_result(pass, "Runtime Mode Changes");
+
+    scheduler_destroy(&sched);
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 16: Elastic Task Model
+ *  An RM task set is held at U <= 0.75 by stretching periods: on
+ *  start-up, when a Lidar task is admitted, when Video overruns its
+ *  WCET estimate at runtime, and back again when Lidar leaves.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static void print_elastic_periods(const char *when, const Scheduler *s)
+{
+    printf("  %-22s", when);
+    for (int i = 1; i < s->task_count; i++) {
+        const TaskControlBlock *t = s->all_tasks[i];
+        if (t->period_max > 0) printf(" %s=%-4" PRIu64, t->name, t->period);
+    }
+    printf(" U=%.3f\n", s->elastic->utilization);
+}
+
+void test_elastic(void)
+{
+    print_separator("Elastic Task Model");
+
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_RATE_MONOTONIC, false);
+    elastic_enable(&sched, 0.75);
+
+    /* Each task is registered as it is created: until then it would
+       count as rigid load against the target */
+    TaskControlBlock *ctrl  = task_create(&sched, "Control", task_func_noop,
+                                          NULL, 0, 10, 0, 3);
+    bool admitted = elastic_add_task(ctrl,  10,  10, 0.0);
+    TaskControlBlock *video = task_create(&sched, "Video", task_func_noop,
+                                          NULL, 0, 20, 0, 5);
+    admitted &= elastic_add_task(video, 20,  60, 1.0);
+    TaskControlBlock *audio = task_create(&sched, "Audio", task_func_noop,
+                                          NULL, 0, 25, 0, 3);
+    admitted &= elastic_add_task(audio, 25,  50, 0.5);
+    TaskControlBlock *log   = task_create(&sched, "Logger", task_func_noop,
+                                          NULL, 0, 40, 0, 4);
+    admitted &= elastic_add_task(log,   40, 160, 2.0);
+
+    printf("\n  Periods after each adaptation:\n");
+    print_elastic_periods("start (U0 = 0.770)", &sched);
+    scheduler_schedule(&sched);
+
+    TaskControlBlock *lidar = NULL;
+    uint64_t video_nominal = 0, video_overload = 0, audio_overload = 0;
+    bool overrun_done = false, always_fits = admitted;
+
+    for (uint64_t t = 0; t < 400; t++) {
+        if (t == 100) {
+            lidar = task_create(&sched, "Lidar", task_func_noop, NULL,
+                                0, 20, 0, 4);
+            video_nominal = video->period;
+            always_fits &= elastic_add_task(lidar, 20, 80, 1.0);
+            print_elastic_periods("t=100 Lidar admitted", &sched);
+        } else if (t == 300) {
+            video_overload = video->period;
+            audio_overload = audio->period;
+            task_terminate(lidar);
+            elastic_remove_task(lidar);
+            print_elastic_periods("t=300 Lidar removed", &sched);
+        }
+
+        tick_handler(&sched);
+        always_fits &= sched.elastic->feasible;
+
+        /* First Video job after t=200 needs 8 ticks instead of 5 */
+        if (t >= 200 && !overrun_done && video->state == TASK_READY &&
+            video->exec_time == 0) {
+            video->remaining_work = 8;
+            overrun_done = true;
+        }
+
+        TaskControlBlock *curr = sched.current_task;
+        if (curr && curr != sched.idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+        {
+            task_set_state(curr, TASK_SUSPENDED);
+        }
+        scheduler_schedule(&sched);
+
+        if (overrun_done && video->elastic_wcet == 8 &&
+            sched.elastic->last_rescale_tick == sched.system_ticks) {
+            print_elastic_periods("Video overrun (C=8)", &sched);
+        }
+    }
+
+    elastic_print_report(&sched);
+
+    uint32_t misses = 0;
+    for (int i = 1; i < sched.task_count; i++) {
+        misses += sched.all_tasks[i]->deadline_misses;
+    }
+    printf("\n  Video period: %" PRIu64 " before Lidar, %" PRIu64
+           " under overload, %" PRIu64 " after Lidar left\n",
+           video_nominal, video_overload, video->period);
+    printf("  Total deadline misses: %u\n", misses);
+
+    bool pass = (always_fits && misses == 0 &&
+                 video_overload > video_nominal &&
+                 video->period < video_overload &&
+                 audio->period < audio_overload &&
+                 sched.elastic->wcet_updates == 3 &&
+                 ctrl->period == 10);
+    print_result(pass, "Elastic Task Model");
+
+    scheduler_destroy(&sched);
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 17: (m,k)-Firm Deadline Scheduling
+ *  An overloaded set (U = 1.37) whose streams tolerate some misses runs
+ *  under fixed priorities, distance-based priorities, and DBP with job
+ *  skipping; (m,k) violations and aborted (wasted) jobs are compared.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static void run_mk_set(Scheduler *sched, MkPolicy policy, bool skip)
+{
+    scheduler_init(sched, SCHED_PRIORITY, false);
+    mkfirm_enable(sched, policy, skip);
+
+    TaskControlBlock *audio = task_create(sched, "Audio", task_func_noop,
+                                          NULL, 1, 10, 0, 4);
+    TaskControlBlock *video = task_create(sched, "Video", task_func_noop,
+                                          NULL, 2, 15, 0, 7);
+    TaskControlBlock *telem = task_create(sched, "Telem", task_func_noop,
+                                          NULL, 3, 20, 0, 10);
+    mkfirm_set_constraint(audio, 3, 5);
+    mkfirm_set_constraint(video, 2, 4);
+    mkfirm_set_constraint(telem, 1, 3);
+    scheduler_schedule(sched);
+
+    for (uint64_t t = 0; t < 600; t++) {
+        tick_handler(sched);
+
+        TaskControlBlock *curr = sched->current_task;
+        if (curr && curr != sched->idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+        {
+            task_set_state(curr, TASK_SUSPENDED);
+        }
+        scheduler_schedule(sched);
+    }
+}
+
+void test_mk_firm(void)
+{
+    print_separator("(m,k)-Firm Deadline Scheduling");
+
+    Scheduler fixed, dbp, skip;
+    run_mk_set(&fixed, MK_PRIO_FIXED, false);
+    run_mk_set(&dbp,   MK_PRIO_DBP,   false);
+    run_mk_set(&skip,  MK_PRIO_DBP,   true);
+
+    printf("\n  Utilization U = %.2f (hard-deadline analysis fails)\n",
+           rms_utilization(&fixed));
+    printf("\n  Fixed priorities:");
+    mkfirm_print_report(&fixed);
+    printf("\n  Distance-based priority:");
+    mkfirm_print_report(&dbp);
+    printf("\n  DBP with job skipping:");
+    mkfirm_print_report(&skip);
+
+    bool pass = (rms_utilization(&fixed) > 1.0 &&
+                 fixed.mkfirm->violations > 0 &&
+                 dbp.mkfirm->violations < fixed.mkfirm->violations &&
+                 skip.mkfirm->violations <= dbp.mkfirm->violations &&
+                 skip.mkfirm->jobs_skipped > 0 &&
+                 skip.mkfirm->jobs_missed < dbp.mkfirm->jobs_missed);
+    print_result(pass, "(m,k)-Firm Deadline Scheduling");
+
+    scheduler_destroy(&fixed);
+    scheduler_destroy(&dbp);
+    scheduler_destroy(&skip);
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 18: Energy-Aware DVFS
+ *  One task set whose jobs usually finish well under their WCET runs
+ *  at full speed, at the static slowdown point and under the
+ *  cycle-conserving governors, for RM and EDF dispatch. Energy drops
+ *  step by step while every deadline is still met.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static double run_dvfs_set(DvfsDispatch dispatch, DvfsGovernor governor,
+                           uint32_t *misses, bool report)
+{
+    static const uint64_t ctrl_jobs[]  = {  3,  1,  2,  2 };
+    static const uint64_t video_jobs[] = {  8,  3,  5,  4 };
+    static const uint64_t log_jobs[]   = { 16,  6,  9, 12 };
+
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_RATE_MONOTONIC, false);
+
+    TaskControlBlock *ctrl  = task_create(&sched, "Control", task_func_noop,
+                                          NULL, 1, 20, 0, 3);
+    TaskControlBlock *video = task_create(&sched, "Video", task_func_noop,
+                                          NULL, 2, 40, 0, 8);
+    TaskControlBlock *log   = task_create(&sched, "Logger", task_func_noop,
+                                          NULL, 3, 80, 0, 16);
+
+    dvfs_enable(&sched, dispatch, governor);
+    dvfs_set_demand(&sched, ctrl,  ctrl_jobs,  4);
+    dvfs_set_demand(&sched, video, video_jobs, 4);
+    dvfs_set_demand(&sched, log,   log_jobs,   4);
+    scheduler_schedule(&sched);
+
+    for (uint64_t t = 0; t < 800; t++) {
+        tick_handler(&sched);
+
+        TaskControlBlock *curr = sched.current_task;
+        if (curr && curr != sched.idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+        {
+            task_set_state(curr, TASK_SUSPENDED);
+        }
+        scheduler_schedule(&sched);
+    }
+
+    if (report) dvfs_print_report(&sched);
+
+    *misses = 0;
+    for (int i = 0; i < sched.task_count; i++) {
+        *misses += sched.all_tasks[i]->deadline_misses;
+    }
+    double energy = sched.dvfs->energy_uj / 1000.0;
+    scheduler_destroy(&sched);
+    return energy;
+}
+
+void test_dvfs(void)
+{
+    print_separator("Energy-Aware DVFS");
+
+    printf("\n  Task set: Control C=3/T=20, Video C=8/T=40, "
+           "Logger C=16/T=80 (U = 0.55)\n");
+    printf("  Jobs use about two thirds of their WCET on average\n");
+
+    uint32_t m_max, m_rm_st, m_rm_cc, m_edf_st, m_edf_cc;
+    double e_max    = run_dvfs_set(DVFS_DISPATCH_RM,  DVFS_GOV_MAX,
+                                   &m_max, false);
+    double e_rm_st  = run_dvfs_set(DVFS_DISPATCH_RM,  DVFS_GOV_STATIC,
+                                   &m_rm_st, false);
+    printf("\n  Cycle-conserving RM:");
+    double e_rm_cc  = run_dvfs_set(DVFS_DISPATCH_RM,  DVFS_GOV_CC,
+                                   &m_rm_cc, true);
+    double e_edf_st = run_dvfs_set(DVFS_DISPATCH_EDF, DVFS_GOV_STATIC,
+                                   &m_edf_st, false);
+    printf("\n  Cycle-conserving EDF:");
+    double e_edf_cc = run_dvfs_set(DVFS_DISPATCH_EDF, DVFS_GOV_CC,
+                                   &m_edf_cc, true);
+
+    printf("\n  %-26s %10s %8s %7s\n", "Configuration", "Energy",
+           "vs. max", "Misses");
+    printf("  %-26s %10s %8s %7s\n", "-------------", "------",
+           "-------", "------");
+    printf("  %-26s %7.1f mJ %7.1f%% %7u\n", "Max frequency", e_max,
+           100.0, m_max);
+    printf("  %-26s %7.1f mJ %7.1f%% %7u\n", "RM static slowdown",
+           e_rm_st, 100.0 * e_rm_st / e_max, m_rm_st);
+    printf("  %-26s %7.1f mJ %7.1f%% %7u\n", "RM cycle-conserving",
+           e_rm_cc, 100.0 * e_rm_cc / e_max, m_rm_cc);
+    printf("  %-26s %7.1f mJ %7.1f%% %7u\n", "EDF static slowdown",
+           e_edf_st, 100.0 * e_edf_st / e_max, m_edf_st);
+    printf("  %-26s %7.1f mJ %7.1f%% %7u\n", "EDF cycle-conserving",
+           e_edf_cc, 100.0 * e_edf_cc / e_max, m_edf_cc);
+
+    bool pass = (m_max + m_rm_st + m_rm_cc + m_edf_st + m_edf_cc == 0 &&
+                 e_rm_st < e_max && e_rm_cc < e_rm_st &&
+                 e_edf_st < e_max && e_edf_cc < e_edf_st);
+    print_result(pass, "Energy-Aware DVFS");
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 19: Idle-Time Power Management
+ *  A lightly loaded RM set runs awake, with break-even sleep decisions
+ *  and with procrastination. Sleeping must save energy and
+ *  procrastination must merge idle gaps into fewer, longer intervals,
+ *  with no deadline misses in any run.
+ * ══════════════════════════════════════════════════════════════════ */
+
+static void run_dpm_set(Scheduler *sched, DpmPolicy policy)
+{
+    scheduler_init(sched, SCHED_RATE_MONOTONIC, false);
+
+    task_create(sched, "Sensor",  task_func_noop, NULL, 1,  20, 0,  3);
+    task_create(sched, "Control", task_func_noop, NULL, 2,  50, 0,  8);
+    task_create(sched, "Logger",  task_func_noop, NULL, 3, 100, 0, 10);
+
+    dpm_enable(sched, policy, 50);
+    dpm_add_state(sched, "Standby", 100.0, 1,  1,  600.0);
+    dpm_add_state(sched, "Sleep",    20.0, 2,  3, 2500.0);
+    dpm_add_state(sched, "Deep",      2.0, 5, 10, 9000.0);
+    scheduler_schedule(sched);
+
+    for (uint64_t t = 0; t < 1000; t++) {
+        tick_handler(sched);
+
+        TaskControlBlock *curr = sched->current_task;
+        if (curr && curr != sched->idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+        {
+            task_set_state(curr, TASK_SUSPENDED);
+        }
+        scheduler_schedule(sched);
+    }
+}
+
+static uint32_t dpm_misses(const Scheduler *sched)
+{
+    uint32_t misses = 0;
+    for (int i = 0; i < sched->task_count; i++) {
+        misses += sched->all_tasks[i]->deadline_misses;
+    }
+    return misses;
+}
+
+void test_dpm(void)
+{
+    print_separator("Idle-Time Power Management");
+
+    printf("\n  Sensor C=3/T=20, Control C=8/T=50, Logger C=10/T=100 "
+           "(U = 0.41)\n");
+    printf("  Active 1000 mW, awake idle 300 mW\n");
+
+    Scheduler awake, sleep, procr;
+    run_dpm_set(&awake, DPM_ACCOUNT_ONLY);
+    run_dpm_set(&sleep, DPM_SLEEP);
+    run_dpm_set(&procr, DPM_PROCRASTINATE);
+
+    printf("\n  Always awake:");
+    dpm_print_report(&awake);
+    printf("\n  Break-even sleep:");
+    dpm_print_report(&sleep);
+    printf("\n  Procrastination:");
+    dpm_print_report(&procr);
+
+    printf("\n  Deadline misses: awake %u, sleep %u, procrastination %u\n",
+           dpm_misses(&awake), dpm_misses(&sleep), dpm_misses(&procr));
+
+    bool pass = (dpm_misses(&awake) + dpm_misses(&sleep) +
+                 dpm_misses(&procr) == 0 &&
+                 sleep.dpm->energy_uj < awake.dpm->energy_uj &&
+                 procr.dpm->energy_uj < sleep.dpm->energy_uj &&
+                 procr.dpm->idle_intervals < sleep.dpm->idle_intervals &&
+                 sleep.dpm->late_wakeups == 0);
+    print_result(pass, "Idle-Time Power Management");
+
+    scheduler_destroy(&awake);
+    scheduler_destroy(&sleep);
+    scheduler_destroy(&procr);
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 20: Static Cyclic Executive
+ *  A set whose longest job exceeds every admissible frame size gets a
+ *  table with split jobs. The core then runs three hyperperiods purely
+ *  from the table and must meet every deadline; the table is also
+ *  emitted as C arrays.
+ * ══════════════════════════════════════════════════════════════════ */
+
+void test_cyclic_executive(void)
+{
+    print_separator("Static Cyclic Executive");
+
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_PRIORITY, false);
+
+    TaskControlBlock *a = task_create(&sched, "A", task_func_noop, NULL,
+                                      1,  4, 0, 1);
+    TaskControlBlock *b = task_create(&sched, "B", task_func_noop, NULL,
+                                      2,  5, 0, 2);
+    TaskControlBlock *c = task_create(&sched, "C", task_func_noop, NULL,
+                                      3, 20, 0, 5);
+
+    printf("\n  A C=1/T=4, B C=2/T=5, C C=5/T=20 (U = 0.90)\n");
+
+    bool built = cyclic_build(&sched) && cyclic_start(&sched);
+    cyclic_print_table(&sched, 10);
+
+    printf("\n  Emitted table:\n\n");
+    cyclic_emit_c(&sched, stdout, "cyclic_table");
+
+    scheduler_schedule(&sched);
+    uint32_t done[3] = { 0, 0, 0 };
+    TaskControlBlock *tasks[3] = { a, b, c };
+
+    uint64_t h = built ? sched.cyclic->hyperperiod : 0;
+    for (uint64_t t = 0; t < 3 * h; t++) {
+        tick_handler(&sched);
+
+        TaskControlBlock *curr = sched.current_task;
+        if (curr && curr != sched.idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+        {
+            for (int i = 0; i < 3; i++) if (curr == tasks[i]) done[i]++;
+            task_set_state(curr, TASK_SUSPENDED);
+        }
+        scheduler_schedule(&sched);
+    }
+
+    uint32_t misses = a->deadline_misses + b->deadline_misses +
+                      c->deadline_misses;
+    printf("\n  Three hyperperiods from the table: A %u/15, B %u/12, "
+           "C %u/3 jobs done, %u misses\n", done[0], done[1], done[2],
+           misses);
+    if (built) {
+        printf("  Table dispatches %" PRIu64 ", assigned slot ticks %"
+               PRIu64 ", unused %" PRIu64 "\n", sched.cyclic->dispatches,
+               sched.cyclic->slot_ticks, sched.cyclic->unused_slots);
+    }
+
+    bool pass = (built && sched.cyclic->frame == 2 && sched.cyclic->split &&
+                 done[0] == 15 && done[1] == 12 && done[2] == 3 &&
+                 misses == 0 && sched.cyclic->unused_slots == 0);
+    print_result(pass, "Static Cyclic Executive");
+
+    scheduler_destroy(&sched);
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 21: Time-Triggered Schedule Synthesis
+ *  A two-core control loop shares a BUS and a FLASH device across
+ *  cores. Plain priority dispatch lets jobs overlap on the devices
+ *  and run out of precedence order. The synthesized time-triggered
+ *  table must remove every overlap and precedence violation and
+ *  replay two hyperperiods with no deadline misses.
+ * ══════════════════════════════════════════════════════════════════ */
+
+/* Two-core control loop: sensor -> filter on core 0 feeds control ->
+   actuate on core 1 every 20 ticks; BUS and FLASH are shared devices */
+static TtSchedule *tt_build_system(SmpSystem *sys, TaskControlBlock **t)
+{
+    smp_init(sys, 2, SCHED_PRIORITY, false, 1);
+    Scheduler *c0 = smp_core(sys, 0);
+    Scheduler *c1 = smp_core(sys, 1);
+
+    t[0] = task_create(c0, "Sensor",  task_func_noop, NULL, 1, 20, 0, 4);
+    t[1] = task_create(c0, "Filter",  task_func_noop, NULL, 2, 20, 0, 5);
+    t[2] = task_create(c0, "Log",     task_func_noop, NULL, 3, 40, 0, 6);
+    t[3] = task_create(c1, "Control", task_func_noop, NULL, 1, 20, 0, 6);
+    t[4] = task_create(c1, "Actuate", task_func_noop, NULL, 2, 20, 0, 3);
+    t[5] = task_create(c1, "Diag",    task_func_noop, NULL, 3, 40, 0, 6);
+
+    TtSchedule *tt = tt_create(sys);
+    tt_add_precedence(tt, t[0], t[1]);
+    tt_add_precedence(tt, t[1], t[3]);
+    tt_add_precedence(tt, t[3], t[4]);
+    tt_use_resource(tt, t[0], "BUS");
+    tt_use_resource(tt, t[3], "BUS");
+    tt_use_resource(tt, t[5], "BUS");
+    tt_use_resource(tt, t[2], "FLASH");
+    tt_use_resource(tt, t[5], "FLASH");
+    return tt;
+}
+
+static uint32_t tt_run_audited(SmpSystem *sys, TtSchedule *tt,
+                               TaskControlBlock **t, uint64_t ticks)
+{
+    tt_audit_tick(tt);
+    for (uint64_t i = 0; i < ticks; i++) {
+        smp_run(sys, 1);
+        tt_audit_tick(tt);
+    }
+    uint32_t misses = 0;
+    for (int i = 0; i < 6; i++) misses += t[i]->deadline_misses;
+    return misses;
+}
+
+void test_tt_synthesis(void)
+{
+    print_separator("Time-Triggered Schedule Synthesis");
+
+    TaskControlBlock *t[6];
+
+    /* Priority dispatch ignores the chain and the shared devices */
+    SmpSystem   plain;
+    TtSchedule *audit = tt_build_system(&plain, t);
+    uint32_t plain_miss = tt_run_audited(&plain, audit, t, 80);
+    printf("\n  Priority dispatch, 80 ticks: %u BUS/FLASH overlaps, "
+           "%u precedence violations, %u misses\n",
+           audit->resource_conflicts, audit->precedence_violations,
+           plain_miss);
+
+    /* Same system replayed from a synthesized table */
+    SmpSystem   sys;
+    TtSchedule *tt = tt_build_system(&sys, t);
+    bool ok = tt_synthesize(tt) && tt_install(tt);
+    tt_print(tt);
+
+    uint32_t misses = ok ? tt_run_audited(&sys, tt, t,
+                                          2 * tt->hyperperiod) : 0;
+    printf("\n  Table replay, %" PRIu64 " ticks: %u overlaps, "
+           "%u precedence violations, %u misses\n",
+           2 * tt->hyperperiod, tt->resource_conflicts,
+           tt->precedence_violations, misses);
+
+    bool pass = (audit->resource_conflicts > 0 &&
+                 audit->precedence_violations > 0 &&
+                 ok && tt->resource_conflicts == 0 &&
+                 tt->precedence_violations == 0 && misses == 0 &&
+                 t[4]->invocations == 5 && t[5]->invocations == 3);
+    print_result(pass, "Time-Triggered Schedule Synthesis");
+
+    tt_destroy(audit);
+    tt_destroy(tt);
+    smp_destroy(&plain);
+    smp_destroy(&sys);
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 22: Logical Execution Time (LET)
+ *  A Sensor -> Control -> Actuator chain runs under three priority
+ *  orders next to an interfering task, once with direct communication
+ *  and once with LET. Direct end-to-end latency varies with the
+ *  priorities; under LET it must be exactly three periods in every
+ *  variation, with no misses and coherent data, at the cost of the
+ *  extra buffer memory.
+ * ══════════════════════════════════════════════════════════════════ */
+
+/* Sensor -> Control -> Actuator chain, all with T = 10 */
+typedef struct {
+    LetChannel *raw;        /* Sensor frame: sample number + readings */
+    LetChannel *cmd;
+    LetChannel *drive;
+} LetPipeline;
+
+static void let_sensor_step(TaskControlBlock *task, void *ctx)
+{
+    LetPipeline *ch  = ctx;
+    uint64_t    *raw = let_output(ch->raw);
+    raw[0] = task->invocations - 1;     /* Sample number */
+    for (int i = 1; i < 8; i++) raw[i] = raw[0] * (uint64_t)i;
+}
+
+static void let_control_step(TaskControlBlock *task, void *ctx)
+{
+    LetPipeline    *ch  = ctx;
+    const uint64_t *raw = let_input(ch->raw, task);
+    uint64_t       *cmd = let_output(ch->cmd);
+    cmd[0] = 2 * raw[0];
+    cmd[1] = raw[7];
+}
+
+static void let_actuator_step(TaskControlBlock *task, void *ctx)
+{
+    LetPipeline    *ch    = ctx;
+    const uint64_t *cmd   = let_input(ch->cmd, task);
+    uint64_t       *drive = let_output(ch->drive);
+    *drive = cmd[0] + 1;
+}
+
+/* One run: `order` gives the chain's priorities (sensor, control,
+   actuator) and `noise` the interfering task's */
+static void let_run(LetCommMode mode, const int order[3], int noise,
+                    uint64_t *lat_min, uint64_t *lat_max, size_t *mem,
+                    uint32_t *misses, bool *coherent, bool report)
+{
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_PRIORITY, false);
+
+    TaskControlBlock *s = task_create(&sched, "Sensor", task_func_noop,
+                                      NULL, order[0], 10, 0, 2);
+    TaskControlBlock *c = task_create(&sched, "Control", task_func_noop,
+                                      NULL, order[1], 10, 0, 3);
+    TaskControlBlock *a = task_create(&sched, "Actuator", task_func_noop,
+                                      NULL, order[2], 10, 0, 1);
+    TaskControlBlock *n = task_create(&sched, "Noise", task_func_noop,
+                                      NULL, noise, 7, 0, 2);
+
+    LetPipeline chain;
+    let_enable(&sched, mode);
+    chain.raw   = let_channel_create(&sched, "raw", s, 8 * sizeof(uint64_t));
+    chain.cmd   = let_channel_create(&sched, "cmd", c, 2 * sizeof(uint64_t));
+    chain.drive = let_channel_create(&sched, "drive", a, sizeof(uint64_t));
+    let_channel_add_reader(&sched, chain.raw, c);
+    let_channel_add_reader(&sched, chain.cmd, a);
+    let_set_step(&sched, s, let_sensor_step, &chain);
+    let_set_step(&sched, c, let_control_step, &chain);
+    let_set_step(&sched, a, let_actuator_step, &chain);
+    let_start(&sched);
+
+    scheduler_schedule(&sched);
+    for (int t = 0; t < 400; t++) {
+        tick_handler(&sched);
+
+        TaskControlBlock *curr = sched.current_task;
+        if (curr && curr != sched.idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+        {
+            task_set_state(curr, TASK_SUSPENDED);
+        }
+        scheduler_schedule(&sched);
+    }
+
+    if (report) let_print_report(&sched);
+
+    /* The published drive value must match the sample it is stamped
+       with: drive = 2 * (sample number) + 1 */
+    const LetChannel *d = chain.drive;
+    uint64_t drive = *(const uint64_t *)d->buf[d->front];
+    *coherent = !d->valid[d->front] ||
+                drive == 2 * (d->stamp[d->front] / 10) + 1;
+
+    *lat_min = d->latency_min;
+    *lat_max = d->latency_max;
+    *mem     = let_memory_bytes(&sched);
+    *misses  = s->deadline_misses + c->deadline_misses +
+               a->deadline_misses + n->deadline_misses;
+
+    scheduler_destroy(&sched);
+}
+
+void test_let(void)
+{
+    print_separator("Logical Execution Time (LET)");
+
+    /* Scheduling variations of the same task set (U = 0.89) */
+    static const int order[3][3] = { { 2, 3, 4 }, { 4, 3, 2 }, { 3, 4, 2 } };
+    static const int noise[3]    = { 1, 5, 3 };
+    static const char *label[3]  = { "chain order, noise highest",
+                                     "reversed, noise lowest",
+                                     "mixed, noise in between" };
+
+    uint64_t let_lo = UINT64_MAX, let_hi = 0, dir_lo = UINT64_MAX,
+             dir_hi = 0;
+    size_t   let_mem = 0, dir_mem = 0;
+    uint32_t let_misses = 0;
+    bool     coherent = true;
+
+    uint64_t lo[3][2], hi[3][2];
+    for (int v = 0; v < 3; v++) {
+        uint32_t miss[2];
+        bool     ok[2];
+        let_run(LET_COMM_DIRECT, order[v], noise[v], &lo[v][0], &hi[v][0],
+                &dir_mem, &miss[0], &ok[0], false);
+        let_run(LET_COMM_LOGICAL, order[v], noise[v], &lo[v][1], &hi[v][1],
+                &let_mem, &miss[1], &ok[1], v == 0);
+
+        if (lo[v][0] < dir_lo) dir_lo = lo[v][0];
+        if (hi[v][0] > dir_hi) dir_hi = hi[v][0];
+        if (lo[v][1] < let_lo) let_lo = lo[v][1];
+        if (hi[v][1] > let_hi) let_hi = hi[v][1];
+        let_misses += miss[1];
+        coherent = coherent && ok[0] && ok[1];
+    }
+
+    printf("\n  Sensor(2) -> raw -> Control(3) -> cmd -> Actuator(1) -> "
+           "drive, T = 10, plus Noise C=2/T=7\n");
+    printf("\n  %-28s %19s %19s\n", "Variation", "direct latency",
+           "LET latency");
+    for (int v = 0; v < 3; v++) {
+        printf("  %-28s %8" PRIu64 " ..%4" PRIu64 " %13" PRIu64 " ..%4"
+               PRIu64 "\n", label[v], lo[v][0], hi[v][0], lo[v][1],
+               hi[v][1]);
+    }
+
+    printf("\n  Direct: latency %" PRIu64 "..%" PRIu64 " ticks, %zu B of "
+           "buffers\n", dir_lo, dir_hi, dir_mem);
+    printf("  LET:    latency %" PRIu64 "..%" PRIu64 " ticks (3 periods), "
+           "%zu B of buffers (+%zu B for double buffering)\n",
+           let_lo, let_hi, let_mem, let_mem - dir_mem);
+
+    bool pass = (let_lo == 30 && let_hi == 30 && dir_hi > dir_lo &&
+                 let_misses == 0 && coherent && let_mem > dir_mem);
+    print_result(pass, "Logical Execution Time (LET)");
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 23: Cause-Effect Chain Latency
+ *  A wheel-speed sensor feeds an estimator whose output reaches a
+ *  brake task and a slower display task. Maximum reaction time and
+ *  data age of both chains are measured with direct and LET
+ *  communication and must stay within the analytic bounds. The longer
+ *  chain reacts more slowly, and LET trades a longer data age for
+ *  fixed timing.
+ * ══════════════════════════════════════════════════════════════════ */
+
+/* Wheel speed (T=5) -> estimator (T=10) -> brake (T=20) and display
+   (T=40); returns true if every chain stayed within its bound */
+static bool chain_run(LetCommMode mode, uint64_t *reaction, uint64_t *age)
+{
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_RATE_MONOTONIC, false);
+
+    TaskControlBlock *wheel = task_create(&sched, "Wheel", task_func_noop,
+                                          NULL, 1,  5, 0, 1);
+    TaskControlBlock *est   = task_create(&sched, "Estim", task_func_noop,
+                                          NULL, 2, 10, 0, 3);
+    TaskControlBlock *brake = task_create(&sched, "Brake", task_func_noop,
+                                          NULL, 3, 20, 0, 4);
+    TaskControlBlock *disp  = task_create(&sched, "Display", task_func_noop,
+                                          NULL, 4, 40, 0, 6);
+
+    let_enable(&sched, mode);
+    let_writes(&sched, wheel, "speed", 8);
+    let_writes(&sched, est, "slip", 16);
+    let_writes(&sched, brake, "torque", 8);
+    let_reads(&sched, est, "speed");
+    let_reads(&sched, brake, "slip");
+    let_reads(&sched, disp, "slip");
+
+    TaskControlBlock *const brake_path[] = { wheel, est, brake };
+    TaskControlBlock *const disp_path[]  = { wheel, est, disp };
+    LetChain *chain[2] = {
+        let_chain_create(&sched, "brake", brake_path, 3),
+        let_chain_create(&sched, "display", disp_path, 3) };
+    let_start(&sched);
+
+    scheduler_schedule(&sched);
+    for (int t = 0; t < 800; t++) {
+        tick_handler(&sched);
+
+        TaskControlBlock *curr = sched.current_task;
+        if (curr && curr != sched.idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+        {
+            task_set_state(curr, TASK_SUSPENDED);
+        }
+        scheduler_schedule(&sched);
+    }
+
+    let_print_report(&sched);
+
+    bool ok = chain[0] && chain[1];
+    for (int k = 0; ok && k < 2; k++) {
+        uint64_t bound = let_chain_bound(&sched, chain[k]);
+        reaction[k] = chain[k]->max_reaction;
+        age[k]      = chain[k]->max_age;
+        ok = bound > 0 && chain[k]->outputs > 0 &&
+             reaction[k] > 0 && reaction[k] <= bound && age[k] <= bound;
+    }
+    scheduler_destroy(&sched);
+    return ok;
+}
+
+void test_cause_effect_chains(void)
+{
+    print_separator("Cause-Effect Chain Latency");
+
+    printf("\n  Wheel C=1/T=5 -> speed -> Estim C=3/T=10 -> slip -> "
+           "Brake C=4/T=20\n");
+    printf("                                          slip -> "
+           "Display C=6/T=40\n");
+
+    uint64_t dir_r[2] = { 0, 0 }, dir_a[2] = { 0, 0 };
+    uint64_t let_r[2] = { 0, 0 }, let_a[2] = { 0, 0 };
+    bool dir_ok = chain_run(LET_COMM_DIRECT, dir_r, dir_a);
+    bool let_ok = chain_run(LET_COMM_LOGICAL, let_r, let_a);
+
+    printf("\n  Brake chain:   direct reaction %" PRIu64 " / age %" PRIu64
+           ", LET reaction %" PRIu64 " / age %" PRIu64 "\n",
+           dir_r[0], dir_a[0], let_r[0], let_a[0]);
+    printf("  Display chain: direct reaction %" PRIu64 " / age %" PRIu64
+           ", LET reaction %" PRIu64 " / age %" PRIu64 "\n",
+           dir_r[1], dir_a[1], let_r[1], let_a[1]);
+
+    /* Slower consumers see older data and react later */
+    bool pass = (dir_ok && let_ok && dir_r[1] > dir_r[0] &&
+                 let_r[1] > let_r[0] && let_a[0] > dir_a[0]);
+    print_result(pass, "Cause-Effect Chain Latency");
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 24: Precedence-Constrained Task Graphs
+ *  A graph Sense -> {Act, Log} -> Fuse shares the core with an
+ *  independent task. With the graph's own deadlines, fixed-priority
+ *  and EDF dispatch both miss. After Chetto's transformation, with
+ *  deadline-monotonic priorities or EDF, every deadline is met and
+ *  the end-to-end latency stays within the period. A cyclic graph
+ *  must be rejected.
+ * ══════════════════════════════════════════════════════════════════ */
+
+/* Sense -> {Act (due 8 after release), Log} -> Fuse, plus an
+   independent task Y; returns deadline misses over 200 ticks */
+static uint32_t prec_run(PrecDispatch dispatch, bool transform,
+                         uint64_t *latency_max, bool report)
+{
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_PRIORITY, false);
+
+    TaskControlBlock *y     = task_create(&sched, "Y", task_func_noop,
+                                          NULL, 1, 20, 12, 6);
+    TaskControlBlock *sense = task_create(&sched, "Sense", task_func_noop,
+                                          NULL, 2, 20, 0, 2);
+    TaskControlBlock *act   = task_create(&sched, "Act", task_func_noop,
+                                          NULL, 3, 20, 0, 3);
+    TaskControlBlock *log   = task_create(&sched, "Log", task_func_noop,
+                                          NULL, 4, 20, 0, 2);
+    TaskControlBlock *fuse  = task_create(&sched, "Fuse", task_func_noop,
+                                          NULL, 5, 20, 0, 1);
+
+    prec_enable(&sched, dispatch);
+    PrecGraph *g = prec_graph_create(&sched, "Ctrl", 20, 20);
+    prec_add_node(g, sense, 0);
+    prec_add_node(g, act, 8);
+    prec_add_node(g, log, 0);
+    prec_add_node(g, fuse, 0);
+    prec_add_edge(g, sense, act);
+    prec_add_edge(g, sense, log);
+    prec_add_edge(g, act, fuse);
+    prec_add_edge(g, log, fuse);
+    if (transform) prec_transform(&sched);
+
+    prec_start(&sched);
+
+    scheduler_schedule(&sched);
+    for (int t = 0; t < 200; t++) {
+        tick_handler(&sched);
+
+        TaskControlBlock *curr = sched.current_task;
+        if (curr && curr != sched.idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+        {
+            task_set_state(curr, TASK_SUSPENDED);
+        }
+        scheduler_schedule(&sched);
+    }
+
+    if (report) prec_print_report(&sched);
+
+    uint32_t misses = y->deadline_misses + sense->deadline_misses +
+                      act->deadline_misses + log->deadline_misses +
+                      fuse->deadline_misses + g->late;
+    *latency_max = g->latency_max;
+    scheduler_destroy(&sched);
+    return misses;
+}
+
+void test_precedence_graphs(void)
+{
+    print_separator("Precedence-Constrained Task Graphs");
+
+    /* Cycles are rejected when declared */
+    Scheduler probe;
+    scheduler_init(&probe, SCHED_PRIORITY, false);
+    TaskControlBlock *p = task_create(&probe, "P", task_func_noop, NULL,
+                                      1, 10, 0, 1);
+    TaskControlBlock *q = task_create(&probe, "Q", task_func_noop, NULL,
+                                      2, 10, 0, 1);
+    prec_enable(&probe, PREC_DISPATCH_FIXED);
+    PrecGraph *pg = prec_graph_create(&probe, "Probe", 10, 10);
+    prec_add_node(pg, p, 0);
+    prec_add_node(pg, q, 0);
+    bool cycle_rejected = prec_add_edge(pg, p, q) &&
+                          !prec_add_edge(pg, q, p) && prec_validate(pg);
+    scheduler_destroy(&probe);
+
+    printf("\n  Ctrl (T=D=20): Sense C=2 -> Act C=3 (due at 8), "
+           "Sense -> Log C=2, Act+Log -> Fuse C=1\n");
+    printf("  Independent Y C=6, T=20, D=12\n");
+
+    uint64_t lat[4];
+    uint32_t fp_plain  = prec_run(PREC_DISPATCH_FIXED, false, &lat[0], false);
+    uint32_t fp_dm     = prec_run(PREC_DISPATCH_FIXED, true, &lat[1], true);
+    uint32_t edf_plain = prec_run(PREC_DISPATCH_EDF, false, &lat[2], false);
+    uint32_t edf_chet  = prec_run(PREC_DISPATCH_EDF, true, &lat[3], true);
+
+    printf("\n  %-34s %7s %12s\n", "Configuration", "Misses",
+           "Max latency");
+    printf("  %-34s %7u %12" PRIu64 "\n", "Fixed priority, given order",
+           fp_plain, lat[0]);
+    printf("  %-34s %7u %12" PRIu64 "\n", "Fixed priority, DM on d*",
+           fp_dm, lat[1]);
+    printf("  %-34s %7u %12" PRIu64 "\n", "EDF, declared deadlines",
+           edf_plain, lat[2]);
+    printf("  %-34s %7u %12" PRIu64 "\n", "EDF, Chetto deadlines",
+           edf_chet, lat[3]);
+
+    bool pass = (cycle_rejected && fp_plain > 0 && edf_plain > 0 &&
+                 fp_dm == 0 && edf_chet == 0 && lat[1] <= 20 &&
+                 lat[3] <= 20);
+    print_result(pass, "Precedence-Constrained Task Graphs");
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 25: Interrupt Sources and Bottom-Half Deferral
+ *  Periodic, sporadic and bursty interrupt sources preempt the task
+ *  set. Their handlers signal a semaphore or notify bottom-half
+ *  tasks. Every source must be served within its latency bound with
+ *  none lost. Comp's measured response must exceed the plain RTA yet
+ *  stay within the ISR-aware RTA, and no deadline may be missed.
+ * ══════════════════════════════════════════════════════════════════ */
+
+void test_interrupts(void)
+{
+    print_separator("Interrupt Sources and Bottom-Half Deferral");
+
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_PRIORITY, false);
+
+    TaskControlBlock *rx_bh   = task_create(&sched, "RxBH", task_func_noop,
+                                            NULL, 1, 0, 0, 1);
+    TaskControlBlock *dma_bh  = task_create(&sched, "DmaBH", task_func_noop,
+                                            NULL, 2, 0, 0, 1);
+    TaskControlBlock *ctl     = task_create(&sched, "Ctl", task_func_noop,
+                                            NULL, 3, 20, 0, 2);
+    TaskControlBlock *sampler = task_create(&sched, "Sampler",
+                                            task_func_noop, NULL, 4, 0, 0, 1);
+    TaskControlBlock *comp    = task_create(&sched, "Comp", task_func_noop,
+                                            NULL, 5, 40, 0, 6);
+    Semaphore *tick_sem = semaphore_create(&sched, "tick", 0, 4);
+
+    isr_enable(&sched);
+    IsrSource *timer = isr_add_periodic(&sched, "Timer", 0, 1, 10, 3);
+    IsrSource *uart  = isr_add_sporadic(&sched, "UART", 1, 1, 10, 10, 42);
+    IsrSource *dma   = isr_add_bursty(&sched, "DMA", 2, 2, 50, 4, 3);
+    isr_signal_semaphore(timer, tick_sem, sampler);
+    isr_notify_task(uart, rx_bh);
+    isr_notify_task(dma, dma_bh);
+    semaphore_wait(tick_sem, sampler);
+
+    printf("\n  Tasks: RxBH(1) DmaBH(2) C=1 aperiodic, Ctl(3) T=20 C=2, "
+           "Sampler(4) C=1 on a semaphore, Comp(5) T=40 C=6\n");
+    printf("  Timer T=10 signals Sampler, UART gap 10+[0,10] notifies "
+           "RxBH, DMA 4 every 50 (cost 2) notifies DmaBH\n");
+
+    uint64_t comp_resp = 0;
+    scheduler_schedule(&sched);
+    for (int t = 0; t < 2000; t++) {
+        tick_handler(&sched);
+
+        TaskControlBlock *curr = sched.current_task;
+        if (curr && curr != sched.idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+        {
+            if (curr == comp) {
+                uint64_t resp = sched.system_ticks -
+                                (comp->absolute_deadline -
+                                 comp->relative_deadline);
+                if (resp > comp_resp) comp_resp = resp;
+            }
+            if (curr == sampler) {
+                /* Next sample waits for the next timer interrupt */
+                release_job(&sched, sampler);
+                semaphore_wait(tick_sem, sampler);
+            } else {
+                task_set_state(curr, TASK_SUSPENDED);
+            }
+        }
+        scheduler_schedule(&sched);
+    }
+
+    isr_print_report(&sched);
+
+    uint64_t rta_plain = isr_response_time(&sched, comp, false);
+    uint64_t rta_isr   = isr_response_time(&sched, comp, true);
+    printf("\n  Comp response: measured max %" PRIu64 ", RTA without "
+           "ISRs %" PRIu64 ", with ISRs %" PRIu64 "\n", comp_resp,
+           rta_plain, rta_isr);
+
+    uint64_t rta_ctl   = isr_response_time(&sched, ctl, true);
+    printf("  Ctl RTA with ISRs %" PRIu64 "; deadline misses Ctl %u, "
+           "Comp %u\n", rta_ctl, ctl->deadline_misses,
+           comp->deadline_misses);
+    bool pass = (rta_isr > 0 && rta_ctl > 0 && rta_plain < rta_isr &&
+                 rta_plain < comp_resp && comp_resp <= rta_isr &&
+                 comp->deadline_misses == 0 &&
+                 ctl->deadline_misses == 0);
+    const IsrSource *srcs[3] = { timer, uart, dma };
+    for (int i = 0; i < 3; i++) {
+        uint64_t bound = isr_latency_bound(&sched, srcs[i]);
+        if (srcs[i]->raised == 0 || srcs[i]->served == 0 ||
+            srcs[i]->lost > 0 || bound == 0 ||
+            srcs[i]->latency_max > bound) {
+            pass = false;
+        }
+    }
+
+    semaphore_destroy(tick_sem);
+    scheduler_destroy(&sched);
+    print_result(pass, "Interrupt Sources and Bottom-Half Deferral");
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 26: Software Timers on a Timing Wheel
+ *  Auto-reload, one-shot and stopped timers run with the timer daemon
+ *  above and below a long task. Above it every callback runs on its
+ *  tick; below it callbacks are delayed and late expiries count as
+ *  overruns. A benchmark with up to 100000 active timers checks that
+ *  every expiry is accounted for and reports the cost per start, tick
+ *  and stop.
+ * ══════════════════════════════════════════════════════════════════ */
+
+typedef struct {
+    uint32_t fires;
+    uint64_t first;
+    uint64_t last;
+    uint32_t off_grid;      /* Blink callbacks not at a multiple of 10 */
+} TimerProbe;
+
+static void timer_probe_cb(SwTimer *timer, void *ctx)
+{
+    TimerProbe *p = ctx;
+    uint64_t now = timer->sched->system_ticks - 1;  /* Daemon's tick */
+    if (p->fires++ == 0) p->first = now;
+    p->last = now;
+    if (timer->auto_reload && now % timer->period != 0) p->off_grid++;
+}
+
+static void timer_count_cb(SwTimer *timer, void *ctx)
+{
+    (void)timer;
+    (*(uint64_t *)ctx)++;
+}
+
+static uint64_t bench_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+/* Blink, watchdog and poll timers beside a CPU hog; returns the
+   callback latency and fills the probes */
+static uint64_t timer_run(uint8_t daemon_prio, TimerProbe probe[3],
+                          bool report)
+{
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_PRIORITY, false);
+    task_create(&sched, "Hog", task_func_noop, NULL, 2, 50, 0, 20);
+
+    timer_service_enable(&sched, daemon_prio);
+    memset(probe, 0, 3 * sizeof(TimerProbe));
+    SwTimer *blink = swtimer_create(&sched, "Blink", 10, true,
+                                    timer_probe_cb, &probe[0]);
+    SwTimer *wdog  = swtimer_create(&sched, "Watchdog", 30, false,
+                                    timer_probe_cb, &probe[1]);
+    SwTimer *poll  = swtimer_create(&sched, "Poll", 7, true,
+                                    timer_probe_cb, &probe[2]);
+    swtimer_start(blink);
+    swtimer_start(wdog);
+    swtimer_start(poll);
+
+    scheduler_schedule(&sched);
+    for (int t = 0; t < 200; t++) {
+        tick_handler(&sched);
+
+        /* Kicked every 20 ticks until tick 100, then left to expire */
+        uint64_t now = sched.system_ticks;
+        if (now % 20 == 0 && now <= 100) swtimer_reset(wdog);
+        if (now == 100) swtimer_stop(poll);
+
+        TaskControlBlock *curr = sched.current_task;
+        if (curr && curr != sched.idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+        {
+            task_set_state(curr, TASK_SUSPENDED);
+        }
+        scheduler_schedule(&sched);
+    }
+
+    if (report) timer_service_print_report(&sched);
+    uint64_t latency = sched.timers->latency_max;
+
+    swtimer_delete(blink);
+    swtimer_delete(wdog);
+    swtimer_delete(poll);
+    scheduler_destroy(&sched);
+    return latency;
+}
+
+/* `count` auto-reload timers over `ticks`; ns per start, per tick and
+   per stop, and whether every expiry and callback was accounted for */
+static bool timer_bench(uint32_t count, uint64_t ticks, double ns[3],
+                        bool report)
+{
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_PRIORITY, false);
+    timer_service_enable(&sched, 0);
+
+    SwTimer **timers = malloc(count * sizeof(SwTimer *));
+    uint64_t calls = 0, expected = 0;
+    uint32_t seed = 12345;
+    for (uint32_t i = 0; i < count; i++) {
+        seed = seed * 1664525u + 1013904223u;
+        uint64_t period = 1 + (seed >> 8) % 100000;  /* Levels 0 to 2 */
+        timers[i] = swtimer_create(&sched, "T", period, true,
+                                   timer_count_cb, &calls);
+        expected += ticks / period;
+    }
+
+    uint64_t t0 = bench_ns();
+    for (uint32_t i = 0; i < count; i++) swtimer_start(timers[i]);
+    uint64_t t1 = bench_ns();
+
+    scheduler_schedule(&sched);
+    for (uint64_t t = 0; t < ticks; t++) {
+        tick_handler(&sched);
+        TaskControlBlock *curr = sched.current_task;
+        if (curr && curr != sched.idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+        {
+            task_set_state(curr, TASK_SUSPENDED);
+        }
+        scheduler_schedule(&sched);
+    }
+    uint64_t t2 = bench_ns();
+
+    if (report) timer_service_print_report(&sched);
+    const TimerState *ts = sched.timers;
+    bool ok = (ts->active == count && ts->expirations == expected &&
+               ts->late_expiries == 0 && ts->overruns == 0 &&
+               calls + ts->q_length == expected);
+
+    uint64_t t3 = bench_ns();
+    for (uint32_t i = 0; i < count; i++) swtimer_stop(timers[i]);
+    uint64_t t4 = bench_ns();
+    ok = ok && sched.timers->active == 0;
+
+    ns[0] = (double)(t1 - t0) / count;
+    ns[1] = (double)(t2 - t1) / ticks;
+    ns[2] = (double)(t4 - t3) / count;
+
+    for (uint32_t i = 0; i < count; i++) swtimer_delete(timers[i]);
+    free(timers);
+    scheduler_destroy(&sched);
+    return ok;
+}
+
+void test_software_timers(void)
+{
+    print_separator("Software Timers on a Timing Wheel");
+
+    printf("\n  Blink every 10, Watchdog 30 one-shot kicked every 20 "
+           "until tick 100, Poll every 7 stopped at 100\n");
+    printf("  Hog (priority 2) T=50 C=20; timer daemon above or below "
+           "it\n");
+
+    TimerProbe hi[3], lo[3];
+    uint64_t lat_hi = timer_run(1, hi, true);
+    uint64_t lat_lo = timer_run(3, lo, false);
+
+    printf("\n  %-22s %6s %9s %9s %7s %8s\n", "Daemon", "Blink",
+           "Watchdog", "at tick", "Poll", "Latency");
+    printf("  %-22s %6u %9u %9" PRIu64 " %7u %8" PRIu64 "\n",
+           "Above Hog (prio 1)", hi[0].fires, hi[1].fires, hi[1].first,
+           hi[2].fires, lat_hi);
+    printf("  %-22s %6u %9u %9" PRIu64 " %7u %8" PRIu64 "\n",
+           "Below Hog (prio 3)", lo[0].fires, lo[1].fires, lo[1].first,
+           lo[2].fires, lat_lo);
+
+    double small[3], big[3];
+    bool small_ok = timer_bench(1000, 2000, small, false);
+    bool big_ok   = timer_bench(100000, 2000, big, true);
+    printf("\n  %-16s %10s %10s %10s\n", "Active timers", "ns/start",
+           "ns/tick", "ns/stop");
+    printf("  %-16u %10.1f %10.1f %10.1f\n", 1000, small[0], small[1],
+           small[2]);
+    printf("  %-16u %10.1f %10.1f %10.1f\n", 100000, big[0], big[1],
+           big[2]);
+
+    /* Above the hog, Blink runs at 10..190 (the call due at 200 is
+       still queued) and Poll 14 times before it is stopped. Below it,
+       expiries during a hog job find the previous call still queued
+       and are counted as overruns */
+    bool pass = (hi[0].fires == 19 && hi[0].off_grid == 0 &&
+                 hi[1].fires == 1 && hi[1].first == 130 &&
+                 hi[2].fires == 14 && lat_hi == 0 &&
+                 lo[1].fires == 1 && lo[0].fires < hi[0].fires &&
+                 lo[2].fires < hi[2].fires && lat_lo > 0 &&
+                 small_ok && big_ok);
+    print_result(pass, "Software Timers on a Timing Wheel");
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 27: Task Delays and the Sleep Queue
+ *  A task looping with task_delay_until stays on its 10-tick grid
+ *  under preemption while one using task_delay drifts. Forty-eight
+ *  sleepers with random delays must wake in order, exactly on their
+ *  tick. On a core with sleep states, the sleep queue's next wake-up
+ *  times the tickless sleep without late wake-ups.
+ * ══════════════════════════════════════════════════════════════════ */
+
+/* Next iteration of a task body that ends in a delay */
+static void delay_next_job(TaskControlBlock *t)
+{
+    release_job(t->scheduler, t);
+}
+
+/* `grid` and `drift` loop with `interval` ticks between iterations */
+static void delay_tick(Scheduler *sched, TaskControlBlock *grid,
+                       uint64_t *grid_last, TaskControlBlock *drift,
+                       uint64_t interval)
+{
+    tick_handler(sched);
+
+    TaskControlBlock *curr = sched->current_task;
+    if (curr && curr != sched->idle_task &&
+        curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+    {
+        if (curr == grid) {
+            delay_next_job(grid);
+            task_delay_until(grid, grid_last, interval);
+        } else if (curr == drift) {
+            delay_next_job(drift);
+            task_delay(drift, interval);
+        } else {
+            task_set_state(curr, TASK_SUSPENDED);
+        }
+    }
+    scheduler_schedule(sched);
+}
+
+void test_task_delays(void)
+{
+    print_separator("Task Delays and the Sleep Queue");
+
+    /* Part 1: fixed grid vs. relative delay under preemption */
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_PRIORITY, false);
+    task_create(&sched, "Burst", task_func_noop, NULL, 1, 25, 0, 4);
+    TaskControlBlock *grid  = task_create(&sched, "Grid", task_func_noop,
+                                          NULL, 2, 0, 0, 3);
+    TaskControlBlock *drift = task_create(&sched, "Drift", task_func_noop,
+                                          NULL, 3, 0, 0, 3);
+
+    printf("\n  Burst T=25 C=4 preempts Grid (C=3, delay_until every 10) "
+           "and Drift (C=3, delay 10 after each run)\n");
+
+    uint64_t grid_last = 0;
+    uint32_t grid_wakes = 0, grid_off = 0, drift_wakes = 0;
+    uint64_t drift_prev = 0, drift_gap_max = 0;
+    scheduler_schedule(&sched);
+    for (int t = 0; t < 200; t++) {
+        bool g_was = grid->delayed, d_was = drift->delayed;
+        delay_tick(&sched, grid, &grid_last, drift, 10);
+        uint64_t now = sched.system_ticks;
+        if (g_was && !grid->delayed) {
+            grid_wakes++;
+            if (now % 10 != 0) grid_off++;
+        }
+        if (d_was && !drift->delayed) {
+            drift_wakes++;
+            if (drift_prev && now - drift_prev > drift_gap_max) {
+                drift_gap_max = now - drift_prev;
+            }
+            drift_prev = now;
+        }
+    }
+    printf("\n  %-8s %6s %6s %14s\n", "Task", "Wakes", "Runs",
+           "Wake interval");
+    printf("  %-8s %6u %6u %14s\n", "Grid", grid_wakes, grid->invocations,
+           grid_off ? "drifts" : "10 (on grid)");
+    printf("  %-8s %6u %6u %11s %2" PRIu64 "\n", "Drift", drift_wakes,
+           drift->invocations, "up to", drift_gap_max);
+    bool grid_ok = grid_wakes == 20 && grid_off == 0 &&
+                   grid->invocations == 21 && drift_gap_max > 10 &&
+                   drift->invocations < grid->invocations;
+    scheduler_destroy(&sched);
+
+    /* Part 2: many sleepers wake in order, exactly on their tick */
+    scheduler_init(&sched, SCHED_PRIORITY, false);
+    TaskControlBlock *sleeper[48];
+    uint64_t wake_at[48];
+    uint32_t seed = 7;
+    for (int i = 0; i < 48; i++) {
+        char name[16];
+        snprintf(name, sizeof(name), "S%d", i);
+        sleeper[i] = task_create(&sched, name, task_func_noop, NULL,
+                                 10 + i, 0, 0, 1);
+        seed = seed * 1664525u + 1013904223u;
+        task_delay(sleeper[i], 1 + (seed >> 8) % 150);
+        wake_at[i] = sleeper[i]->wake_tick;
+    }
+    bool sorted = true;
+    for (TaskControlBlock *t = sched.sleep_head; t && t->next; t = t->next) {
+        if (t->next->wake_tick < t->wake_tick) sorted = false;
+    }
+    int sleeping = sched.sleep_count;
+    uint32_t late = 0, early = 0;
+    scheduler_schedule(&sched);
+    for (int t = 0; t < 160; t++) {
+        tick_handler(&sched);
+        for (int i = 0; i < 48; i++) {
+            bool asleep = sleeper[i]->delayed;
+            if (sched.system_ticks < wake_at[i] && !asleep) early++;
+            if (sched.system_ticks >= wake_at[i] && asleep) late++;
+        }
+        TaskControlBlock *curr = sched.current_task;
+        if (curr && curr != sched.idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+        {
+            task_set_state(curr, TASK_SUSPENDED);
+        }
+        scheduler_schedule(&sched);
+    }
+    printf("\n  48 sleepers, random delays 1-150: queue sorted %s, "
+           "early wakes %u, late wakes %u, left %d\n",
+           sorted ? "yes" : "no", early, late, sched.sleep_count);
+    bool order_ok = sorted && sleeping == 48 && early == 0 && late == 0 &&
+                    sched.sleep_count == 0;
+    scheduler_destroy(&sched);
+
+    /* Part 3: the sleep queue feeds the tickless wake-up */
+    scheduler_init(&sched, SCHED_PRIORITY, false);
+    TaskControlBlock *poll = task_create(&sched, "Poll", task_func_noop,
+                                         NULL, 1, 0, 0, 5);
+    dpm_enable(&sched, DPM_SLEEP, 50);
+    dpm_add_state(&sched, "Sleep", 20.0, 2, 3, 2500.0);
+    uint64_t poll_last = 0, event_at_sleep = 0;
+    scheduler_schedule(&sched);
+    for (int t = 0; t < 500; t++) {
+        delay_tick(&sched, poll, &poll_last, NULL, 50);
+        if (!event_at_sleep && dpm_core_asleep(&sched)) {
+            event_at_sleep = next_event_tick(&sched);
+        }
+    }
+    printf("\n  Poll (C=5, delay_until every 50) on a sleeping core: "
+           "first sleep until tick %" PRIu64 "\n", event_at_sleep);
+    dpm_print_report(&sched);
+    bool tickless_ok = event_at_sleep == 50 && sched.dpm->wakeups >= 9 &&
+                       sched.dpm->late_wakeups == 0 &&
+                       poll->invocations >= 10 &&
+                       poll->deadline_misses == 0 &&
+                       dpm_mean_idle_interval(&sched) <=
+                           (double)sched.dpm->idle_longest;
+    scheduler_destroy(&sched);
+
+    bool pass = (grid_ok && order_ok && tickless_ok);
+    print_result(pass, "Task Delays and the Sleep Queue");
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 28: Fixed-Block Memory Pools
+ *  Allocation and free run in O(1) on an aligned intrusive free list,
+ *  and invalid frees are rejected. Waiters on an empty pool are
+ *  served by priority or time out, and a producer/consumer pipeline
+ *  sized to its measured high-water mark runs without allocation
+ *  failures while one block less fails.
+ * ══════════════════════════════════════════════════════════════════ */
+
+/* Net (T=3) fills one buffer per job without waiting; Proc (T=10)
+   frees every queued buffer when its job completes */
+static void pool_pipeline(uint32_t blocks, MemPool *out_stats,
+                          bool report)
+{
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_PRIORITY, false);
+    TaskControlBlock *net  = task_create(&sched, "Net", task_func_noop,
+                                         NULL, 1, 3, 0, 1);
+    TaskControlBlock *proc = task_create(&sched, "Proc", task_func_noop,
+                                         NULL, 2, 10, 0, 2);
+    MemPool *pool = mempool_create(&sched, "Packets", 48, blocks);
+
+    void *queue[64];
+    int queued = 0;
+    scheduler_schedule(&sched);
+    for (int t = 0; t < 1000; t++) {
+        tick_handler(&sched);
+
+        TaskControlBlock *curr = sched.current_task;
+        if (curr && curr != sched.idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+        {
+            if (curr == net) {
+                void *buf = mempool_alloc(pool, net, MEMPOOL_NO_WAIT);
+                if (buf) {
+                    memset(buf, 0xA5, pool->block_size);
+                    queue[queued++] = buf;
+                }
+            } else if (curr == proc) {
+                while (queued > 0) mempool_free(pool, queue[--queued]);
+            }
+            task_set_state(curr, TASK_SUSPENDED);
+        }
+        scheduler_schedule(&sched);
+    }
+
+    if (report) mempool_print_report(pool);
+    *out_stats = *pool;
+    mempool_destroy(pool);
+    scheduler_destroy(&sched);
+}
+
+void test_memory_pools(void)
+{
+    print_separator("Fixed-Block Memory Pools");
+
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_PRIORITY, false);
+    TaskControlBlock *log = task_create(&sched, "Log", task_func_noop,
+                                        NULL, 5, 0, 0, 1);
+    TaskControlBlock *aux = task_create(&sched, "Aux", task_func_noop,
+                                        NULL, 3, 0, 0, 1);
+    TaskControlBlock *ctl = task_create(&sched, "Ctl", task_func_noop,
+                                        NULL, 2, 0, 0, 1);
+
+    /* Part 1: O(1) alloc/free on the intrusive free list */
+    MemPool *pool = mempool_create(&sched, "Msg", 20, 4);
+    void *b[4];
+    bool api_ok = pool && pool->stride % _Alignof(max_align_t) == 0;
+    for (int i = 0; i < 4; i++) {
+        b[i] = mempool_alloc(pool, NULL, MEMPOOL_NO_WAIT);
+        api_ok = api_ok && b[i] &&
+                 (uintptr_t)b[i] % _Alignof(max_align_t) == 0;
+    }
+    api_ok = api_ok && !mempool_alloc(pool, NULL, MEMPOOL_NO_WAIT) &&
+             pool->failures == 1 && pool->high_water == 4;
+    int local;
+    api_ok = api_ok && !mempool_free(pool, &local) &&
+             !mempool_free(pool, (uint8_t *)b[0] + 1) &&
+             mempool_free(pool, b[3]) && !mempool_free(pool, b[3]) &&
+             mempool_alloc(pool, NULL, MEMPOOL_NO_WAIT) == b[3] &&
+             pool->bad_frees == 3;
+    printf("\n  Msg pool 4 x 20 B: stride %zu, 4 allocs, empty alloc "
+           "fails, 3 bad frees rejected, LIFO reuse: %s\n", pool->stride,
+           api_ok ? "ok" : "FAILED");
+
+    /* Part 2: priority-ordered waiters with timeouts */
+    scheduler_schedule(&sched);
+    mempool_alloc(pool, log, MEMPOOL_WAIT_FOREVER);     /* tick 0 */
+    void *got_ctl = NULL, *got_aux = (void *)1, *got_log = NULL;
+    for (uint64_t t = 1; t <= 14; t++) {
+        tick_handler(&sched);
+        if (t == 1) mempool_alloc(pool, ctl, 8);
+        if (t == 5) {
+            mempool_free(pool, b[0]);               /* To Ctl, not Log */
+            got_ctl = mempool_received(ctl);
+        }
+        if (t == 6) mempool_alloc(pool, aux, 3);
+        if (t == 9 && !aux->pool_wait) got_aux = mempool_received(aux);
+        if (t == 12) {
+            mempool_free(pool, b[1]);               /* To Log */
+            got_log = mempool_received(log);
+        }
+        scheduler_schedule(&sched);
+    }
+    printf("  Waiters: Log(5) forever at 0, Ctl(2) 8 ticks at 1, "
+           "Aux(3) 3 ticks at 6; frees at 5 and 12\n");
+    printf("  Ctl %s, Aux %s, Log %s\n",
+           got_ctl == b[0] ? "got block at 5" : "FAILED",
+           got_aux == NULL ? "timed out at 9" : "FAILED",
+           got_log == b[1] ? "got block at 12" : "FAILED");
+    mempool_print_report(pool);
+    bool wait_ok = got_ctl == b[0] && got_aux == NULL &&
+                   got_log == b[1] && pool->waits == 3 &&
+                   pool->handoffs == 2 && pool->timeouts == 1 &&
+                   pool->wait_max == 12 && pool->wait_count == 0 &&
+                   sched.sleep_count == 0;
+
+    /* Suspending a waiter cancels its wait without a timeout */
+    mempool_alloc(pool, aux, 5);
+    task_set_state(aux, TASK_SUSPENDED);
+    printf("  Aux waits again and is suspended: timeouts %" PRIu64
+           ", failures %" PRIu64 "\n", pool->timeouts, pool->failures);
+    wait_ok = wait_ok && pool->timeouts == 1 && pool->failures == 2 &&
+              pool->wait_count == 0 && sched.sleep_count == 0;
+    mempool_destroy(pool);
+    scheduler_destroy(&sched);
+
+    /* Part 3: size a pool from its high-water mark */
+    printf("\n  Net T=3 fills a 48 B packet per job, Proc T=10 frees "
+           "them all per job:\n");
+    MemPool big, exact, short_;
+    pool_pipeline(32, &big, true);
+    pool_pipeline(big.high_water, &exact, false);
+    pool_pipeline(big.high_water - 1, &short_, false);
+    printf("  Sized to high water (%u): %" PRIu64 " failures; one block "
+           "less: %" PRIu64 " failures\n", big.high_water,
+           exact.failures, short_.failures);
+    bool size_ok = big.failures == 0 && exact.failures == 0 &&
+                   short_.failures > 0;
+
+    bool pass = (api_ok && wait_ok && size_ok);
+    print_result(pass, "Fixed-Block Memory Pools");
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 29: Publish/Subscribe Topic Fan-Out
+ *  A camera publishes a 256-byte frame every 10 ticks to a queued, a
+ *  latest-value and a short-queue subscriber while a long task stalls
+ *  the slower ones. Each frame is copied once into a ref-counted slot
+ *  and wake-ups are batched into one scheduler pass. Readers must see
+ *  no corrupt, stale or reordered frames, and every slot returns to
+ *  the pool once all subscribers release it.
+ * ══════════════════════════════════════════════════════════════════ */
+
+#define TOPIC_FRAME_BYTES 256
+
+void test_topics(void)
+{
+    print_separator("Publish/Subscribe Topic Fan-Out");
+
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_PRIORITY, false);
+    TaskControlBlock *camera  = task_create(&sched, "Camera",
+                                            task_func_noop, NULL, 1, 10, 0, 1);
+    TaskControlBlock *fusion  = task_create(&sched, "Fusion",
+                                            task_func_noop, NULL, 2, 0, 0, 1);
+    task_create(&sched, "Hog", task_func_noop, NULL, 3, 100, 0, 25);
+    TaskControlBlock *display = task_create(&sched, "Display",
+                                            task_func_noop, NULL, 4, 0, 0, 2);
+    TaskControlBlock *logger  = task_create(&sched, "Logger",
+                                            task_func_noop, NULL, 5, 0, 0, 3);
+
+    /* Slots: sum(depth + 1) + 1 */
+    Topic *frames = topic_create(&sched, "Frames", TOPIC_FRAME_BYTES, 11);
+    TopicSub *subs[3] = {
+        topic_subscribe(frames, fusion, TOPIC_QUEUE, 4),
+        topic_subscribe(frames, display, TOPIC_LATEST, 1),
+        topic_subscribe(frames, logger, TOPIC_QUEUE, 2),
+    };
+    for (int i = 0; i < 3; i++) topic_wait(frames, subs[i]);
+
+    printf("\n  Camera T=10 publishes a %d B frame per job; Hog T=100 "
+           "C=25 stalls the slower subscribers\n", TOPIC_FRAME_BYTES);
+    printf("  Fusion queue 4 (prio 2), Display latest (prio 4, C=2), "
+           "Logger queue 2 (prio 5, C=3)\n");
+
+    uint8_t frame[TOPIC_FRAME_BYTES];
+    uint32_t corrupt = 0, stale = 0, reordered = 0;
+    uint32_t last_seq[3] = { 0, 0, 0 };
+    scheduler_schedule(&sched);
+    for (int t = 0; t < 1000; t++) {
+        tick_handler(&sched);
+
+        TaskControlBlock *curr = sched.current_task;
+        if (curr && curr != sched.idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+        {
+            int s = (curr == fusion) ? 0 : (curr == display) ? 1
+                  : (curr == logger) ? 2 : -1;
+            if (curr == camera) {
+                memset(frame, (int)(frames->seq + 1) & 0xFF, sizeof(frame));
+                topic_publish(frames, frame, sizeof(frame));
+                task_set_state(curr, TASK_SUSPENDED);
+            } else if (s >= 0) {
+                const TopicMsg *m = topic_take(frames, subs[s]);
+                if (m) {
+                    if (m->data[0] != (m->seq & 0xFF) ||
+                        m->data[m->len - 1] != (m->seq & 0xFF)) {
+                        corrupt++;
+                    }
+                    if (s == 1 && m->seq != frames->seq) stale++;
+                    if (m->seq <= last_seq[s]) reordered++;
+                    last_seq[s] = m->seq;
+                }
+                topic_release(frames, subs[s]);
+                if (subs[s]->count > 0) delay_next_job(curr);
+                else                    topic_wait(frames, subs[s]);
+            } else {
+                task_set_state(curr, TASK_SUSPENDED);
+            }
+        }
+        scheduler_schedule(&sched);
+    }
+
+    topic_print_report(frames);
+    uint64_t fanout = (uint64_t)frames->published * 3;
+    printf("\n  Copying to each subscriber: %" PRIu64 " copies (%" PRIu64
+           " bytes) and %" PRIu64 " signals; topic: %u copies (%" PRIu64
+           " bytes), %" PRIu64 " scheduler passes\n", fanout,
+           fanout * TOPIC_FRAME_BYTES, fanout, frames->published,
+           frames->bytes_copied, frames->wake_passes);
+    printf("  Corrupt frames %u, stale latest reads %u, out of order %u\n",
+           corrupt, stale, reordered);
+
+    uint32_t published = frames->published;
+    bool pass = (published == 100 && frames->failures == 0 &&
+                 frames->bytes_copied ==
+                     (uint64_t)published * TOPIC_FRAME_BYTES &&
+                 frames->deliveries == fanout &&
+                 frames->wakeups > frames->wake_passes &&
+                 corrupt == 0 && stale == 0 && reordered == 0 &&
+                 subs[0]->dropped == 0 && subs[1]->dropped > 0 &&
+                 subs[2]->dropped > 0 &&
+                 frames->slots->high_water <= frames->slots->block_count);
+
+    /* The last reference to each slot returns it to the pool */
+    for (int i = 0; i < 3; i++) topic_unsubscribe(frames, subs[i]);
+    printf("  Slots in use after all subscribers release: %u\n",
+           mempool_used(frames->slots));
+    pass = pass && mempool_used(frames->slots) == 0;
+
+    topic_destroy(frames);
+    scheduler_destroy(&sched);
+    print_result(pass, "Publish/Subscribe Topic Fan-Out");
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 30: Simulated I/O Devices and Completion Interrupts
+ *  Three periodic readers each read from a simulated disk next to a
+ *  background hog. Blocking on the completion interrupt must meet
+ *  every deadline and leave the hog more CPU than polling, with a
+ *  shorter worst response. Batching requests must cut interrupts and
+ *  device operations without lengthening the response, and the queue
+ *  depth must bound outstanding requests.
+ * ══════════════════════════════════════════════════════════════════ */
+
+typedef struct {
+    uint64_t resp_max;      /* Worst reader response               */
+    uint64_t hog_exec;      /* Background progress                 */
+    uint32_t misses;
+    uint32_t jobs;          /* Reader jobs finished                */
+    IoDevice dev;           /* Device statistics                   */
+} IoRun;
+
+/*
+ * Three readers (T=40) each run 1 tick, read from the disk, then run 1
+ * more tick; Hog (T=100, C=40) runs in the background. A reader either
+ * blocks until the completion interrupt or polls, spinning on the CPU.
+ */
+static void io_run(bool polling, int batch, IoRun *out)
+{
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_PRIORITY, false);
+    TaskControlBlock *reader[3];
+    for (int i = 0; i < 3; i++) {
+        char name[8];
+        snprintf(name, sizeof(name), "Rd%d", i + 1);
+        reader[i] = task_create(&sched, name, task_func_noop, NULL,
+                                (uint8_t)(i + 1), 40, 0, 1);
+    }
+    TaskControlBlock *hog = task_create(&sched, "Hog", task_func_noop,
+                                        NULL, 9, 100, 0, 40);
+
+    IoDevice *disk = iodev_create(&sched, "Disk", IODEV_SVC_UNIFORM, 4, 8,
+                                  8, 0, 1);
+    iodev_set_batching(disk, 3, batch);
+
+    int phase[3] = { 0, 0, 0 };         /* 0 pre, 1 in I/O, 2 post */
+    int req[3]    = { -1, -1, -1 };
+    memset(out, 0, sizeof(*out));
+
+    scheduler_schedule(&sched);
+    for (int t = 0; t < 2000; t++) {
+        tick_handler(&sched);
+
+        /* Completed reads: collect, then the post-processing tick */
+        for (int i = 0; i < 3; i++) {
+            if (phase[i] == 1 && iodev_poll(disk, req[i])) {
+                iodev_collect(disk, req[i]);
+                reader[i]->remaining_work = 1;
+                phase[i] = 2;
+            }
+        }
+
+        TaskControlBlock *curr = sched.current_task;
+        if (curr && curr != sched.idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+        {
+            int r = (curr == reader[0]) ? 0 : (curr == reader[1]) ? 1
+                  : (curr == reader[2]) ? 2 : -1;
+            if (r >= 0 && phase[r] == 0) {
+                req[r]   = iodev_submit(disk, curr);
+                phase[r] = 1;
+                if (polling) curr->remaining_work = UINT32_MAX;
+                else         iodev_wait(disk, req[r]);
+            } else {
+                if (r >= 0) {
+                    uint64_t release = curr->absolute_deadline -
+                                       curr->relative_deadline;
+                    uint64_t resp = sched.system_ticks - release;
+                    if (resp > out->resp_max) out->resp_max = resp;
+                    out->jobs++;
+                    phase[r] = 0;
+                }
+                task_set_state(curr, TASK_SUSPENDED);
+            }
+        }
+        scheduler_schedule(&sched);
+    }
+
+    io_print_report(&sched);
+    for (int i = 0; i < 3; i++) out->misses += reader[i]->deadline_misses;
+    out->misses  += hog->deadline_misses;
+    out->hog_exec = hog->total_exec_time;
+    out->dev      = *disk;
+
+    iodev_destroy(disk);
+    scheduler_destroy(&sched);
+}
+
+void test_io_devices(void)
+{
+    print_separator("Simulated I/O Devices and Completion Interrupts");
+
+    /* Queue depth bounds outstanding requests */
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_PRIORITY, false);
+    TaskControlBlock *t = task_create(&sched, "T", task_func_noop, NULL,
+                                      1, 0, 0, 1);
+    IoDevice *small = iodev_create(&sched, "Small", IODEV_SVC_FIXED, 2, 2,
+                                   2, 0, 1);
+    int a = iodev_submit(small, t), b = iodev_submit(small, t);
+    int c = iodev_submit(small, t);
+    for (int i = 0; i < 6; i++) tick_handler(&sched);
+    bool api_ok = (a >= 0 && b >= 0 && c == -1 && small->rejected == 1 &&
+                   iodev_poll(small, a) && iodev_poll(small, b) &&
+                   !iodev_wait(small, a) &&
+                   iodev_collect(small, a) == 3 &&
+                   iodev_collect(small, b) == 5 &&
+                   iodev_collect(small, b) == UINT64_MAX &&
+                   iodev_submit(small, t) >= 0);
+    printf("\n  Depth 2: third submit rejected, completions at +3 and +5 "
+           "(service 2, ISR 1): %s\n", api_ok ? "ok" : "WRONG");
+    iodev_destroy(small);
+    scheduler_destroy(&sched);
+
+    printf("\n  Rd1-Rd3 (prio 1-3, T=40): 1 tick, read from Disk "
+           "(service 4-8, setup 3, ISR 1), 1 tick;\n  Hog (prio 9, "
+           "T=100, C=40) in the background\n");
+
+    IoRun blocking, polling, batched;
+    printf("\n  Blocking, one request per operation:");
+    io_run(false, 1, &blocking);
+    printf("\n  Polling, one request per operation:");
+    io_run(true, 1, &polling);
+    printf("\n  Blocking, up to 4 requests per operation:");
+    io_run(false, 4, &batched);
+
+    printf("\n  %-22s %6s %9s %9s %7s %10s\n", "Run", "Jobs", "Resp max",
+           "Hog ticks", "Misses", "IRQs/req");
+    const IoRun *runs[3] = { &blocking, &polling, &batched };
+    const char *names[3] = { "blocking, batch 1", "polling, batch 1",
+                             "blocking, batch 4" };
+    for (int i = 0; i < 3; i++) {
+        const IoRun *r = runs[i];
+        printf("  %-22s %6u %9" PRIu64 " %9" PRIu64 " %7u %10.2f\n",
+               names[i], r->jobs, r->resp_max, r->hog_exec, r->misses,
+               r->dev.completed ? (double)r->dev.interrupts /
+                                  r->dev.completed : 0.0);
+    }
+
+    bool pass = api_ok &&
+                blocking.jobs == 150 && batched.jobs == 150 &&
+                blocking.misses == 0 && batched.misses == 0 &&
+                polling.hog_exec < blocking.hog_exec &&
+                polling.resp_max > blocking.resp_max &&
+                batched.dev.interrupts < blocking.dev.interrupts &&
+                batched.dev.operations < blocking.dev.operations &&
+                batched.resp_max <= blocking.resp_max &&
+                blocking.dev.rejected == 0;
+
+    print_result(pass, "Simulated I/O Devices and Completion Interrupts");
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 31: Waiting on Multiple Objects
+ *  One wait_any() call wakes a task on the first of a semaphore, a
+ *  mutex or a topic, and takes the task off the other objects'
+ *  queues. A worker serving a command topic until a shutdown
+ *  semaphore fires must handle every command within two ticks and
+ *  stop promptly, with fewer activations and a lower latency than the
+ *  same worker polling both objects.
+ * ══════════════════════════════════════════════════════════════════ */
+
+typedef struct {
+    uint32_t handled;       /* Commands processed                  */
+    uint32_t activations;   /* Worker jobs run                     */
+    uint64_t latency_max;   /* Publication to processing           */
+    uint64_t stop_delay;    /* Shutdown signal to worker exit      */
+    uint32_t published;
+    bool     clean;         /* No queue still holds the worker     */
+} WaitRun;
+
+/*
+ * A worker serves commands from a topic (Producer, T=10) until a
+ * shutdown semaphore is signalled at tick 203, beside a Hog. It either
+ * blocks in wait_any() on both objects or, as it would without it,
+ * polls both every 5 ticks.
+ */
+static void wait_run(bool polling, WaitRun *out)
+{
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_PRIORITY, true);
+    TaskControlBlock *worker = task_create(&sched, "Worker",
+                                           task_func_noop, NULL, 2,
+                                           polling ? 5 : 0, 0, 1);
+    TaskControlBlock *producer = task_create(&sched, "Producer",
+                                             task_func_noop, NULL, 3,
+                                             10, 0, 1);
+    task_create(&sched, "Hog", task_func_noop, NULL, 4, 50, 0, 20);
+
+    Topic *cmds = topic_create(&sched, "Cmds", sizeof(uint32_t), 6);
+    TopicSub *sub = topic_subscribe(cmds, worker, TOPIC_QUEUE, 4);
+    Semaphore *shutdown = semaphore_create(&sched, "Shutdown", 0, 1);
+    WaitObject objs[2] = { wait_on_topic(sub), wait_on_semaphore(shutdown) };
+
+    memset(out, 0, sizeof(*out));
+    uint64_t stop_at = 0;
+    int which = WAIT_ANY_NONE;
+    if (!polling) {
+        worker->remaining_work = 1;
+        which = wait_any(worker, objs, 2, WAIT_ANY_FOREVER);
+    }
+
+    scheduler_schedule(&sched);
+    for (int t = 0; t < 300 && !stop_at; t++) {
+        tick_handler(&sched);
+        if (sched.system_ticks == 203) semaphore_signal(shutdown, NULL);
+
+        TaskControlBlock *curr = sched.current_task;
+        if (curr && curr != sched.idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING)
+        {
+            if (curr == producer) {
+                uint32_t cmd = cmds->seq + 1;
+                topic_publish(cmds, &cmd, sizeof(cmd));
+                task_set_state(curr, TASK_SUSPENDED);
+            } else if (curr == worker) {
+                out->activations++;
+                int r = polling ? wait_any(worker, objs, 2, WAIT_ANY_NO_WAIT)
+                      : (which >= 0) ? which : wait_any_result(worker);
+                while (r == 0) {
+                    const TopicMsg *m = topic_take(cmds, sub);
+                    uint64_t lat = sched.system_ticks - m->stamp;
+                    if (lat > out->latency_max) out->latency_max = lat;
+                    out->handled++;
+                    topic_release(cmds, sub);
+                    r = polling ? wait_any(worker, objs, 2, WAIT_ANY_NO_WAIT)
+                                : WAIT_ANY_NONE;
+                }
+                if (r == 1) {
+                    stop_at = sched.system_ticks;
+                    task_set_state(curr, TASK_SUSPENDED);
+                } else if (polling) {
+                    task_set_state(curr, TASK_SUSPENDED);
+                } else {
+                    curr->remaining_work = 1;
+                    which = wait_any(worker, objs, 2, WAIT_ANY_FOREVER);
+                }
+            } else {
+                task_set_state(curr, TASK_SUSPENDED);
+            }
+        }
+        scheduler_schedule(&sched);
+    }
+
+    out->stop_delay = stop_at ? stop_at - 203 : UINT64_MAX;
+    out->published  = cmds->published;
+    out->clean      = (shutdown->wait_count == 0 && !sub->waiting &&
+                       !worker->wait_set && sub->count == 0);
+
+    semaphore_destroy(shutdown);
+    topic_destroy(cmds);
+    scheduler_destroy(&sched);
+}
+
+/* No object still holds `t`, and `owner` has lost its boost */
+static bool released(const TaskControlBlock *t,
+                     const TaskControlBlock *owner, const WaitObject *objs)
+{
+    return objs[0].sem->wait_count == 0 && objs[1].mutex->wait_count == 0 &&
+           !objs[2].sub->waiting && !t->wait_set &&
+           owner->priority == owner->original_priority;
+}
+
+void test_wait_any(void)
+{
+    print_separator("Waiting on Multiple Objects");
+
+    /* Any of three objects wakes the task; the others let go of it */
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_PRIORITY, true);
+    TaskControlBlock *t     = task_create(&sched, "T", task_func_noop,
+                                          NULL, 1, 0, 0, 1);
+    TaskControlBlock *owner = task_create(&sched, "Owner", task_func_noop,
+                                          NULL, 5, 0, 0, 1);
+    Semaphore *sem = semaphore_create(&sched, "Sem", 0, 1);
+    Mutex *mtx = mutex_create(&sched, "Mtx");
+    Topic *topic = topic_create(&sched, "Msgs", sizeof(uint32_t), 4);
+    TopicSub *sub = topic_subscribe(topic, t, TOPIC_QUEUE, 2);
+    WaitObject objs[3] = { wait_on_semaphore(sem), wait_on_mutex(mtx),
+                           wait_on_topic(sub) };
+    mutex_lock(mtx, owner);
+    uint32_t v = 7;
+
+    bool blocked = wait_any(t, objs, 3, WAIT_ANY_FOREVER) == WAIT_ANY_NONE &&
+                   t->state == TASK_BLOCKED && sem->wait_count == 1 &&
+                   mtx->wait_count == 1 && sub->waiting &&
+                   owner->priority == 1;
+    semaphore_signal(sem, NULL);
+    bool by_sem = wait_any_result(t) == 0 && t->state != TASK_BLOCKED &&
+                  sem->count == 0 && released(t, owner, objs);
+
+    wait_any(t, objs, 3, WAIT_ANY_FOREVER);
+    mutex_unlock(mtx, owner);
+    bool by_mtx = wait_any_result(t) == 1 && mtx->owner == t &&
+                  released(t, owner, objs);
+    mutex_unlock(mtx, t);
+    mutex_lock(mtx, owner);
+
+    wait_any(t, objs, 3, WAIT_ANY_FOREVER);
+    topic_publish(topic, &v, sizeof(v));
+    const TopicMsg *m = topic_take(topic, sub);
+    bool by_topic = wait_any_result(t) == 2 && m &&
+                    *(const uint32_t *)m->data == 7 && released(t, owner, objs);
+    topic_release(topic, sub);
+
+    bool no_wait = wait_any(t, objs, 3, WAIT_ANY_NO_WAIT) == WAIT_ANY_NONE &&
+                   t->state != TASK_BLOCKED && released(t, owner, objs);
+    semaphore_signal(sem, NULL);
+    bool ready_now = wait_any(t, objs, 3, WAIT_ANY_FOREVER) == 0 &&
+                     sem->count == 0 && released(t, owner, objs);
+
+    wait_any(t, objs, 3, 5);
+    for (int i = 0; i < 4; i++) tick_handler(&sched);
+    bool still = t->state == TASK_BLOCKED;
+    tick_handler(&sched);
+    bool timeout = still && t->state == TASK_READY && !t->delayed &&
+                   wait_any_result(t) == WAIT_ANY_NONE &&
+                   released(t, owner, objs);
+
+    printf("\n  T (prio 1) waits on {Sem, Mtx held by Owner (prio 5), "
+           "Msgs}:\n");
+    printf("    blocked on all three, Owner inherits prio 1:  %s\n",
+           blocked ? "ok" : "WRONG");
+    printf("    woken by Sem / Mtx / Msgs, others let go:      %s / %s / %s\n",
+           by_sem ? "ok" : "WRONG", by_mtx ? "ok" : "WRONG",
+           by_topic ? "ok" : "WRONG");
+    printf("    no-wait poll / object ready up front:          %s / %s\n",
+           no_wait ? "ok" : "WRONG", ready_now ? "ok" : "WRONG");
+    printf("    5-tick timeout, Owner back to prio 5:          %s\n",
+           timeout ? "ok" : "WRONG");
+    bool api_ok = blocked && by_sem && by_mtx && by_topic && no_wait &&
+                  ready_now && timeout;
+
+    mutex_unlock(mtx, owner);
+    topic_destroy(topic);
+    mutex_destroy(mtx);
+    semaphore_destroy(sem);
+    scheduler_destroy(&sched);
+
+    printf("\n  Worker (prio 2) serves Producer's commands (T=10) until "
+           "Shutdown is signalled at tick 203\n");
+    WaitRun blocking, polling;
+    wait_run(false, &blocking);
+    wait_run(true, &polling);
+
+    printf("\n  %-22s %8s %11s %12s %11s %6s\n", "Worker", "Handled",
+           "Activations", "Latency max", "Stop delay", "Clean");
+    const WaitRun *runs[2] = { &blocking, &polling };
+    const char *names[2] = { "wait_any, blocking", "polling every 5" };
+    for (int i = 0; i < 2; i++) {
+        const WaitRun *r = runs[i];
+        printf("  %-22s %4u/%-3u %11u %12" PRIu64 " %11" PRIu64 " %6s\n",
+               names[i], r->handled, r->published, r->activations,
+               r->latency_max, r->stop_delay, r->clean ? "yes" : "NO");
+    }
+
+    bool pass = api_ok && blocking.clean && polling.clean &&
+                blocking.handled == blocking.published &&
+                blocking.activations == blocking.handled + 1 &&
+                blocking.latency_max <= 2 && blocking.stop_delay <= 2 &&
+                polling.activations > blocking.activations &&
+                polling.latency_max > blocking.latency_max;
+
+    print_result(pass, "Waiting on Multiple Objects");
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 32: Thread-Safe External Event Injection
+ *  Four host threads post task releases, semaphore signals,
+ *  interrupts and priority changes to one lock-free queue. The same
+ *  burst posted with the threads started in opposite orders must
+ *  produce identical schedules, and a live run with the threads
+ *  posting during simulation must account for every event, posted or
+ *  rejected.
+ * ══════════════════════════════════════════════════════════════════ */
+
+#define INJ_PRODUCERS   4
+#define INJ_BURST       200         /* Events per producer, determinism */
+#define INJ_LIVE        50000       /* Events per producer, live run    */
+
+typedef struct {
+    InjectProducer    prod;
+    InjectKind        kind;
+    int               count;
+    TaskControlBlock *task;
+    Semaphore        *sem;
+    IsrSource        *irq;
+    atomic_int       *done;
+    uint64_t          post_ns_max;
+} InjHost;
+
+/* A host thread: post `count` events of one kind, never waiting */
+static void *inj_host_thread(void *arg)
+{
+    InjHost *h = arg;
+    for (int i = 0; i < h->count; i++) {
+        uint64_t t0 = bench_ns();
+        switch (h->kind) {
+        case INJECT_RELEASE: inject_release(&h->prod, h->task);       break;
+        case INJECT_SIGNAL:  inject_signal(&h->prod, h->sem);         break;
+        case INJECT_IRQ:     inject_irq(&h->prod, h->irq);            break;
+        case INJECT_PARAM:
+            inject_param(&h->prod, h->task, INJECT_PRIORITY,
+                         (uint64_t)(10 + i % 50));
+            break;
+        }
+        uint64_t dt = bench_ns() - t0;
+        if (dt > h->post_ns_max) h->post_ns_max = dt;
+        if ((i & 63) == 63) sched_yield();
+    }
+    atomic_fetch_add(h->done, 1);
+    return NULL;
+}
+
+typedef struct {
+    int      ctl_prio;      /* Last PARAM applied                  */
+    int      sem_count;
+    uint32_t irqs;
+    uint32_t rx_jobs;
+    uint64_t posted[INJ_PRODUCERS];
+    uint64_t rejected;
+    uint64_t post_ns_max;
+    InjectState stats;
+} InjRun;
+
+/*
+ * Producers (signals to Frame, releases of CanRx, CanIrq raises and
+ * priority changes of Ctl) post from their own threads. In a burst run
+ * they all post before the first tick, started in the given order; in
+ * a live run they post while the simulation ticks.
+ */
+static void inj_run(bool live, const int order[INJ_PRODUCERS], InjRun *out)
+{
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_PRIORITY, false);
+    TaskControlBlock *rx  = task_create(&sched, "CanRx", task_func_noop,
+                                        NULL, 1, 0, 0, 1);
+    TaskControlBlock *ctl = task_create(&sched, "Ctl", task_func_noop,
+                                        NULL, 3, 20, 0, 2);
+    task_set_state(rx, TASK_SUSPENDED);
+    uint32_t rx_created = rx->invocations;
+    Semaphore *frame = semaphore_create(&sched, "Frame", 0, 1 << 30);
+    isr_enable(&sched);
+    IsrSource *irq = isr_add_external(&sched, "CanIrq", 0, 1, 1);
+    inject_enable(&sched);
+
+    atomic_int done = 0;
+    InjHost host[INJ_PRODUCERS];
+    const InjectKind kinds[INJ_PRODUCERS] = {
+        INJECT_SIGNAL, INJECT_RELEASE, INJECT_IRQ, INJECT_PARAM
+    };
+    for (int p = 0; p < INJ_PRODUCERS; p++) {
+        memset(&host[p], 0, sizeof(host[p]));
+        inject_producer_init(&host[p].prod, &sched, (uint32_t)p);
+        host[p].kind  = kinds[p];
+        host[p].count = live ? INJ_LIVE : INJ_BURST;
+        host[p].task  = (kinds[p] == INJECT_PARAM) ? ctl : rx;
+        host[p].sem   = frame;
+        host[p].irq   = irq;
+        host[p].done  = &done;
+    }
+
+    pthread_t threads[INJ_PRODUCERS];
+    for (int i = 0; i < INJ_PRODUCERS; i++) {
+        int p = order[i];
+        pthread_create(&threads[p], NULL, inj_host_thread, &host[p]);
+    }
+    if (!live) {
+        for (int p = 0; p < INJ_PRODUCERS; p++) {
+            pthread_join(threads[p], NULL);
+        }
+    }
+
+    /* Tick until every producer has finished and its events are in */
+    scheduler_schedule(&sched);
+    int quiet = 0;
+    while (quiet < 2) {
+        bool finished = atomic_load(&done) == INJ_PRODUCERS;
+        tick_handler(&sched);
+        quiet = finished ? quiet + 1 : 0;
+
+        TaskControlBlock *curr = sched.current_task;
+        if (curr && curr != sched.idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING) {
+            task_set_state(curr, TASK_SUSPENDED);
+        }
+        scheduler_schedule(&sched);
+    }
+    if (live) {
+        for (int p = 0; p < INJ_PRODUCERS; p++) {
+            pthread_join(threads[p], NULL);
+        }
+    }
+
+    inject_print_report(&sched);
+    memset(out, 0, sizeof(*out));
+    out->ctl_prio  = ctl->priority;
+    out->sem_count = frame->count;
+    out->irqs      = irq->raised;
+    out->rx_jobs   = rx->invocations - rx_created;
+    for (int p = 0; p < INJ_PRODUCERS; p++) {
+        out->posted[p] = host[p].prod.posted;
+        out->rejected += host[p].prod.rejected;
+        if (host[p].post_ns_max > out->post_ns_max) {
+            out->post_ns_max = host[p].post_ns_max;
+        }
+    }
+    out->stats = *sched.inject;
+
+    semaphore_destroy(frame);
+    scheduler_destroy(&sched);
+}
+
+/* Every accepted event was applied or ignored, with per-kind totals */
+static bool inj_accounted(const InjRun *r)
+{
+    const InjectState *q = &r->stats;
+    uint64_t posted = 0;
+    for (int p = 0; p < INJ_PRODUCERS; p++) posted += r->posted[p];
+    return q->drained == posted &&
+           q->applied + q->ignored == q->drained &&
+           q->by_kind[INJECT_SIGNAL] == r->posted[0] &&
+           q->by_kind[INJECT_RELEASE] + q->ignored == r->posted[1] &&
+           q->by_kind[INJECT_IRQ] == r->posted[2] &&
+           q->by_kind[INJECT_PARAM] == r->posted[3] &&
+           (uint64_t)r->sem_count == r->posted[0] &&
+           r->irqs == r->posted[2] && r->rx_jobs ==
+               q->by_kind[INJECT_RELEASE] &&
+           atomic_load(&((InjectState *)q)->rejected) == r->rejected;
+}
+
+void test_event_injection(void)
+{
+    print_separator("Thread-Safe External Event Injection");
+
+    printf("\n  Four host threads post to one queue: signals of Frame, "
+           "releases of CanRx,\n  raises of CanIrq and priority changes "
+           "of Ctl\n");
+
+    const int fwd[INJ_PRODUCERS] = { 0, 1, 2, 3 };
+    const int rev[INJ_PRODUCERS] = { 3, 2, 1, 0 };
+    InjRun a, b, live;
+    printf("\n  Burst of %d per thread before the first tick, threads "
+           "started 0-3:", INJ_BURST);
+    inj_run(false, fwd, &a);
+    printf("\n  The same burst, threads started 3-0:");
+    inj_run(false, rev, &b);
+
+    bool same = a.ctl_prio == b.ctl_prio && a.sem_count == b.sem_count &&
+                a.irqs == b.irqs && a.rx_jobs == b.rx_jobs &&
+                a.stats.applied == b.stats.applied &&
+                a.stats.ignored == b.stats.ignored;
+    printf("\n  Both bursts give Ctl prio %d, Frame count %d, %u IRQs, %u "
+           "CanRx jobs: %s\n", a.ctl_prio, a.sem_count, a.irqs, a.rx_jobs,
+           same ? "identical" : "DIFFERENT");
+
+    printf("\n  Live: %d per thread while the simulation ticks:", INJ_LIVE);
+    inj_run(true, fwd, &live);
+    printf("  Slowest post %" PRIu64 " ns; a full queue rejected %" PRIu64
+           " posts without blocking\n", live.post_ns_max, live.rejected);
+
+    /* Raw posts skip the shorthands' checks: no target is ignored */
+    Scheduler raw;
+    InjectProducer rp;
+    scheduler_init(&raw, SCHED_PRIORITY, false);
+    inject_enable(&raw);
+    inject_producer_init(&rp, &raw, 0);
+    inject_post(&rp, (InjectEvent){ .kind = INJECT_RELEASE });
+    inject_post(&rp, (InjectEvent){ .kind = INJECT_PARAM,
+                                    .param = INJECT_WCET, .value = 1 });
+    inject_tick(&raw);
+    bool raw_ok = raw.inject->drained == 2 && raw.inject->applied == 0 &&
+                  raw.inject->ignored == 2;
+    printf("  Raw posts with no task: %" PRIu64 " drained, %" PRIu64
+           " ignored\n", raw.inject->drained, raw.inject->ignored);
+    scheduler_destroy(&raw);
+
+    /* The last priority Ctl receives is the last one its producer posted */
+    int last_prio = 10 + (INJ_BURST - 1) % 50;
+    bool pass = same && inj_accounted(&a) && inj_accounted(&b) &&
+                inj_accounted(&live) &&
+                a.rejected == 0 && a.stats.batches == 1 &&
+                a.stats.drained == INJ_PRODUCERS * INJ_BURST &&
+                a.rx_jobs == 1 && a.ctl_prio == last_prio &&
+                live.posted[3] > 0 && live.stats.batches > 1 && raw_ok;
+
+    print_result(pass, "Thread-Safe External Event Injection");
+}
+
+/* ══════════════════════════════════════════════════════════════════
+ *  TEST 33: Streaming Event Input
+ *  A short script from a file creates tasks and a semaphore, then
+ *  releases, signals and changes parameters on their ticks.
+ *  Malformed, unknown, over-long and out-of-order lines are rejected.
+ *  A 200000-tick stream through a pipe must be applied on time from a
+ *  fixed-size buffer, with no errors.
+ * ══════════════════════════════════════════════════════════════════ */
+
+#define STREAM_TICKS    200000      /* Pipe run: 5 lines per tick      */
+
+/* Writes a long generated stream into a pipe */
+static void *stream_writer(void *arg)
+{
+    FILE *out = arg;
+    fprintf(out, "0 task Rx 1 0 1\n0 task Ctl 3 20 2\n"
+                 "0 sem Go 0 2147483647\n");
+    for (uint64_t t = 1; t <= STREAM_TICKS; t++) {
+        fprintf(out, "# tick %" PRIu64 "\n%" PRIu64 " release Rx\n%" PRIu64
+                " signal Go\n%" PRIu64 " set Ctl wcet %" PRIu64 "\n%" PRIu64
+                " set Ctl deadline 20\n", t, t, t, t, t % 7 + 1, t);
+    }
+    fclose(out);
+    return NULL;
+}
+
+void test_event_stream(void)
+{
+    print_separator("Streaming Event Input");
+
+    /* A short script with five bad lines, from a file */
+    FILE *f = tmpfile();
+    fprintf(f, "# Replay: tasks and objects come from the stream\n"
+               "0 task Sensor 1 10 2\n0 task Logger 4 0 1\n"
+               "0 sem Ready 0 4\n0 task Planner 2 40 5\n\n"
+               "5 release Logger\n12 signal Ready\n12 signal Ready\n"
+               "20 set Sensor period 20\n25 bogus Sensor\n"
+               "26 release Nobody\n27 release Logger ");
+    for (int i = 0; i < 5000; i++) fputc('x', f);
+    fprintf(f, "\n30 irq Missing\n18 release Logger\n"
+               "40 set Planner priority 0\n50 release Logger\n"
+               "60 signal Ready");                  /* No final newline */
+    rewind(f);
+
+    Scheduler sched;
+    scheduler_init(&sched, SCHED_PRIORITY, false);
+    EventStream *es = evstream_open(&sched, f);
+    evstream_tick(&sched);                          /* Tick-0 commands */
+
+    TaskControlBlock *sensor  = sched.all_tasks[1];
+    TaskControlBlock *logger  = sched.all_tasks[2];
+    TaskControlBlock *planner = sched.all_tasks[3];
+    bool created = sched.task_count == 4 && es->tasks_created == 3 &&
+                   strcmp(sensor->name, "Sensor") == 0 &&
+                   strcmp(planner->name, "Planner") == 0;
+    uint64_t period_at[2] = { 0, 0 };
+    int prio_at[2] = { 0, 0 };
+
+    printf("\n  Script: 3 tasks and a semaphore created at tick 0, "
+           "releases, signals and\n  parameter changes later, plus an "
+           "unknown command, task and source, an\n  over-long line and "
+           "a line out of order\n");
+    scheduler_schedule(&sched);
+    for (int t = 0; t < 80; t++) {
+        tick_handler(&sched);
+        if (sched.system_ticks == 19) period_at[0] = sensor->period;
+        if (sched.system_ticks == 20) period_at[1] = sensor->period;
+        if (sched.system_ticks == 39) prio_at[0] = planner->priority;
+        if (sched.system_ticks == 40) prio_at[1] = planner->priority;
+
+        TaskControlBlock *curr = sched.current_task;
+        if (curr && curr != sched.idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING) {
+            task_set_state(curr, TASK_SUSPENDED);
+        }
+        scheduler_schedule(&sched);
+    }
+    evstream_print_report(es);
+
+    Semaphore *ready = evstream_semaphore(es, "Ready");
+    bool script_ok = created && ready && ready->count == 3 &&
+                     period_at[0] == 10 && period_at[1] == 20 &&
+                     prio_at[0] == 2 && prio_at[1] == 0 &&
+                     logger->invocations == 2 && es->ignored == 1 &&
+                     es->errors == 5 && es->lines == 18 &&
+                     evstream_done(es);
+    printf("  Applied on their ticks, Logger released once (busy at 5), "
+           "Ready at 3, 5 lines rejected: %s\n", script_ok ? "ok" : "WRONG");
+    evstream_close(es);
+    fclose(f);
+    scheduler_destroy(&sched);
+
+    /* A long generated stream through a pipe */
+    int fds[2];
+    if (pipe(fds) != 0) {
+        print_result(false, "Streaming Event Input");
+        return;
+    }
+    FILE *in = fdopen(fds[0], "r"), *out = fdopen(fds[1], "w");
+    pthread_t writer;
+    pthread_create(&writer, NULL, stream_writer, out);
+
+    scheduler_init(&sched, SCHED_PRIORITY, false);
+    es = evstream_open(&sched, in);
+    evstream_tick(&sched);
+    TaskControlBlock *ctl = sched.all_tasks[2];
+    uint32_t late = 0;
+
+    printf("\n  Pipe: %d ticks of 5 lines (release, signal, two "
+           "parameter changes, comment)\n", STREAM_TICKS);
+    uint64_t t0 = bench_ns();
+    scheduler_schedule(&sched);
+    while (!evstream_done(es) || sched.system_ticks < STREAM_TICKS) {
+        tick_handler(&sched);
+        if (ctl->wcet != sched.system_ticks % 7 + 1) late++;
+
+        TaskControlBlock *curr = sched.current_task;
+        if (curr && curr != sched.idle_task &&
+            curr->remaining_work == 0 && curr->state == TASK_RUNNING) {
+            task_set_state(curr, TASK_SUSPENDED);
+        }
+        scheduler_schedule(&sched);
+    }
+    double secs = (double)(bench_ns() - t0) / 1e9;
+    pthread_join(writer, NULL);
+    evstream_print_report(es);
+    printf("  %.1f MB in %.2f s (%.0f MB/s); commands applied late: %u\n",
+           es->bytes / 1e6, secs, secs > 0 ? es->bytes / 1e6 / secs : 0.0,
+           late);
+
+    Semaphore *go = evstream_semaphore(es, "Go");
+    uint64_t commands = 3 + 4 * (uint64_t)STREAM_TICKS;
+    bool pipe_ok = es->errors == 0 && es->lines == commands + STREAM_TICKS &&
+                   es->applied + es->ignored == commands &&
+                   go && go->count == STREAM_TICKS && late == 0 &&
+                   sched.system_ticks == STREAM_TICKS &&
+                   sizeof(EventStream) < 2 * EVSTREAM_BUF_SIZE;
+    evstream_close(es);
+    fclose(in);
+    scheduler_destroy(&sched);
+
+    print_result(script_ok && pipe_ok, "Streaming Event Input");
+}
@@ -0,0 +1,227 @@
+/*
+ * topic.c - Publish/Subscribe Topics Implementation
+ *
+ * A waiting subscriber is released as a new job (release_job), so it
+ * runs its full body for the message; one blocked in wait_any() instead
+ * resumes the job it blocked in. Releases only queue the tasks;
+ * scheduler_schedule() runs once after the whole fan-out.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "topic.h"
+#include "scheduler.h"
+#include "rtos_time.h"
+#include "waitany.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+
+/* ── Helpers ──────────────────────────────────────────────────────── */
+
+static void msg_unref(Topic *topic, TopicMsg *msg)
+{
+    if (msg && --msg->refs == 0) mempool_free(topic->slots, msg);
+}
+
+/* Queue a reference for one subscriber, applying its policy */
+static void deliver(Topic *topic, TopicSub *sub, TopicMsg *msg)
+{
+    if (sub->count == sub->depth) {
+        /* Full: drop the oldest (under TOPIC_LATEST, the only one) */
+        msg_unref(topic, sub->pending[sub->head]);
+        sub->head = (sub->head + 1) % TOPIC_QUEUE_MAX;
+        sub->count--;
+        sub->dropped++;
+    }
+    sub->pending[(sub->head + sub->count) % TOPIC_QUEUE_MAX] = msg;
+    sub->count++;
+    msg->refs++;
+    topic->deliveries++;
+}
+
+/* ── Creation / Destruction ───────────────────────────────────────── */
+
+Topic *topic_create(Scheduler *sched, const char *name, size_t msg_size,
+                    uint32_t slots)
+{
+    if (!sched || msg_size == 0 || slots == 0) {
+        fprintf(stderr, "topic_create: %s needs a message size and "
+                "slots\n", name ? name : "(null)");
+        return NULL;
+    }
+
+    Topic *topic = calloc(1, sizeof(Topic));
+    if (!topic) return NULL;
+    snprintf(topic->name, TOPIC_NAME_MAX, "%s", name ? name : "topic");
+    topic->scheduler = sched;
+    topic->msg_size  = msg_size;
+    topic->slots     = mempool_create(sched, topic->name,
+                                      sizeof(TopicMsg) + msg_size, slots);
+    if (!topic->slots) {
+        free(topic);
+        return NULL;
+    }
+    return topic;
+}
+
+void topic_destroy(Topic *topic)
+{
+    if (!topic) return;
+    mempool_destroy(topic->slots);
+    free(topic);
+}
+
+/* ── Subscriptions ────────────────────────────────────────────────── */
+
+TopicSub *topic_subscribe(Topic *topic, TaskControlBlock *task,
+                          TopicPolicy policy, int depth)
+{
+    if (!topic || !task) return NULL;
+    if (topic->sub_count >= TOPIC_MAX_SUBS) {
+        fprintf(stderr, "topic %s: more than %d subscribers\n",
+                topic->name, TOPIC_MAX_SUBS);
+        return NULL;
+    }
+    if (policy == TOPIC_LATEST) depth = 1;
+    if (depth < 1 || depth > TOPIC_QUEUE_MAX) {
+        fprintf(stderr, "topic %s: queue depth must be 1..%d\n",
+                topic->name, TOPIC_QUEUE_MAX);
+        return NULL;
+    }
+
+    TopicSub *sub = &topic->sub[topic->sub_count++];
+    memset(sub, 0, sizeof(*sub));
+    sub->task   = task;
+    sub->policy = policy;
+    sub->depth  = depth;
+    return sub;
+}
+
+void topic_unsubscribe(Topic *topic, TopicSub *sub)
+{
+    if (!topic || !sub) return;
+    while (sub->count > 0) {
+        msg_unref(topic, sub->pending[sub->head]);
+        sub->head = (sub->head + 1) % TOPIC_QUEUE_MAX;
+        sub->count--;
+    }
+    topic_release(topic, sub);
+    sub->waiting = false;
+    sub->depth   = 0;           /* Receives nothing from now on */
+}
+
+/* ── Publish / Receive ────────────────────────────────────────────── */
+
+bool topic_publish(Topic *topic, const void *data, size_t len)
+{
+    if (!topic || (!data && len > 0)) return false;
+    if (len > topic->msg_size) {
+        fprintf(stderr, "topic %s: %zu-byte message exceeds %zu\n",
+                topic->name, len, topic->msg_size);
+        topic->failures++;
+        return false;
+    }
+
+    TopicMsg *msg = mempool_alloc(topic->slots, NULL, MEMPOOL_NO_WAIT);
+    if (!msg) {
+        topic->failures++;
+        return false;
+    }
+    Scheduler *sched = topic->scheduler;
+    msg->refs  = 1;             /* The publisher's, dropped below */
+    msg->seq   = ++topic->seq;
+    msg->stamp = sched->system_ticks;
+    msg->len   = len;
+    if (len) memcpy(msg->data, data, len);
+    topic->bytes_copied += len;
+    topic->published++;
+
+    /* Fan out, then let the scheduler see all released tasks at once */
+    uint32_t woken = 0;
+    for (int i = 0; i < topic->sub_count; i++) {
+        TopicSub *sub = &topic->sub[i];
+        if (sub->depth == 0) continue;
+        deliver(topic, sub, msg);
+        if (sub->waiting) {
+            sub->waiting = false;
+            if (sub->task->wait_set) {
+                /* Blocked mid-job in wait_any(): resume that job */
+                wait_any_wake(sub->task, sub);
+                task_set_state(sub->task, TASK_READY);
+            } else {
+                release_job(sched, sub->task);
+            }
+            woken++;
+        }
+    }
+    msg_unref(topic, msg);
+
+    if (woken > 0) {
+        topic->wakeups += woken;
+        topic->wake_passes++;
+        scheduler_schedule(sched);
+    }
+    return true;
+}
+
+const TopicMsg *topic_take(Topic *topic, TopicSub *sub)
+{
+    if (!topic || !sub) return NULL;
+    topic_release(topic, sub);
+    if (sub->count == 0) return NULL;
+
+    TopicMsg *msg = sub->pending[sub->head];
+    sub->head = (sub->head + 1) % TOPIC_QUEUE_MAX;
+    sub->count--;
+    sub->held = msg;
+    sub->received++;
+
+    uint64_t age = topic->scheduler->system_ticks - msg->stamp;
+    if (age > sub->age_max) sub->age_max = age;
+    return msg;
+}
+
+void topic_release(Topic *topic, TopicSub *sub)
+{
+    if (!topic || !sub || !sub->held) return;
+    msg_unref(topic, sub->held);
+    sub->held = NULL;
+}
+
+bool topic_wait(Topic *topic, TopicSub *sub)
+{
+    if (!topic || !sub || sub->count > 0) return false;
+    sub->waiting = true;
+    task_set_state(sub->task, TASK_BLOCKED);
+    scheduler_schedule(topic->scheduler);
+    return true;
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+void topic_print_report(const Topic *topic)
+{
+    if (!topic) return;
+
+    printf("\n  Topic %s: %u published (%u failed), %" PRIu64 " bytes "
+           "copied, %" PRIu64 " references\n", topic->name,
+           topic->published, topic->failures, topic->bytes_copied,
+           topic->deliveries);
+    printf("  %" PRIu64 " subscriber wake-ups in %" PRIu64 " scheduler "
+           "passes; slots %u, high water %u, in use %u\n",
+           topic->wakeups, topic->wake_passes, topic->slots->block_count,
+           topic->slots->high_water, mempool_used(topic->slots));
+
+    printf("\n  %-10s %-8s %5s %9s %8s %8s\n", "Subscriber", "Policy",
+           "Depth", "Received", "Dropped", "Max age");
+    for (int i = 0; i < topic->sub_count; i++) {
+        const TopicSub *s = &topic->sub[i];
+        printf("  %-10s %-8s %5d %9u %8u %8" PRIu64 "\n", s->task->name,
+               s->policy == TOPIC_LATEST ? "latest" : "queue", s->depth,
+               s->received, s->dropped, s->age_max);
+    }
+}
@@ -0,0 +1,136 @@
+/*
+ * topic.h - Publish/Subscribe Topics
+ *
+ * A topic carries messages from publishers to every subscribed task. A
+ * publication is copied once into a slot taken from the topic's memory
+ * pool; each subscriber receives a reference to that slot, and the slot
+ * returns to the pool when the last reference is released. All
+ * subscribers waiting on the topic are released together and the
+ * scheduler runs once per publication, not once per subscriber.
+ *
+ * A subscriber that falls behind is served by its policy:
+ *
+ *   TOPIC_LATEST  only the newest message is kept (older ones are
+ *                 overwritten);
+ *   TOPIC_QUEUE   up to `depth` messages are kept, the oldest being
+ *                 dropped when a new one arrives at a full queue.
+ *
+ * A topic needs at most one slot per queued or held reference plus one
+ * being published: slots >= sum(depth_i + 1) + 1.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef TOPIC_H
+#define TOPIC_H
+
+#include "task.h"
+#include "mempool.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* ── Forward declarations ─────────────────────────────────────────── */
+typedef struct Scheduler Scheduler;
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define TOPIC_NAME_MAX      32
+#define TOPIC_MAX_SUBS      16
+#define TOPIC_QUEUE_MAX     8       /* Deepest subscriber queue        */
+
+typedef enum {
+    TOPIC_LATEST,           /* Newest message only                     */
+    TOPIC_QUEUE             /* Bounded FIFO, oldest dropped when full  */
+} TopicPolicy;
+
+/* ── Message slot (one pool block) ────────────────────────────────── */
+typedef struct {
+    uint32_t          refs;         /* Subscribers still holding it    */
+    uint32_t          seq;          /* Publication number, from 1      */
+    uint64_t          stamp;        /* Tick of publication             */
+    size_t            len;
+    uint8_t           data[];
+} TopicMsg;
+
+/* ── Subscription ─────────────────────────────────────────────────── */
+typedef struct {
+    TaskControlBlock *task;
+    TopicPolicy       policy;
+    int               depth;        /* 1 under TOPIC_LATEST            */
+
+    TopicMsg         *pending[TOPIC_QUEUE_MAX];
+    int               head;
+    int               count;
+    TopicMsg         *held;         /* Taken, not yet released         */
+    bool              waiting;      /* Blocked in topic_wait()         */
+
+    /* Statistics */
+    uint32_t          received;
+    uint32_t          dropped;      /* Overwritten or evicted unread   */
+    uint64_t          age_max;      /* Publication to take, ticks      */
+} TopicSub;
+
+/* ── Topic structure ──────────────────────────────────────────────── */
+typedef struct Topic {
+    char              name[TOPIC_NAME_MAX];
+    Scheduler        *scheduler;
+    size_t            msg_size;     /* Largest payload                 */
+    MemPool          *slots;
+
+    TopicSub          sub[TOPIC_MAX_SUBS];
+    int               sub_count;
+    uint32_t          seq;
+
+    /* Statistics */
+    uint32_t          published;
+    uint32_t          failures;     /* No free slot                    */
+    uint64_t          bytes_copied;
+    uint64_t          deliveries;   /* References handed out           */
+    uint64_t          wakeups;      /* Waiting subscribers released    */
+    uint64_t          wake_passes;  /* Scheduler runs for those wakeups */
+} Topic;
+
+/* ── Public API ───────────────────────────────────────────────────── */
+
+/** Create a topic of `slots` message slots of up to `msg_size` bytes. */
+Topic *topic_create(Scheduler *sched, const char *name, size_t msg_size,
+                    uint32_t slots);
+
+/** Destroy a topic and its slots. */
+void topic_destroy(Topic *topic);
+
+/** Subscribe `task` (depth is forced to 1 under TOPIC_LATEST). */
+TopicSub *topic_subscribe(Topic *topic, TaskControlBlock *task,
+                          TopicPolicy policy, int depth);
+
+/** Drop a subscription's queued and held messages. */
+void topic_unsubscribe(Topic *topic, TopicSub *sub);
+
+/**
+ * Publish `len` bytes: copy them once into a slot, reference it from
+ * every subscription and release the waiting subscribers in one batch.
+ * Fails if no slot is free or the payload is too large.
+ */
+bool topic_publish(Topic *topic, const void *data, size_t len);
+
+/**
+ * Take the next message for `sub`, releasing the one it held. Returns a
+ * pointer into the shared slot (valid until the next take or release),
+ * or NULL if nothing is pending.
+ */
+const TopicMsg *topic_take(Topic *topic, TopicSub *sub);
+
+/** Release the held message; the slot is freed by its last holder. */
+void topic_release(Topic *topic, TopicSub *sub);
+
+/**
+ * Block the subscriber until the next publication. Returns false (and
+ * does not block) if a message is already pending.
+ */
+bool topic_wait(Topic *topic, TopicSub *sub);
+
+/** Print per-subscriber deliveries, drops and age, and slot usage. */
+void topic_print_report(const Topic *topic);
+
+#endif /* TOPIC_H */
@@ -0,0 +1,449 @@
+/*
+ * ttsynth.c - Time-Triggered Schedule Synthesis
+ *
+ * Depth-first list scheduling: at each step the ready jobs (all
+ * predecessors placed) are ranked by deadline, then by earliest
+ * feasible start, and the best TT_BRANCH of them are tried in order.
+ * A job is placed at the earliest time at or after its release and
+ * its predecessors' finish where it overlaps no placed job on the same
+ * core or sharing a resource. Placing a job can only delay the others,
+ * so a step where some ready job can no longer meet its deadline is
+ * abandoned at once; the search backtracks to the previous choice.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "ttsynth.h"
+#include "cyclic.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <inttypes.h>
+#include <time.h>
+
+/* ── Helpers ──────────────────────────────────────────────────────── */
+
+static uint64_t now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static uint64_t gcd_u64(uint64_t a, uint64_t b)
+{
+    while (b) {
+        uint64_t r = a % b;
+        a = b;
+        b = r;
+    }
+    return a;
+}
+
+static bool is_periodic(const Scheduler *sched, const TaskControlBlock *t)
+{
+    return t && t != sched->idle_task && t->period > 0 &&
+           t->state != TASK_TERMINATED;
+}
+
+static TtTaskSpec *find_spec(TtSchedule *tt, const TaskControlBlock *task,
+                             bool create)
+{
+    for (int i = 0; i < tt->spec_count; i++) {
+        if (tt->spec[i].task == task) return &tt->spec[i];
+    }
+    if (!create) return NULL;
+    if (tt->spec_count >= TT_MAX_TASKS) {
+        fprintf(stderr, "tt: too many constrained tasks\n");
+        return NULL;
+    }
+    TtTaskSpec *s = &tt->spec[tt->spec_count++];
+    memset(s, 0, sizeof(*s));
+    s->task = (TaskControlBlock *)task;
+    return s;
+}
+
+static uint32_t task_resources(const TtSchedule *tt,
+                               const TaskControlBlock *task)
+{
+    for (int i = 0; i < tt->spec_count; i++) {
+        if (tt->spec[i].task == task) return tt->spec[i].resources;
+    }
+    return 0;
+}
+
+static int job_of(const TtSchedule *tt, const TaskControlBlock *task,
+                  uint32_t index)
+{
+    for (int j = 0; j < tt->job_count; j++) {
+        if (tt->job[j].task == task && tt->job[j].index == index) return j;
+    }
+    return -1;
+}
+
+/* ── Problem definition ───────────────────────────────────────────── */
+
+TtSchedule *tt_create(SmpSystem *sys)
+{
+    if (!sys) return NULL;
+    TtSchedule *tt = calloc(1, sizeof(TtSchedule));
+    if (!tt) {
+        fprintf(stderr, "tt_create: out of memory\n");
+        return NULL;
+    }
+    tt->sys = sys;
+    return tt;
+}
+
+void tt_destroy(TtSchedule *tt)
+{
+    free(tt);
+}
+
+bool tt_add_precedence(TtSchedule *tt, TaskControlBlock *pred,
+                       TaskControlBlock *succ)
+{
+    if (!tt || !pred || !succ || pred == succ) return false;
+    if (pred->period != succ->period || pred->period == 0) {
+        fprintf(stderr, "tt_add_precedence: %s and %s need equal "
+                "periods\n", pred->name, succ->name);
+        return false;
+    }
+
+    TtTaskSpec *s = find_spec(tt, succ, true);
+    if (!s) return false;
+    if (s->pred_count >= TT_MAX_PREDS) {
+        fprintf(stderr, "tt_add_precedence: %s has too many "
+                "predecessors\n", succ->name);
+        return false;
+    }
+    s->pred[s->pred_count++] = pred;
+    return true;
+}
+
+bool tt_use_resource(TtSchedule *tt, TaskControlBlock *task,
+                     const char *resource)
+{
+    if (!tt || !task || !resource) return false;
+
+    int r = 0;
+    while (r < tt->res_count && strcmp(tt->res_name[r], resource) != 0) r++;
+    if (r == tt->res_count) {
+        if (tt->res_count >= TT_MAX_RESOURCES) {
+            fprintf(stderr, "tt_use_resource: too many resources\n");
+            return false;
+        }
+        snprintf(tt->res_name[r], TT_RES_NAME_MAX, "%s", resource);
+        tt->res_count++;
+    }
+
+    TtTaskSpec *s = find_spec(tt, task, true);
+    if (!s) return false;
+    s->resources |= 1u << r;
+    return true;
+}
+
+/* ── Job set ──────────────────────────────────────────────────────── */
+
+static bool build_jobs(TtSchedule *tt)
+{
+    SmpSystem *sys = tt->sys;
+    uint64_t   h   = 0;
+
+    for (int c = 0; c < sys->core_count; c++) {
+        const Scheduler *sched = &sys->cores[c];
+        for (int i = 0; i < sched->task_count; i++) {
+            const TaskControlBlock *t = sched->all_tasks[i];
+            if (!is_periodic(sched, t)) continue;
+            if (t->relative_deadline > t->period) {
+                fprintf(stderr, "tt_synthesize: %s has D > T\n", t->name);
+                return false;
+            }
+            h = (h == 0) ? t->period : h / gcd_u64(h, t->period) * t->period;
+        }
+    }
+    if (h == 0) {
+        fprintf(stderr, "tt_synthesize: no periodic tasks\n");
+        return false;
+    }
+    tt->hyperperiod = h;
+    tt->job_count   = 0;
+
+    for (int c = 0; c < sys->core_count; c++) {
+        Scheduler *sched = &sys->cores[c];
+        for (int i = 0; i < sched->task_count; i++) {
+            TaskControlBlock *t = sched->all_tasks[i];
+            if (!is_periodic(sched, t)) continue;
+            for (uint64_t r = 0; r < h; r += t->period) {
+                if (tt->job_count >= TT_MAX_JOBS) {
+                    fprintf(stderr, "tt_synthesize: more than %d jobs\n",
+                            TT_MAX_JOBS);
+                    return false;
+                }
+                tt->job[tt->job_count++] = (TtJob){
+                    .task = t, .core = c,
+                    .index = (uint32_t)(r / t->period), .release = r,
+                    .deadline = r + t->relative_deadline, .wcet = t->wcet,
+                    .resources = task_resources(tt, t) };
+            }
+        }
+    }
+
+    /* Job-level predecessors */
+    for (int j = 0; j < tt->job_count; j++) {
+        TtJob            *jb = &tt->job[j];
+        const TtTaskSpec *s  = find_spec(tt, jb->task, false);
+        for (int p = 0; s && p < s->pred_count; p++) {
+            int pj = job_of(tt, s->pred[p], jb->index);
+            if (pj < 0) {
+                fprintf(stderr, "tt_synthesize: predecessor %s of %s is "
+                        "not a periodic task of this system\n",
+                        s->pred[p]->name, jb->task->name);
+                return false;
+            }
+            jb->pred[jb->pred_count++] = pj;
+        }
+    }
+    return true;
+}
+
+/* ── Search ───────────────────────────────────────────────────────── */
+
+static bool conflicts(const TtJob *a, const TtJob *b)
+{
+    return a->core == b->core || (a->resources & b->resources) != 0;
+}
+
+/* Earliest start of job j given the jobs placed so far */
+static uint64_t earliest_fit(const TtSchedule *tt, int j)
+{
+    const TtJob *jb = &tt->job[j];
+    uint64_t     t  = jb->release;
+
+    for (int p = 0; p < jb->pred_count; p++) {
+        uint64_t f = tt->job[jb->pred[p]].finish;
+        if (f > t) t = f;
+    }
+
+    bool moved = true;
+    while (moved) {
+        moved = false;
+        for (int k = 0; k < tt->job_count; k++) {
+            const TtJob *o = &tt->job[k];
+            if (!o->placed || k == j || !conflicts(jb, o)) continue;
+            if (t < o->finish && o->start < t + jb->wcet) {
+                t     = o->finish;
+                moved = true;
+            }
+        }
+    }
+    return t;
+}
+
+static bool ready(const TtSchedule *tt, const TtJob *jb)
+{
+    if (jb->placed) return false;
+    for (int p = 0; p < jb->pred_count; p++) {
+        if (!tt->job[jb->pred[p]].placed) return false;
+    }
+    return true;
+}
+
+static bool search(TtSchedule *tt, int placed)
+{
+    if (placed == tt->job_count) return true;
+    if (++tt->nodes > TT_NODE_BUDGET) return false;
+
+    /* Best TT_BRANCH ready jobs by (deadline, earliest start) */
+    int      cand[TT_BRANCH];
+    uint64_t fit[TT_BRANCH];
+    int      n = 0;
+
+    for (int j = 0; j < tt->job_count; j++) {
+        const TtJob *jb = &tt->job[j];
+        if (!ready(tt, jb)) continue;
+
+        uint64_t s = earliest_fit(tt, j);
+        if (s + jb->wcet > jb->deadline) return false;   /* Doomed */
+
+        int pos = n;
+        while (pos > 0) {
+            const TtJob *prev = &tt->job[cand[pos - 1]];
+            if (prev->deadline < jb->deadline ||
+                (prev->deadline == jb->deadline && fit[pos - 1] <= s)) {
+                break;
+            }
+            pos--;
+        }
+        if (pos >= TT_BRANCH) continue;
+        if (n < TT_BRANCH) n++;
+        for (int k = n - 1; k > pos; k--) {
+            cand[k] = cand[k - 1];
+            fit[k]  = fit[k - 1];
+        }
+        cand[pos] = j;
+        fit[pos]  = s;
+    }
+
+    for (int k = 0; k < n; k++) {
+        TtJob *jb = &tt->job[cand[k]];
+        jb->placed = true;
+        jb->start  = fit[k];
+        jb->finish = fit[k] + jb->wcet;
+
+        if (search(tt, placed + 1)) return true;
+
+        jb->placed = false;
+        tt->backtracks++;
+        if (tt->nodes > TT_NODE_BUDGET) return false;
+    }
+    return false;
+}
+
+bool tt_synthesize(TtSchedule *tt)
+{
+    if (!tt) return false;
+
+    uint64_t t0 = now_ns();
+    tt->feasible   = false;
+    tt->nodes      = 0;
+    tt->backtracks = 0;
+
+    if (build_jobs(tt)) {
+        tt->feasible = search(tt, 0);
+        if (!tt->feasible) {
+            fprintf(stderr, "tt_synthesize: no schedule found%s\n",
+                    tt->nodes > TT_NODE_BUDGET ? " (search budget spent)"
+                                               : "");
+        }
+    }
+    tt->synth_ns = now_ns() - t0;
+    return tt->feasible;
+}
+
+/* ── Replay ───────────────────────────────────────────────────────── */
+
+static int cmp_slice(const void *a, const void *b)
+{
+    const CyclicSlice *x = a, *y = b;
+    return (x->start > y->start) - (x->start < y->start);
+}
+
+bool tt_install(TtSchedule *tt)
+{
+    if (!tt || !tt->feasible) {
+        fprintf(stderr, "tt_install: no feasible schedule\n");
+        return false;
+    }
+
+    CyclicSlice slices[TT_MAX_JOBS];
+    for (int c = 0; c < tt->sys->core_count; c++) {
+        int n = 0;
+        for (int j = 0; j < tt->job_count; j++) {
+            const TtJob *jb = &tt->job[j];
+            if (jb->core != c) continue;
+            slices[n++] = (CyclicSlice){ jb->task, jb->index,
+                                         (uint32_t)jb->start,
+                                         (uint32_t)jb->wcet };
+        }
+        qsort(slices, (size_t)n, sizeof(CyclicSlice), cmp_slice);
+
+        Scheduler *sched = &tt->sys->cores[c];
+        if (!cyclic_load(sched, tt->hyperperiod, slices, n) ||
+            !cyclic_start(sched)) {
+            return false;
+        }
+        scheduler_schedule(sched);
+    }
+    return true;
+}
+
+static bool job_pending(const TaskControlBlock *t)
+{
+    return (t->state == TASK_READY || t->state == TASK_RUNNING ||
+            t->state == TASK_BLOCKED) && t->remaining_work > 0;
+}
+
+void tt_audit_tick(TtSchedule *tt)
+{
+    if (!tt) return;
+    SmpSystem        *sys = tt->sys;
+    TaskControlBlock *run[SMP_MAX_CORES];
+
+    for (int c = 0; c < sys->core_count; c++) {
+        TaskControlBlock *curr = sys->cores[c].current_task;
+        run[c] = (curr && curr != sys->cores[c].idle_task &&
+                  curr->state == TASK_RUNNING) ? curr : NULL;
+    }
+
+    for (int c = 0; c < sys->core_count; c++) {
+        if (!run[c]) continue;
+
+        uint32_t res = task_resources(tt, run[c]);
+        for (int d = c + 1; d < sys->core_count && res; d++) {
+            if (run[d] && (task_resources(tt, run[d]) & res)) {
+                tt->resource_conflicts++;
+            }
+        }
+
+        const TtTaskSpec *s = find_spec(tt, run[c], false);
+        for (int p = 0; s && p < s->pred_count; p++) {
+            const TaskControlBlock *pred = s->pred[p];
+            uint32_t done = pred->invocations - (job_pending(pred) ? 1 : 0);
+            if (done < run[c]->invocations) tt->precedence_violations++;
+        }
+    }
+    tt->audited_ticks++;
+}
+
+/* ── Reporting ────────────────────────────────────────────────────── */
+
+void tt_print(const TtSchedule *tt)
+{
+    if (!tt) return;
+
+    printf("\n  Hyperperiod %" PRIu64 ", %d jobs: %s after %" PRIu64
+           " nodes, %" PRIu64 " backtracks, %.1f us\n",
+           tt->hyperperiod, tt->job_count,
+           tt->feasible ? "feasible" : "INFEASIBLE", tt->nodes,
+           tt->backtracks, tt->synth_ns / 1000.0);
+    if (!tt->feasible) return;
+
+    for (int c = 0; c < tt->sys->core_count; c++) {
+        printf("  Core %d:", c);
+
+        /* Jobs of this core in start order */
+        int order[TT_MAX_JOBS];
+        int n = 0;
+        for (int j = 0; j < tt->job_count; j++) {
+            if (tt->job[j].core != c) continue;
+            int pos = n++;
+            while (pos > 0 &&
+                   tt->job[order[pos - 1]].start > tt->job[j].start) {
+                order[pos] = order[pos - 1];
+                pos--;
+            }
+            order[pos] = j;
+        }
+        for (int k = 0; k < n; k++) {
+            const TtJob *jb = &tt->job[order[k]];
+            printf(" %s#%u[%" PRIu64 ",%" PRIu64 ")", jb->task->name,
+                   jb->index, jb->start, jb->finish);
+        }
+        printf("\n");
+    }
+
+    for (int r = 0; r < tt->res_count; r++) {
+        printf("  Resource %-8s:", tt->res_name[r]);
+        for (int i = 0; i < tt->spec_count; i++) {
+            if (tt->spec[i].resources & (1u << r)) {
+                printf(" %s", tt->spec[i].task->name);
+            }
+        }
+        printf("\n");
+    }
+}
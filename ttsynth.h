@@ -0,0 +1,133 @@
+/*
+ * ttsynth.h - Time-Triggered Schedule Synthesis
+ *
+ * Offline synthesis of a time-triggered schedule for the periodic tasks
+ * of an SmpSystem (one or more cores, tasks already partitioned): every
+ * job in the hyperperiod gets a fixed start time such that
+ *
+ *   - it starts no earlier than its release and ends by its deadline,
+ *   - it runs without preemption on its own core,
+ *   - it starts after its predecessors (same job index) have finished,
+ *   - it never overlaps, on any core, a job sharing a resource with it.
+ *
+ * The search is list scheduling with bounded backtracking. The result
+ * is installed on each core as a cyclic-executive table (cyclic.h), so
+ * a replay makes no runtime decisions and sees no contention.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef TTSYNTH_H
+#define TTSYNTH_H
+
+#include "smp.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define TT_MAX_JOBS         256
+#define TT_MAX_TASKS        64
+#define TT_MAX_RESOURCES    32      /* Resource sets are a uint32_t    */
+#define TT_RES_NAME_MAX     16
+#define TT_MAX_PREDS        4       /* Direct predecessors per task    */
+#define TT_BRANCH           3       /* Candidates tried per step       */
+#define TT_NODE_BUDGET      200000  /* Search nodes before giving up   */
+
+/* One job of the hyperperiod */
+typedef struct {
+    TaskControlBlock *task;
+    int               core;
+    uint32_t          index;        /* Job number within the task      */
+    uint64_t          release;
+    uint64_t          deadline;
+    uint64_t          wcet;
+    uint32_t          resources;    /* Bit r = uses resource r         */
+    int               pred[TT_MAX_PREDS];
+    int               pred_count;
+
+    bool              placed;
+    uint64_t          start;
+    uint64_t          finish;
+} TtJob;
+
+/* Per-task constraints */
+typedef struct {
+    TaskControlBlock *task;
+    uint32_t          resources;
+    TaskControlBlock *pred[TT_MAX_PREDS];
+    int               pred_count;
+} TtTaskSpec;
+
+/* ── Synthesis problem and result ─────────────────────────────────── */
+typedef struct {
+    SmpSystem   *sys;
+    uint64_t     hyperperiod;
+
+    TtTaskSpec   spec[TT_MAX_TASKS];
+    int          spec_count;
+    char         res_name[TT_MAX_RESOURCES][TT_RES_NAME_MAX];
+    int          res_count;
+
+    TtJob        job[TT_MAX_JOBS];
+    int          job_count;
+    bool         feasible;
+
+    /* Search statistics */
+    uint64_t     nodes;
+    uint64_t     backtracks;
+    uint64_t     synth_ns;
+
+    /* Replay audit */
+    uint64_t     audited_ticks;
+    uint32_t     resource_conflicts;   /* Ticks two holders overlapped */
+    uint32_t     precedence_violations;
+} TtSchedule;
+
+/* ── Problem definition ───────────────────────────────────────────── */
+
+/** Create an empty synthesis problem over the system's tasks. */
+TtSchedule *tt_create(SmpSystem *sys);
+
+/** Destroy the problem and result. */
+void tt_destroy(TtSchedule *tt);
+
+/**
+ * Job k of `succ` may start only after job k of `pred` has finished.
+ * Both tasks must have the same period.
+ */
+bool tt_add_precedence(TtSchedule *tt, TaskControlBlock *pred,
+                       TaskControlBlock *succ);
+
+/**
+ * Declare that `task` uses the named resource for its whole execution;
+ * jobs sharing a resource never overlap in time on any core.
+ */
+bool tt_use_resource(TtSchedule *tt, TaskControlBlock *task,
+                     const char *resource);
+
+/* ── Synthesis and replay ─────────────────────────────────────────── */
+
+/**
+ * Compute start times for every job in the hyperperiod (tasks must be
+ * released synchronously with D <= T). Returns true if feasible.
+ */
+bool tt_synthesize(TtSchedule *tt);
+
+/**
+ * Install the schedule on every core as a cyclic-executive table and
+ * start dispatching from it at the current tick.
+ */
+bool tt_install(TtSchedule *tt);
+
+/**
+ * Check one replayed tick: counts cores running jobs that share a
+ * resource, and successors running before their predecessor's job
+ * completed. Call after each smp_run(sys, 1).
+ */
+void tt_audit_tick(TtSchedule *tt);
+
+/** Print the synthesized start times per core and search statistics. */
+void tt_print(const TtSchedule *tt);
+
+#endif /* TTSYNTH_H */
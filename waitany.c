@@ -0,0 +1,163 @@
+/*
+ * waitany.c - Waiting on Multiple Objects Implementation
+ *
+ * A blocked wait_any() task sits in the wait queue of every mutex and
+ * semaphore in its set and has `waiting` set on every subscription.
+ * Whichever object wakes it first calls wait_any_wake(), which clears
+ * the TCB's wait set before touching the other objects: from then on
+ * the task is an ordinary waiter of none of them, and the READY
+ * transition that follows does not cancel anything.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#include "waitany.h"
+#include "scheduler.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+/* ── Helpers ──────────────────────────────────────────────────────── */
+
+static const void *object_of(const WaitObject *w)
+{
+    switch (w->kind) {
+    case WAIT_MUTEX:     return w->mutex;
+    case WAIT_SEMAPHORE: return w->sem;
+    case WAIT_TOPIC:     return w->sub;
+    }
+    return NULL;
+}
+
+/* Acquire `w` for `task` if it is ready now */
+static bool try_acquire(const WaitObject *w, TaskControlBlock *task)
+{
+    switch (w->kind) {
+    case WAIT_MUTEX:     return mutex_try_lock(w->mutex, task);
+    case WAIT_SEMAPHORE: return semaphore_try_wait(w->sem);
+    case WAIT_TOPIC:     return w->sub->count > 0;
+    }
+    return false;
+}
+
+static bool enqueue(const WaitObject *w, TaskControlBlock *task)
+{
+    switch (w->kind) {
+    case WAIT_MUTEX:     return mutex_add_waiter(w->mutex, task);
+    case WAIT_SEMAPHORE: return semaphore_add_waiter(w->sem, task);
+    case WAIT_TOPIC:
+        w->sub->waiting = true;
+        return true;
+    }
+    return false;
+}
+
+static void dequeue(const WaitObject *w, TaskControlBlock *task)
+{
+    switch (w->kind) {
+    case WAIT_MUTEX:     mutex_remove_waiter(w->mutex, task);    break;
+    case WAIT_SEMAPHORE: semaphore_remove_waiter(w->sem, task);  break;
+    case WAIT_TOPIC:     w->sub->waiting = false;                break;
+    }
+}
+
+/* Dequeue from every object except objs[keep] (-1: all) */
+static void leave_set(TaskControlBlock *task, int keep)
+{
+    WaitObject *objs = task->wait_set;
+    int count = task->wait_set_count;
+
+    task->wait_set       = NULL;
+    task->wait_set_count = 0;
+    for (int i = 0; i < count; i++) {
+        if (i != keep) dequeue(&objs[i], task);
+    }
+}
+
+/* ── Initializers ─────────────────────────────────────────────────── */
+
+WaitObject wait_on_mutex(Mutex *mtx)
+{
+    return (WaitObject){ .kind = WAIT_MUTEX, .mutex = mtx };
+}
+
+WaitObject wait_on_semaphore(Semaphore *sem)
+{
+    return (WaitObject){ .kind = WAIT_SEMAPHORE, .sem = sem };
+}
+
+WaitObject wait_on_topic(TopicSub *sub)
+{
+    return (WaitObject){ .kind = WAIT_TOPIC, .sub = sub };
+}
+
+/* ── Public API ───────────────────────────────────────────────────── */
+
+int wait_any(TaskControlBlock *task, WaitObject *objs, int count,
+             uint64_t timeout)
+{
+    if (!task || !objs || count < 1) return WAIT_ANY_NONE;
+    for (int i = 0; i < count; i++) {
+        if (!object_of(&objs[i])) {
+            fprintf(stderr, "wait_any: %s: object %d is NULL\n",
+                    task->name, i);
+            return WAIT_ANY_NONE;
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (try_acquire(&objs[i], task)) return i;
+    }
+    if (timeout == WAIT_ANY_NO_WAIT) return WAIT_ANY_NONE;
+
+    /* Queue on every object, backing out if one queue is full */
+    for (int i = 0; i < count; i++) {
+        if (enqueue(&objs[i], task)) continue;
+        fprintf(stderr, "wait_any: %s cannot wait on object %d\n",
+                task->name, i);
+        while (i-- > 0) dequeue(&objs[i], task);
+        return WAIT_ANY_NONE;
+    }
+
+    Scheduler *sched = task->scheduler;
+    task_set_state(task, TASK_BLOCKED);
+    task->wait_set       = objs;
+    task->wait_set_count = count;
+    task->wait_index     = WAIT_ANY_NONE;
+    if (timeout != WAIT_ANY_FOREVER) {
+        task->wake_tick = sched->system_ticks + timeout;
+        sleep_queue_insert(sched, task);
+    }
+    scheduler_schedule(sched);
+    return WAIT_ANY_NONE;
+}
+
+int wait_any_result(const TaskControlBlock *task)
+{
+    return task ? task->wait_index : WAIT_ANY_NONE;
+}
+
+/* ── Hooks ────────────────────────────────────────────────────────── */
+
+void wait_any_wake(TaskControlBlock *task, const void *object)
+{
+    if (!task || !task->wait_set) return;
+
+    int hit = WAIT_ANY_NONE;
+    for (int i = 0; i < task->wait_set_count; i++) {
+        if (object_of(&task->wait_set[i]) == object) {
+            hit = i;
+            break;
+        }
+    }
+    task->wait_index = hit;
+    leave_set(task, hit);
+}
+
+void wait_any_cancel(TaskControlBlock *task)
+{
+    if (!task || !task->wait_set) return;
+    task->wait_index = WAIT_ANY_NONE;
+    leave_set(task, WAIT_ANY_NONE);
+}
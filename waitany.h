@@ -0,0 +1,96 @@
+/*
+ * waitany.h - Waiting on Multiple Objects
+ *
+ * wait_any() blocks one task on several mutexes, semaphores and topic
+ * subscriptions at once, select-style. The task is queued on every
+ * object like an ordinary waiter. The first object to wake it
+ * satisfies the wait: a semaphore hands over a unit, a mutex hands over
+ * ownership, a topic delivers a message. Before the task becomes READY
+ * it is dequeued from all the other objects, so no other object can
+ * also wake it.
+ *
+ * The objects are described by an array the caller owns and keeps
+ * until the wait ends; the TCB only points at it. Waking walks that
+ * array once, so the cost is O(objects) and nothing is allocated.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef WAITANY_H
+#define WAITANY_H
+
+#include "task.h"
+#include "mutex.h"
+#include "semaphore.h"
+#include "topic.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define WAIT_ANY_NO_WAIT    0
+#define WAIT_ANY_FOREVER    UINT64_MAX
+#define WAIT_ANY_NONE       (-1)    /* Nothing ready, or timed out     */
+
+typedef enum {
+    WAIT_MUTEX,
+    WAIT_SEMAPHORE,
+    WAIT_TOPIC              /* A subscription with a message pending   */
+} WaitKind;
+
+/* ── Wait object ──────────────────────────────────────────────────── */
+typedef struct WaitObject {
+    WaitKind          kind;
+    Mutex            *mutex;
+    Semaphore        *sem;
+    TopicSub         *sub;
+} WaitObject;
+
+/* ── Initializers ─────────────────────────────────────────────────── */
+
+/** Describe a mutex to lock. */
+WaitObject wait_on_mutex(Mutex *mtx);
+
+/** Describe a semaphore to take a unit from. */
+WaitObject wait_on_semaphore(Semaphore *sem);
+
+/** Describe a subscription to receive a message on. */
+WaitObject wait_on_topic(TopicSub *sub);
+
+/* ── Public API ───────────────────────────────────────────────────── */
+
+/**
+ * Wait for the first of `count` objects. If one is ready now (scanned
+ * in array order), it is acquired and its index returned. Otherwise
+ * returns WAIT_ANY_NONE and, unless `timeout` is WAIT_ANY_NO_WAIT,
+ * blocks `task` on all of them; wait_any_result() then tells which one
+ * woke it. A finite timeout uses the scheduler's sleep queue.
+ *
+ * A topic object only reports a pending message; the task reads it
+ * with topic_take().
+ */
+int wait_any(TaskControlBlock *task, WaitObject *objs, int count,
+             uint64_t timeout);
+
+/**
+ * Index of the object that ended the task's last blocking wait, or
+ * WAIT_ANY_NONE if it timed out or was woken otherwise.
+ */
+int wait_any_result(const TaskControlBlock *task);
+
+/* ── Hooks ────────────────────────────────────────────────────────── */
+
+/**
+ * Called by an object as it wakes a task blocked in wait_any(), after
+ * handing over the object and before making the task READY: records the
+ * object and dequeues the task from the others.
+ */
+void wait_any_wake(TaskControlBlock *task, const void *object);
+
+/**
+ * Dequeue the task from every object (timeout or forced wake-up).
+ * Called by task_set_state() when a waiting task leaves BLOCKED.
+ */
+void wait_any_cancel(TaskControlBlock *task);
+
+#endif /* WAITANY_H */
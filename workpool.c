@@ -0,0 +1,253 @@
+/*
+ * workpool.c - Host Worker Pool with Work-Stealing Deques
+ *
+ * Deque operations follow Chase & Lev (fixed capacity, no resizing).
+ * Pushes only happen while workers are parked: workpool_run() returns
+ * only after every worker has drained the deques and parked for the
+ * batch, so the items array is never written concurrently with a pop
+ * or a steal.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "workpool.h"
+
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <inttypes.h>
+
+/* ── Pool state ───────────────────────────────────────────────────── */
+
+typedef struct {
+    WorkPool  *pool;
+    int        index;
+    pthread_t  thread;
+    uint64_t   executed;
+    uint64_t   stolen;
+} Worker;
+
+struct WorkPool {
+    int               workers;
+    Worker            worker[WORKPOOL_MAX_WORKERS];
+    WsDeque           deque[WORKPOOL_MAX_WORKERS];
+
+    pthread_mutex_t   lock;
+    pthread_cond_t    start_cv;
+    pthread_cond_t    done_cv;
+    uint64_t          epoch;       /* Bumped for every batch           */
+    bool              stop;
+
+    _Atomic int       pending;     /* Items not yet completed          */
+    int               parked;      /* Workers done with this epoch     */
+    int               submitted;   /* Items queued for the next batch  */
+    int               next_deque;  /* Round-robin submission cursor    */
+    uint64_t          batches;
+};
+
+/* ── Chase-Lev deque ──────────────────────────────────────────────── */
+
+static bool deque_push(WsDeque *d, WorkItem item)
+{
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed);
+    int64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    if (b - t >= WORKPOOL_DEQUE_CAP) return false;
+
+    d->items[b % WORKPOOL_DEQUE_CAP] = item;
+    atomic_thread_fence(memory_order_release);
+    atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+    return true;
+}
+
+static bool deque_pop(WsDeque *d, WorkItem *out)
+{
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_relaxed) - 1;
+    atomic_store_explicit(&d->bottom, b, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t t = atomic_load_explicit(&d->top, memory_order_relaxed);
+
+    if (t > b) {
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return false;                              /* Empty */
+    }
+
+    *out = d->items[b % WORKPOOL_DEQUE_CAP];
+    if (t == b) {
+        /* Last item: race against thieves for it */
+        bool won = atomic_compare_exchange_strong_explicit(
+            &d->top, &t, t + 1,
+            memory_order_seq_cst, memory_order_relaxed);
+        atomic_store_explicit(&d->bottom, b + 1, memory_order_relaxed);
+        return won;
+    }
+    return true;
+}
+
+static bool deque_steal(WsDeque *d, WorkItem *out)
+{
+    int64_t t = atomic_load_explicit(&d->top, memory_order_acquire);
+    atomic_thread_fence(memory_order_seq_cst);
+    int64_t b = atomic_load_explicit(&d->bottom, memory_order_acquire);
+    if (t >= b) return false;
+
+    *out = d->items[t % WORKPOOL_DEQUE_CAP];
+    return atomic_compare_exchange_strong_explicit(
+        &d->top, &t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+}
+
+/* ── Worker loop ──────────────────────────────────────────────────── */
+
+static bool find_work(Worker *w, WorkItem *item)
+{
+    WorkPool *pool = w->pool;
+
+    if (deque_pop(&pool->deque[w->index], item)) return true;
+
+    /* Steal, scanning victims starting after ourselves */
+    for (int k = 1; k < pool->workers; k++) {
+        int victim = (w->index + k) % pool->workers;
+        if (deque_steal(&pool->deque[victim], item)) {
+            w->stolen++;
+            return true;
+        }
+    }
+    return false;
+}
+
+static void *worker_main(void *p)
+{
+    Worker   *w    = p;
+    WorkPool *pool = w->pool;
+    uint64_t  seen = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    for (;;) {
+        while (pool->epoch == seen && !pool->stop) {
+            pthread_cond_wait(&pool->start_cv, &pool->lock);
+        }
+        if (pool->stop) break;
+        seen = pool->epoch;
+        pthread_mutex_unlock(&pool->lock);
+
+        WorkItem item;
+        while (find_work(w, &item)) {
+            item.fn(item.arg);
+            w->executed++;
+            atomic_fetch_sub(&pool->pending, 1);
+        }
+
+        /* Out of the deques for this epoch: report parked */
+        pthread_mutex_lock(&pool->lock);
+        if (++pool->parked == pool->workers) {
+            pthread_cond_broadcast(&pool->done_cv);
+        }
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+/* ── Public API ───────────────────────────────────────────────────── */
+
+WorkPool *workpool_create(int workers)
+{
+    if (workers < 1)                    workers = 1;
+    if (workers > WORKPOOL_MAX_WORKERS) workers = WORKPOOL_MAX_WORKERS;
+
+    WorkPool *pool = calloc(1, sizeof(WorkPool));
+    if (!pool) return NULL;
+
+    pool->workers = workers;
+    atomic_init(&pool->pending, 0);
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_cond_init(&pool->start_cv, NULL);
+    pthread_cond_init(&pool->done_cv, NULL);
+
+    for (int i = 0; i < workers; i++) {
+        atomic_init(&pool->deque[i].top, 0);
+        atomic_init(&pool->deque[i].bottom, 0);
+        pool->worker[i].pool  = pool;
+        pool->worker[i].index = i;
+        pthread_create(&pool->worker[i].thread, NULL, worker_main,
+                       &pool->worker[i]);
+    }
+    return pool;
+}
+
+void workpool_destroy(WorkPool *pool)
+{
+    if (!pool) return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = true;
+    pthread_cond_broadcast(&pool->start_cv);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->workers; i++) {
+        pthread_join(pool->worker[i].thread, NULL);
+    }
+    pthread_cond_destroy(&pool->start_cv);
+    pthread_cond_destroy(&pool->done_cv);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool);
+}
+
+bool workpool_submit(WorkPool *pool, WorkFn fn, void *arg)
+{
+    if (!pool || !fn) return false;
+
+    WorkItem item = { fn, arg };
+    for (int k = 0; k < pool->workers; k++) {
+        int d = (pool->next_deque + k) % pool->workers;
+        if (deque_push(&pool->deque[d], item)) {
+            pool->next_deque = (d + 1) % pool->workers;
+            pool->submitted++;
+            return true;
+        }
+    }
+    fprintf(stderr, "workpool_submit: all deques full\n");
+    return false;
+}
+
+void workpool_run(WorkPool *pool)
+{
+    if (!pool || pool->submitted == 0) return;
+
+    atomic_store(&pool->pending, pool->submitted);
+    pool->submitted  = 0;
+    pool->next_deque = 0;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->epoch++;
+    pool->batches++;
+    pool->parked = 0;
+    pthread_cond_broadcast(&pool->start_cv);
+
+    /* Wait for every worker to leave its deque loop, not just for the
+       last item: a worker still popping or stealing would race with
+       the pushes of the next batch */
+    while (pool->parked < pool->workers ||
+           atomic_load(&pool->pending) > 0) {
+        pthread_cond_wait(&pool->done_cv, &pool->lock);
+    }
+    pthread_mutex_unlock(&pool->lock);
+}
+
+int workpool_workers(const WorkPool *pool)
+{
+    return pool ? pool->workers : 0;
+}
+
+void workpool_print_stats(const WorkPool *pool)
+{
+    if (!pool) return;
+
+    printf("  Worker pool: %d threads, %" PRIu64 " batches\n",
+           pool->workers, pool->batches);
+    for (int i = 0; i < pool->workers; i++) {
+        printf("    W%-2d executed %8" PRIu64 "  stolen %8" PRIu64 "\n",
+               i, pool->worker[i].executed, pool->worker[i].stolen);
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * workpool.h - Host Worker Pool with Work-Stealing Deques
+ *
+ * A fixed set of host threads, each owning a Chase-Lev deque. Work is
+ * submitted in batches while the workers are parked; workpool_run()
+ * releases the batch and returns once every item has executed and
+ * every worker has parked. Idle
+ * workers steal from the top of other workers' deques.
+ *
+ * Author: RTOS Project
+ * Date:   2026-02-13
+ */
+
+#ifndef WORKPOOL_H
+#define WORKPOOL_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+/* ── Constants ────────────────────────────────────────────────────── */
+#define WORKPOOL_MAX_WORKERS  16
+#define WORKPOOL_DEQUE_CAP    256    /* Items per worker per batch    */
+
+/* ── Work item ────────────────────────────────────────────────────── */
+typedef void (*WorkFn)(void *arg);
+
+typedef struct {
+    WorkFn  fn;
+    void   *arg;
+} WorkItem;
+
+/* Chase-Lev deque: owner pushes/pops at bottom, thieves take the top */
+typedef struct {
+    WorkItem          items[WORKPOOL_DEQUE_CAP];
+    _Atomic int64_t   top;
+    _Atomic int64_t   bottom;
+} WsDeque;
+
+typedef struct WorkPool WorkPool;
+
+/* ── Public API ───────────────────────────────────────────────────── */
+
+/** Start `workers` host threads (clamped to 1..WORKPOOL_MAX_WORKERS). */
+WorkPool *workpool_create(int workers);
+
+/** Stop and join all workers. */
+void workpool_destroy(WorkPool *pool);
+
+/**
+ * Queue an item for the next batch. Only valid between batches; items
+ * are dealt round-robin to the worker deques. Returns false if full.
+ */
+bool workpool_submit(WorkPool *pool, WorkFn fn, void *arg);
+
+/**
+ * Execute the queued batch; returns when all items completed and every
+ * worker has parked again.
+ */
+void workpool_run(WorkPool *pool);
+
+/** Number of worker threads. */
+int workpool_workers(const WorkPool *pool);
+
+/** Print per-worker executed/stolen counts. */
+void workpool_print_stats(const WorkPool *pool);
+
+#endif /* WORKPOOL_H */